@@ -0,0 +1,61 @@
+#include "pihm.h"
+
+void BenchRhs(int nrhs, pihm_struct pihm, N_Vector CV_Y)
+{
+    /*
+     * Time RHS evaluations at the initial conditions with increasing numbers
+     * of threads, up to the number of threads of the simulation. The part of
+     * the time per RHS evaluation that does not decrease with the number of
+     * threads is the cost of synchronizing the threads
+     */
+    int             nt;
+    int             k;
+    double          start;
+    double          time;
+    double          time1 = 0.0;
+    N_Vector        CV_Ydot;
+
+    CV_Ydot = N_VClone(CV_Y);
+
+    pihm_printf(VL_NORMAL,
+        "\nTiming %d RHS evaluations (%d elements, %d river segments).\n",
+        nrhs, nelem, nriver);
+    pihm_printf(VL_NORMAL, "%-10s%-20s%-10s%s\n", "threads",
+        "time per RHS (us)", "speedup", "efficiency");
+
+    nt = 1;
+    while (1)
+    {
+#if defined(_OPENMP)
+        omp_set_num_threads(nt);
+#endif
+
+        /* Start the threads and load the states into cache before timing */
+        Ode(0.0, CV_Y, CV_Ydot, pihm);
+
+        start = WallClock();
+        for (k = 0; k < nrhs; k++)
+        {
+            Ode(0.0, CV_Y, CV_Ydot, pihm);
+        }
+        time = (WallClock() - start) / (double)nrhs;
+
+        time1 = (nt == 1) ? time : time1;
+
+        pihm_printf(VL_NORMAL, "%-10d%-20.2f%-10.2f%.2f\n", nt,
+            time * 1.0E6, time1 / time, time1 / time / (double)nt);
+
+        if (nt == nthreads)
+        {
+            break;
+        }
+
+        nt = MIN(2 * nt, nthreads);
+    }
+
+#if defined(_OPENMP)
+    omp_set_num_threads(nthreads);
+#endif
+
+    N_VDestroy(CV_Ydot);
+}
@@ -14,12 +14,19 @@ void DailyBgc(int t, pihm_struct pihm)
     ndepcontrol_struct *ndepctrl;
     forc_struct    *forc;
     siteinfo_struct *siteinfo;
+#if !defined(_LUMPEDBGC_)
+    int             k;
+    sched_struct   *sched;
+#endif
 
     elem = &pihm->elem[0];
     co2 = &pihm->co2;
     ndepctrl = &pihm->ndepctrl;
     forc = &pihm->forc;
     siteinfo = &pihm->siteinfo;
+#if !defined(_LUMPEDBGC_)
+    sched = &pihm->sched[BGC_SCHED];
+#endif
 
 #if defined(_LUMPEDBGC_)
     i = LUMPEDBGC;
@@ -86,9 +93,9 @@ void DailyBgc(int t, pihm_struct pihm)
 
     /* Calculate average soil water content for all model grids */
 #if defined(_LUMPEDBGC_)
-    vwc = (double *)malloc((nelem + 1) * sizeof(double));
+    vwc = ScratchAlloc(nelem + 1, ThreadScratch(pihm->scratch));
 #else
-    vwc = (double *)malloc(nelem * sizeof(double));
+    vwc = ScratchAlloc(nelem, ThreadScratch(pihm->scratch));
 #endif
 #if defined(_OPENMP)
 # pragma omp parallel for
@@ -121,14 +128,16 @@ void DailyBgc(int t, pihm_struct pihm)
 #if defined(_LUMPEDBGC_)
     i = LUMPEDBGC;
 #else
+    /* Elements are visited in the order of the cost-aware schedule, because
+     * the cost of phenology and allocation varies with the growth stage */
 # if defined(_OPENMP)
-#  pragma omp parallel for
+#  pragma omp parallel for schedule(dynamic, 1) private(i)
 # endif
-    for (i = 0; i < nelem; i++)
+    for (k = 0; k < nelem; k++)
 #endif
     {
         daily_struct   *daily;
-        epconst_struct *epc;
+        const epconst_struct *epc;
         epvar_struct   *epv;
         soil_struct    *soil;
         eflux_struct   *ef;
@@ -142,9 +151,15 @@ void DailyBgc(int t, pihm_struct pihm)
         psn_struct     *psn_sun, *psn_shade;
         summary_struct *summary;
         int             annual_alloc;
+#if !defined(_LUMPEDBGC_)
+        double          start;
+
+        i = sched->order[k];
+        start = WallClock();
+#endif
 
         daily = &elem[i].daily;
-        epc = &elem[i].epc;
+        epc = elem[i].epc;
         epv = &elem[i].epv;
         soil = &elem[i].soil;
         ef = &elem[i].ef;
@@ -255,9 +270,13 @@ void DailyBgc(int t, pihm_struct pihm)
             elem[i].spinup.soilc += summary->soilc;
             elem[i].spinup.totalc += summary->totalc;
         }
+
+#if !defined(_LUMPEDBGC_)
+        SchedRecord(i, start, sched);
+#endif
     }
 
     first_balance = 0;
 
-    free(vwc);
+    ScratchRelease(vwc, ThreadScratch(pihm->scratch));
 }
@@ -1,7 +1,7 @@
 #include "pihm.h"
 
 void InitBgc(const epctbl_struct *epctbl, const calib_struct *calib,
-    elem_struct elem[])
+    const elem_struct elem[], lctbl_struct *lctbl)
 {
     int             i;
 
@@ -29,7 +29,9 @@ void InitBgc(const epctbl_struct *epctbl, const calib_struct *calib,
         }
 
         epc_ind--;
-        epc = &elem[i].epc;
+        /* BGC parameters are added to the shared constants of the land cover
+         * type the element points to */
+        epc = &lctbl->epc[epc_ind];
 
         epc->woody = epctbl->woody[epc_ind];
         epc->evergreen = epctbl->evergreen[epc_ind];
@@ -79,7 +81,8 @@ void InitBgc(const epctbl_struct *epctbl, const calib_struct *calib,
     }
 }
 
-void InitBgcVar(elem_struct elem[], river_struct river[], N_Vector CV_Y)
+void InitBgcVar(const init_struct *init, elem_struct elem[],
+    river_struct river[], N_Vector CV_Y)
 {
     int             i;
 
@@ -89,7 +92,7 @@ void InitBgcVar(elem_struct elem[], river_struct river[], N_Vector CV_Y)
     for (i = 0; i < nelem; i++)
 #endif
     {
-        RestartInput(&elem[i].restart_input, &elem[i].epv, &elem[i].cs,
+        RestartInput(&init->bgcic[i], &elem[i].epv, &elem[i].cs,
             &elem[i].ns);
 
         ZeroSrcSnk(&elem[i].cs, &elem[i].ns, &elem[i].summary,
@@ -111,7 +114,7 @@ void InitBgcVar(elem_struct elem[], river_struct river[], N_Vector CV_Y)
 #if !defined(_LUMPEDBGC_) && !defined(_LEACHING_)
     for (i = 0; i < nriver; i++)
     {
-        river[i].ns.streamn = river[i].restart_input.streamn;
+        river[i].ns.streamn = init->river_bgcic[i].streamn;
 
         NV_Ith(CV_Y, SOLUTE_RIVER(i, 0)) = river[i].ns.streamn;
     }
@@ -514,16 +514,13 @@ void ReadAnnualFile(const char fn[], tsdata_struct *ts)
     fp = pihm_fopen(fn, "r");
     pihm_printf(VL_VERBOSE, " Reading %s\n", fn);
 
-    ts->length = CountLine(fp, cmdstr, 1, "EOF");
-    ts->ftime = (int *)malloc(ts->length * sizeof(int));
-    ts->data = (double **)malloc(ts->length * sizeof(double *));
+    NewTs(CountLine(fp, cmdstr, 1, "EOF"), 1, ts);
 
     FindLine(fp, "BOF", &lno, fn);
     for (k = 0; k < ts->length; k++)
     {
-        ts->data[k] = (double *)malloc(sizeof(double));
         NextLine(fp, cmdstr, &lno);
-        if (sscanf(cmdstr, "%s %lf", timestr, &ts->data[k][0]) != 2)
+        if (sscanf(cmdstr, "%s %lf", timestr, &ts->data[0][k]) != 2)
         {
             pihm_error(ERR_WRONG_FORMAT, fn, lno);
         }
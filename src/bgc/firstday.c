@@ -1,7 +1,7 @@
 #include "pihm.h"
 
-void FirstDay(const cninit_struct *cninit, elem_struct elem[],
-    river_struct river[])
+void FirstDay(const cninit_struct *cninit, const elem_struct elem[],
+    init_struct *init)
 {
     int             i;
 
@@ -12,12 +12,12 @@ void FirstDay(const cninit_struct *cninit, elem_struct elem[],
 #endif
     {
         bgcic_struct   *restart;
-        epconst_struct *epc;
+        const epconst_struct *epc;
         double          max_leafc, max_frootc, max_stemc;
         double          new_stemc;
 
-        restart = &elem[i].restart_input;
-        epc = &elem[i].epc;
+        restart = &init->bgcic[i];
+        epc = elem[i].epc;
 
         /*
          * Copy from CN initialization structure
@@ -158,7 +158,7 @@ void FirstDay(const cninit_struct *cninit, elem_struct elem[],
 #if !defined(_LUMPEDBGC_) && !defined(_LEACHING_)
     for (i = 0; i < nriver; i++)
     {
-        river[i].restart_input.streamn = 0.0;
+        init->river_bgcic[i].streamn = 0.0;
     }
 #endif
 }
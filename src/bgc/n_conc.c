@@ -9,7 +9,7 @@ void SoluteConc(elem_struct elem[], river_struct river[])
      * Calculate solute N concentrations
      */
 #if defined(_OPENMP)
-# pragma omp parallel for
+# pragma omp for schedule(static) nowait
 #endif
     for (i = 0; i < nelem; i++)
     {
@@ -27,7 +27,7 @@ void SoluteConc(elem_struct elem[], river_struct river[])
     }
 
 #if defined(_OPENMP)
-# pragma omp parallel for
+# pragma omp for schedule(static)
 #endif
     for (i = 0; i < nriver; i++)
     {
@@ -164,7 +164,8 @@ void RestartOutput(const epvar_struct *epv, const cstate_struct *cs,
     restart->offset_swi     = epv->offset_swi;
 }
 
-void ReadBgcIc(const char fn[], elem_struct elem[], river_struct river[])
+void ReadBgcIc(const char fn[], const elem_struct elem[],
+    const river_struct river[], init_struct *init)
 {
     FILE           *fp;
     int             i;
@@ -178,29 +179,36 @@ void ReadBgcIc(const char fn[], elem_struct elem[], river_struct river[])
     for (i = 0; i < nelem; i++)
 #endif
     {
-        fread(&elem[i].restart_input, sizeof(bgcic_struct), 1, fp);
+#if !defined(_LUMPEDBGC_)
+        /* Records are stored in the order of element IDs */
+        fseek(fp, (long)(elem[i].id - 1) * (long)sizeof(bgcic_struct),
+            SEEK_SET);
+#endif
+        fread(&init->bgcic[i], sizeof(bgcic_struct), 1, fp);
 
         /* If simulation is accelerated spinup, adjust soil C pool sizes if
          * needed */
         if (spinup_mode == ACC_SPINUP_MODE)
         {
-            elem[i].restart_input.soil1c /= KS1_ACC;
-            elem[i].restart_input.soil2c /= KS2_ACC;
-            elem[i].restart_input.soil3c /= KS3_ACC;
-            elem[i].restart_input.soil4c /= KS4_ACC;
+            init->bgcic[i].soil1c /= KS1_ACC;
+            init->bgcic[i].soil2c /= KS2_ACC;
+            init->bgcic[i].soil3c /= KS3_ACC;
+            init->bgcic[i].soil4c /= KS4_ACC;
 
-            elem[i].restart_input.soil1n /= KS1_ACC;
-            elem[i].restart_input.soil2n /= KS2_ACC;
-            elem[i].restart_input.soil3n /= KS3_ACC;
-            elem[i].restart_input.soil4n /= KS4_ACC;
+            init->bgcic[i].soil1n /= KS1_ACC;
+            init->bgcic[i].soil2n /= KS2_ACC;
+            init->bgcic[i].soil3n /= KS3_ACC;
+            init->bgcic[i].soil4n /= KS4_ACC;
         }
     }
 
 #if !defined(_LUMPEDBGC_) && !defined(_LEACHING_)
     for (i = 0; i < nriver; i++)
     {
-        fread(&river[i].restart_input, sizeof(river_bgcic_struct), 1,
-            fp);
+        fseek(fp, (long)nelem * (long)sizeof(bgcic_struct) +
+            (long)(river[i].id - 1) * (long)sizeof(river_bgcic_struct),
+            SEEK_SET);
+        fread(&init->river_bgcic[i], sizeof(river_bgcic_struct), 1, fp);
     }
 #endif
 
@@ -213,6 +221,10 @@ void WriteBgcIc(const char outputdir[], elem_struct elem[],
     int             i;
     FILE           *fp;
     char            fn[MAXSTRING];
+    bgcic_struct    restart_output;
+#if !defined(_LUMPEDBGC_) && !defined(_LEACHING_)
+    river_bgcic_struct river_restart_output;
+#endif
 
     sprintf(fn, "%s/restart/%s.bgcic", outputdir, project);
 
@@ -226,34 +238,40 @@ void WriteBgcIc(const char outputdir[], elem_struct elem[],
 #endif
     {
         RestartOutput(&elem[i].epv, &elem[i].cs, &elem[i].ns,
-            &elem[i].restart_output);
+            &restart_output);
 
         /* If initial conditions are obtained using accelerated spinup, adjust
          * soil C pool sizes if needed */
         if (spinup_mode == ACC_SPINUP_MODE)
         {
-            elem[i].restart_output.soil1c *= KS1_ACC;
-            elem[i].restart_output.soil2c *= KS2_ACC;
-            elem[i].restart_output.soil3c *= KS3_ACC;
-            elem[i].restart_output.soil4c *= KS4_ACC;
+            restart_output.soil1c *= KS1_ACC;
+            restart_output.soil2c *= KS2_ACC;
+            restart_output.soil3c *= KS3_ACC;
+            restart_output.soil4c *= KS4_ACC;
 
-            elem[i].restart_output.soil1n *= KS1_ACC;
-            elem[i].restart_output.soil2n *= KS2_ACC;
-            elem[i].restart_output.soil3n *= KS3_ACC;
-            elem[i].restart_output.soil4n *= KS4_ACC;
+            restart_output.soil1n *= KS1_ACC;
+            restart_output.soil2n *= KS2_ACC;
+            restart_output.soil3n *= KS3_ACC;
+            restart_output.soil4n *= KS4_ACC;
         }
 
-        fwrite(&(elem[i].restart_output), sizeof(bgcic_struct), 1,
-            fp);
+#if !defined(_LUMPEDBGC_)
+        /* Records are written in the order of element IDs */
+        fseek(fp, (long)(elem[i].id - 1) * (long)sizeof(bgcic_struct),
+            SEEK_SET);
+#endif
+        fwrite(&restart_output, sizeof(bgcic_struct), 1, fp);
     }
 
 #if !defined(_LUMPEDBGC_) && !defined(_LEACHING_)
     for (i = 0; i < nriver; i++)
     {
-        river[i].restart_output.streamn = river[i].ns.streamn;
+        river_restart_output.streamn = river[i].ns.streamn;
 
-        fwrite(&(river[i].restart_output), sizeof(river_bgcic_struct), 1,
-            fp);
+        fseek(fp, (long)nelem * (long)sizeof(bgcic_struct) +
+            (long)(river[i].id - 1) * (long)sizeof(river_bgcic_struct),
+            SEEK_SET);
+        fwrite(&river_restart_output, sizeof(river_bgcic_struct), 1, fp);
     }
 #endif
 
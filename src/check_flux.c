@@ -0,0 +1,227 @@
+#include "pihm.h"
+
+/* Relative tolerance of the vectorized flux kernels */
+#define KERNEL_TOL              1.0E-12
+
+/* Cases of the check: groundwater storage, surface water depth, slope of the
+ * water surface across the interface, and friction slope */
+#define NUM_GW_CASE             7
+#define NUM_SURF_CASE           4
+#define NUM_GRAD_CASE           7
+#define NUM_SF_CASE             4
+
+void CheckFluxKernels(void)
+{
+    /*
+     * Check the vectorized flux kernels (InterfaceFlux, HydroEffKh and Pow23)
+     * against the scalar flux laws on a list of interfaces that covers dry
+     * elements, water tables below, inside and above the macropore layer with
+     * and without macropores, and water surface and friction slopes on both
+     * sides of GRADMIN, including level interfaces. Each interface joins its
+     * own pair of elements
+     */
+    const double    gw_case[NUM_GW_CASE] = {
+        -0.01, 0.0, 1.0, 1.5, 1.75, 2.0, 2.25
+    };
+    /* Surface water depths below and above DEPRSTG are exact in binary, so
+     * that level interfaces are exactly level */
+    const double    surf_case[NUM_SURF_CASE] = {
+        0.0, 0.000030517578125, 0.0001220703125, 0.03125
+    };
+    const double    grad_case[NUM_GRAD_CASE] = {
+        0.0, 0.5 * GRADMIN, -0.5 * GRADMIN, 2.0 * GRADMIN, -2.0 * GRADMIN,
+        1.0E-3, -1.0E-3
+    };
+    const double    sf_case[NUM_SF_CASE] = {
+        0.0, 0.5 * GRADMIN, 2.0 * GRADMIN, 0.01
+    };
+    const double    depth = 2.0;
+    const double    dist = 8.0;
+    int             nsub;
+    int             novl;
+    int             nface;
+    int             nerr = 0;
+    int             f;
+    double          x;
+    double          max_err = 0.0;
+    double         *sf;
+    elem_struct    *elem;
+    hydro_struct    hydro;
+
+    pihm_printf(VL_NORMAL,
+        "\nChecking flux kernels against scalar flux laws.\n");
+
+    /*
+     * Pow23
+     */
+    nerr += KernelError("Pow23", 0, Pow23(0.0), 0.0, &max_err);
+    for (x = 1.0E-29; x < 1.0E4; x *= 1.37)
+    {
+        nerr += KernelError("Pow23", 0, Pow23(x), pow(x, 2.0 / 3.0),
+            &max_err);
+    }
+
+    /*
+     * Interfaces. Subsurface and overland cases are cycled independently
+     */
+    nsub = NUM_GW_CASE * NUM_GW_CASE * 2 * 2;
+    novl = NUM_SURF_CASE * NUM_SURF_CASE * NUM_GRAD_CASE * NUM_SF_CASE;
+    nface = MAX(nsub, novl);
+
+    elem = (elem_struct *)calloc(2 * nface, sizeof(elem_struct));
+    sf = (double *)malloc(2 * nface * sizeof(double));
+
+    memset(&hydro, 0, sizeof(hydro_struct));
+    hydro.nface = nface;
+    hydro.gw = (double *)malloc(2 * nface * sizeof(double));
+    hydro.surfh = (double *)malloc(2 * nface * sizeof(double));
+    hydro.zmin = (double *)malloc(2 * nface * sizeof(double));
+    hydro.zmax = (double *)malloc(2 * nface * sizeof(double));
+    hydro.ksath = (double *)malloc(2 * nface * sizeof(double));
+    hydro.kmac = (double *)malloc(2 * nface * sizeof(double));
+    hydro.depth = (double *)malloc(2 * nface * sizeof(double));
+    hydro.dmac = (double *)malloc(2 * nface * sizeof(double));
+    hydro.face = (int *)malloc(2 * nface * sizeof(int));
+    hydro.inv_dist = (double *)malloc(nface * sizeof(double));
+    hydro.cond_sub = (double *)malloc(nface * sizeof(double));
+    hydro.cond_ovl = (double *)malloc(nface * sizeof(double));
+    hydro.qsub = (double *)malloc(nface * sizeof(double));
+    hydro.qovl = (double *)malloc(2 * nface * sizeof(double));
+
+    for (f = 0; f < nface; f++)
+    {
+        int             sub;
+        int             ovl;
+        int             k;
+        elem_struct    *elem_ptr;
+        elem_struct    *nabr;
+
+        elem_ptr = &elem[2 * f];
+        nabr = &elem[2 * f + 1];
+
+        sub = f % nsub;
+        ovl = f % novl;
+
+        /* Macropores on or off on either side */
+        elem_ptr->soil.depth = depth;
+        elem_ptr->soil.dmac = (sub / (NUM_GW_CASE * NUM_GW_CASE) % 2) ?
+            0.5 : 0.0;
+        elem_ptr->soil.ksath = 1.0E-5;
+        elem_ptr->soil.kmach = 1.0E-3;
+        elem_ptr->soil.areafv = 0.01;
+        elem_ptr->ws.gw = gw_case[sub % NUM_GW_CASE];
+
+        nabr->soil.depth = depth;
+        nabr->soil.dmac = (sub / (2 * NUM_GW_CASE * NUM_GW_CASE) % 2) ?
+            0.5 : 0.0;
+        nabr->soil.ksath = 4.0E-6;
+        nabr->soil.kmach = 2.0E-4;
+        nabr->soil.areafv = 0.05;
+        nabr->ws.gw = gw_case[sub / NUM_GW_CASE % NUM_GW_CASE];
+
+        elem_ptr->ws.surfh = surf_case[ovl % NUM_SURF_CASE];
+        nabr->ws.surfh = surf_case[ovl / NUM_SURF_CASE % NUM_SURF_CASE];
+
+        /* The water surface of the neighbor is set from the slope across the
+         * interface */
+        elem_ptr->topo.zmax = 256.0;
+        nabr->topo.zmax = elem_ptr->topo.zmax + elem_ptr->ws.surfh -
+            nabr->ws.surfh - dist *
+            grad_case[ovl / (NUM_SURF_CASE * NUM_SURF_CASE) % NUM_GRAD_CASE];
+        elem_ptr->topo.zmin = elem_ptr->topo.zmax - depth;
+        nabr->topo.zmin = nabr->topo.zmax - depth;
+
+        elem_ptr->topo.edge[0] = 10.0;
+        elem_ptr->topo.dist_nabr[0] = dist;
+        nabr->topo.edge[0] = 10.0;
+        nabr->topo.dist_nabr[0] = dist;
+
+        elem_ptr->lc.rough = 0.1;
+        nabr->lc.rough = 0.04;
+
+        sf[2 * f] = sf_case[ovl /
+            (NUM_SURF_CASE * NUM_SURF_CASE * NUM_GRAD_CASE) % NUM_SF_CASE];
+        sf[2 * f + 1] = sf_case[(ovl /
+            (NUM_SURF_CASE * NUM_SURF_CASE * NUM_GRAD_CASE) + 1) % NUM_SF_CASE];
+
+        /* Mirror and interface coefficients (see InitHydro, InitFaces and
+         * UpdateHydroLc) */
+        for (k = 2 * f; k < 2 * f + 2; k++)
+        {
+            hydro.gw[k] = elem[k].ws.gw;
+            hydro.surfh[k] = elem[k].ws.surfh;
+            hydro.zmin[k] = elem[k].topo.zmin;
+            hydro.zmax[k] = elem[k].topo.zmax;
+            hydro.ksath[k] = elem[k].soil.ksath;
+            hydro.kmac[k] = elem[k].soil.kmach * elem[k].soil.areafv +
+                elem[k].soil.ksath * (1.0 - elem[k].soil.areafv);
+            hydro.depth[k] = elem[k].soil.depth;
+            hydro.dmac[k] = elem[k].soil.dmac;
+            hydro.face[k] = NUM_EDGE * k;
+
+            nerr += KernelError("HydroEffKh", k, HydroEffKh(hydro.gw[k],
+                hydro.depth[k], hydro.dmac[k], hydro.kmac[k], hydro.ksath[k]),
+                EffKh(elem[k].ws.gw, &elem[k].soil), &max_err);
+        }
+
+        hydro.inv_dist[f] = 1.0 / dist;
+        hydro.cond_sub[f] = elem_ptr->topo.edge[0] / dist;
+        hydro.cond_ovl[f] = elem_ptr->topo.edge[0] /
+            (0.5 * (elem_ptr->lc.rough + nabr->lc.rough));
+    }
+
+    InterfaceFlux(sf, &hydro);
+
+    for (f = 0; f < nface; f++)
+    {
+        const elem_struct *elem_ptr = &elem[2 * f];
+        const elem_struct *nabr = &elem[2 * f + 1];
+        double          avg_sf;
+
+        avg_sf = 0.5 * (sf[2 * f] + sf[2 * f + 1]);
+
+        nerr += KernelError("InterfaceFlux (subsurface)", f, hydro.qsub[f],
+            SubsurfFlow(0, elem_ptr, nabr), &max_err);
+        nerr += KernelError("InterfaceFlux (overland)", f, hydro.qovl[2 * f],
+            OvlFlowElemToElem(0, avg_sf, elem_ptr, nabr), &max_err);
+        nerr += KernelError("InterfaceFlux (overland)", f,
+            hydro.qovl[2 * f + 1], OvlFlowElemToElem(0, avg_sf, nabr,
+            elem_ptr), &max_err);
+    }
+
+    pihm_printf(VL_NORMAL, "%d interfaces checked. Maximum relative error "
+        "%.3le.\n", nface, max_err);
+
+    free(elem);
+    free(sf);
+    FreeHydro(&hydro);
+
+    if (nerr > 0)
+    {
+        pihm_printf(VL_ERROR, "Error: %d fluxes of the flux kernels differ "
+            "from the scalar flux laws.\n", nerr);
+        pihm_exit(EXIT_FAILURE);
+    }
+}
+
+int KernelError(const char kernel[], int ind, double value, double ref,
+    double *max_err)
+{
+    /* Compare a value of a kernel with its reference. Zero references must be
+     * matched exactly */
+    double          err;
+
+    err = (ref != 0.0) ? fabs(value - ref) / fabs(ref) :
+        ((value != 0.0) ? 1.0 : 0.0);
+
+    *max_err = MAX(*max_err, err);
+
+    if (err > KERNEL_TOL)
+    {
+        pihm_printf(VL_VERBOSE, " %s differs at %d: %.15le vs %.15le.\n",
+            kernel, ind, value, ref);
+        return 1;
+    }
+
+    return 0;
+}
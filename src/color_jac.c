@@ -0,0 +1,438 @@
+#include "pihm.h"
+
+/*
+ * Jacobian approximation by finite differences of the RHS function with
+ * graph-colored columns. Columns that never share a non-zero row (distance-2
+ * coloring of the state vector graph) are perturbed together, so the full
+ * Jacobian costs one Ode evaluation per color instead of one per state
+ * variable. The dependency pattern covers hydrology and solute rows, so no
+ * hand-written derivatives are needed
+ */
+void InitColorJac(SUNMatrix pattern, colorjac_struct *colorjac)
+{
+    sunindextype    n;
+    sunindextype    nnz;
+    sunindextype   *ptr;
+    sunindextype   *ind;
+    sunindextype   *count;
+    int            *forbid;
+    sunindextype    i, j, k, kk;
+    int             c;
+    double          start;
+
+    start = WallClock();
+
+    n = SUNSparseMatrix_Rows(pattern);
+    nnz = SUNSparseMatrix_NNZ(pattern);
+    ptr = SUNSparseMatrix_IndexPointers(pattern);
+    ind = SUNSparseMatrix_IndexValues(pattern);
+
+    colorjac->color = (int *)malloc(n * sizeof(int));
+    colorjac->col_ptr = (sunindextype *)calloc(n + 1, sizeof(sunindextype));
+    colorjac->col_row = (sunindextype *)malloc(nnz * sizeof(sunindextype));
+    colorjac->col_pos = (sunindextype *)malloc(nnz * sizeof(sunindextype));
+    colorjac->inc = (double *)malloc(n * sizeof(double));
+
+    /* Transpose the pattern, keeping the position of each non-zero in the CSR
+     * data array */
+    for (k = 0; k < nnz; k++)
+    {
+        colorjac->col_ptr[ind[k] + 1]++;
+    }
+    for (j = 0; j < n; j++)
+    {
+        colorjac->col_ptr[j + 1] += colorjac->col_ptr[j];
+    }
+
+    count = (sunindextype *)calloc(n, sizeof(sunindextype));
+    for (i = 0; i < n; i++)
+    {
+        for (k = ptr[i]; k < ptr[i + 1]; k++)
+        {
+            kk = colorjac->col_ptr[ind[k]] + count[ind[k]]++;
+            colorjac->col_row[kk] = i;
+            colorjac->col_pos[kk] = k;
+        }
+    }
+
+    /* Greedy distance-2 coloring. A column may not share a color with any
+     * column that has a non-zero in one of its rows */
+    forbid = (int *)malloc(n * sizeof(int));
+    for (j = 0; j < n; j++)
+    {
+        colorjac->color[j] = -1;
+        forbid[j] = -1;
+    }
+
+    colorjac->ncolors = 0;
+    for (j = 0; j < n; j++)
+    {
+        for (k = colorjac->col_ptr[j]; k < colorjac->col_ptr[j + 1]; k++)
+        {
+            i = colorjac->col_row[k];
+
+            for (kk = ptr[i]; kk < ptr[i + 1]; kk++)
+            {
+                if (colorjac->color[ind[kk]] >= 0)
+                {
+                    forbid[colorjac->color[ind[kk]]] = (int)j;
+                }
+            }
+        }
+
+        for (c = 0; forbid[c] == (int)j; c++)
+        {
+        }
+
+        colorjac->color[j] = c;
+        colorjac->ncolors = MAX(colorjac->ncolors, c + 1);
+    }
+
+    /* Group columns by color */
+    colorjac->color_ptr =
+        (sunindextype *)calloc(colorjac->ncolors + 1, sizeof(sunindextype));
+    colorjac->color_col = (sunindextype *)malloc(n * sizeof(sunindextype));
+
+    for (j = 0; j < n; j++)
+    {
+        colorjac->color_ptr[colorjac->color[j] + 1]++;
+    }
+    for (c = 0; c < colorjac->ncolors; c++)
+    {
+        colorjac->color_ptr[c + 1] += colorjac->color_ptr[c];
+        count[c] = 0;
+    }
+    for (j = 0; j < n; j++)
+    {
+        c = colorjac->color[j];
+        colorjac->color_col[colorjac->color_ptr[c] + count[c]++] = j;
+    }
+
+    free(count);
+    free(forbid);
+
+    colorjac->time = WallClock() - start;
+
+    pihm_printf(VL_VERBOSE, "Colored Jacobian: %d colors for %ld columns, "
+        "setup time %.3f s.\n", colorjac->ncolors, (long int)n,
+        colorjac->time);
+}
+
+int ColorRowPattern(sunindextype row, const elem_struct elem[],
+    const river_struct river[], const rivnet_struct *rivnet,
+    sunindextype cols[])
+{
+    /*
+     * Column indices of the RHS dependency of one row, sorted. The pattern is
+     * a conservative superset: lateral rows depend on all water storages of
+     * neighboring elements and rivers, surface rows also depend on surface
+     * storages two elements away through the friction slope, and solute rows
+     * depend on all states of neighboring elements and rivers
+     */
+    int             ncol = 0;
+    int             nhydrol;
+    int             solute = 0;
+    int             layer = 0;
+    int             i;
+    int             j;
+    int             k;
+
+    nhydrol = 3 * nelem + nriver;
+#if defined(_DGW_)
+    nhydrol += 2 * nelem;
+#endif
+
+    if (row >= 3 * nelem && row < 3 * nelem + nriver)
+    {
+        i = row - 3 * nelem;
+        layer = -1;
+    }
+    else if (row < nhydrol)
+    {
+#if defined(_DGW_)
+        if (row >= 3 * nelem + nriver)
+        {
+            i = (row - 3 * nelem - nriver) % nelem;
+            layer = 3 + (row - 3 * nelem - nriver) / nelem;
+        }
+        else
+#endif
+        {
+            i = row % nelem;
+            layer = row / nelem;
+        }
+    }
+#if defined(_BGC_) || defined(_CYCLES_) || defined(_RT_)
+    else
+    {
+        solute = 1;
+        k = row - nhydrol;
+
+        if (k < nsolute * nelem)
+        {
+            i = k / nsolute;
+        }
+        else if (k < nsolute * (nelem + nriver))
+        {
+            i = (k - nsolute * nelem) / nsolute;
+            layer = -1;
+        }
+# if defined(_DGW_)
+        else
+        {
+            i = (k - nsolute * (nelem + nriver)) / nsolute;
+        }
+# endif
+    }
+#endif
+
+    if (layer < 0)
+    {
+        /* River segment rows */
+        ncol = AddRiverCols(i, solute, cols, ncol);
+
+        if (river[i].down > 0)
+        {
+            ncol = AddRiverCols(river[i].down - 1, solute, cols, ncol);
+        }
+
+        for (k = rivnet->up_ptr[i]; k < rivnet->up_ptr[i + 1]; k++)
+        {
+            ncol = AddRiverCols(rivnet->up[k], solute, cols, ncol);
+        }
+
+        if (river[i].left > 0)
+        {
+            ncol = AddElemCols(river[i].left - 1, solute, cols, ncol);
+        }
+
+        if (river[i].right > 0)
+        {
+            ncol = AddElemCols(river[i].right - 1, solute, cols, ncol);
+        }
+
+#if defined(_DGW_) && defined(_LUMPED_)
+        /* Deep groundwater runoff depends on the deep lateral fluxes of the
+         * bank elements */
+        for (k = 0; k < 2; k++)
+        {
+            int             bank;
+
+            bank = (k == 0) ? river[i].left - 1 : river[i].right - 1;
+
+            for (j = 0; bank >= 0 && j < NUM_EDGE; j++)
+            {
+                if (elem[bank].nabr[j] > 0)
+                {
+                    ncol = AddIndex(GW_GEOL(elem[bank].nabr[j] - 1), cols,
+                        ncol);
+                }
+            }
+        }
+#endif
+    }
+    else
+    {
+        /* Element rows. Vertical fluxes only depend on the element itself */
+        ncol = AddElemCols(i, solute, cols, ncol);
+
+        for (j = 0; j < NUM_EDGE && (solute || layer % 2 == 0); j++)
+        {
+            int             nabr;
+
+            nabr = elem[i].nabr[j] - 1;
+
+            if (elem[i].nabr_river[j] > 0)
+            {
+                ncol = AddRiverCols(elem[i].nabr_river[j] - 1, solute, cols,
+                    ncol);
+            }
+
+            if (nabr < 0)
+            {
+                continue;
+            }
+
+            ncol = AddElemCols(nabr, solute, cols, ncol);
+
+            if (solute || layer == 0)
+            {
+                /* Friction slope of the neighbor */
+                for (k = 0; k < NUM_EDGE; k++)
+                {
+                    if (elem[nabr].nabr_river[k] > 0)
+                    {
+                        ncol = AddIndex(RIVER(elem[nabr].nabr_river[k] - 1),
+                            cols, ncol);
+                    }
+                    else if (elem[nabr].nabr[k] > 0)
+                    {
+                        ncol = AddIndex(SURF(elem[nabr].nabr[k] - 1), cols,
+                            ncol);
+                    }
+                }
+            }
+        }
+    }
+
+    return SortIndex(ncol, cols);
+}
+
+int AddElemCols(int i, int solute, sunindextype cols[], int ncol)
+{
+    /*
+     * Add the water storages of an element, and its solute states if
+     * requested, to a list of columns
+     */
+    ncol = AddIndex(SURF(i), cols, ncol);
+    ncol = AddIndex(UNSAT(i), cols, ncol);
+    ncol = AddIndex(GW(i), cols, ncol);
+#if defined(_DGW_)
+    ncol = AddIndex(UNSAT_GEOL(i), cols, ncol);
+    ncol = AddIndex(GW_GEOL(i), cols, ncol);
+#endif
+
+#if defined(_BGC_) || defined(_CYCLES_) || defined(_RT_)
+    if (solute)
+    {
+        int             k;
+
+        for (k = 0; k < nsolute; k++)
+        {
+            ncol = AddIndex(SOLUTE_SOIL(i, k), cols, ncol);
+# if defined(_DGW_)
+            ncol = AddIndex(SOLUTE_GEOL(i, k), cols, ncol);
+# endif
+        }
+    }
+#endif
+
+    return ncol;
+}
+
+int AddRiverCols(int i, int solute, sunindextype cols[], int ncol)
+{
+    /*
+     * Add the storage of a river segment, and its solute states if requested,
+     * to a list of columns
+     */
+    ncol = AddIndex(RIVER(i), cols, ncol);
+
+#if defined(_BGC_) || defined(_CYCLES_) || defined(_RT_)
+    if (solute)
+    {
+        int             k;
+
+        for (k = 0; k < nsolute; k++)
+        {
+            ncol = AddIndex(SOLUTE_RIVER(i, k), cols, ncol);
+        }
+    }
+#endif
+
+    return ncol;
+}
+
+int AddIndex(sunindextype ind, sunindextype list[], int n)
+{
+    /* Append an index to a list unless it is already there */
+    int             k;
+
+    for (k = 0; k < n; k++)
+    {
+        if (list[k] == ind)
+        {
+            return n;
+        }
+    }
+
+    list[n] = ind;
+
+    return n + 1;
+}
+
+int ColorJac(realtype t, N_Vector CV_Y, N_Vector fy, SUNMatrix jac,
+    void *pihm_data, N_Vector tmp1, N_Vector tmp2, N_Vector tmp3)
+{
+    /*
+     * Fill the sparse Jacobian by one Ode evaluation per color. All columns of
+     * a color are perturbed at once, and each non-zero is recovered from the
+     * only perturbed column in its row
+     */
+    int             c;
+    sunindextype    j, k;
+    double         *y;
+    double         *ytmp;
+    double         *ftmp;
+    double         *f;
+    double         *data;
+    double          start;
+    const double    SRUR = sqrt(DBL_EPSILON);
+    pihm_struct     pihm;
+    colorjac_struct *colorjac;
+
+    start = WallClock();
+
+    pihm = (pihm_struct)pihm_data;
+    colorjac = &pihm->colorjac;
+
+    y = NV_DATA(CV_Y);
+    f = NV_DATA(fy);
+    ytmp = NV_DATA(tmp1);
+    ftmp = NV_DATA(tmp2);
+
+    /* CVODE zeroes the matrix before calling this function, which also clears
+     * the sparsity pattern. Restore the pattern with zero values */
+    SUNMatCopy(pihm->jac_pattern, jac);
+    data = SUNSparseMatrix_Data(jac);
+
+    N_VScale(1.0, CV_Y, tmp1);
+
+    for (j = 0; j < NumStateVar(); j++)
+    {
+        colorjac->inc[j] = SRUR * MAX(fabs(y[j]), 1.0);
+    }
+
+    for (c = 0; c < colorjac->ncolors; c++)
+    {
+        for (k = colorjac->color_ptr[c]; k < colorjac->color_ptr[c + 1]; k++)
+        {
+            j = colorjac->color_col[k];
+            ytmp[j] = y[j] + colorjac->inc[j];
+        }
+
+        Ode(t, tmp1, tmp2, pihm_data);
+
+        for (k = colorjac->color_ptr[c]; k < colorjac->color_ptr[c + 1]; k++)
+        {
+            sunindextype    kk;
+
+            j = colorjac->color_col[k];
+
+            for (kk = colorjac->col_ptr[j]; kk < colorjac->col_ptr[j + 1];
+                kk++)
+            {
+                data[colorjac->col_pos[kk]] =
+                    (ftmp[colorjac->col_row[kk]] - f[colorjac->col_row[kk]]) /
+                    colorjac->inc[j];
+            }
+
+            ytmp[j] = y[j];
+        }
+    }
+
+    colorjac->time += WallClock() - start;
+
+    return 0;
+}
+
+void FreeColorJac(colorjac_struct *colorjac)
+{
+    free(colorjac->color);
+    free(colorjac->color_ptr);
+    free(colorjac->color_col);
+    free(colorjac->col_ptr);
+    free(colorjac->col_row);
+    free(colorjac->col_pos);
+    free(colorjac->inc);
+}
@@ -1,8 +1,8 @@
 #include "pihm.h"
 
-void Cycles(int t, elem_struct elem[])
+void Cycles(int t, sched_struct *sched, elem_struct elem[])
 {
-    int             i;
+    int             k;
     int             year, month, day;
     int             doy;
     pihm_t_struct   pihm_t;
@@ -17,11 +17,20 @@ void Cycles(int t, elem_struct elem[])
     pihm_printf(VL_BRIEF, "DOY %d\n", doy);
 #endif
 
+    /* Elements are visited in the order of the cost-aware schedule, because
+     * crop growth and management operations make some elements much more
+     * expensive than others */
 #if defined(_OPENMP)
-# pragma omp parallel for
+# pragma omp parallel for schedule(dynamic, 1)
 #endif
-    for (i = 0; i < nelem; i++)
+    for (k = 0; k < nelem; k++)
     {
+        int             i;
+        double          start;
+
+        i = sched->order[k];
+        start = WallClock();
+
         /*
          * Run daily cycles processes
          */
@@ -32,6 +41,8 @@ void Cycles(int t, elem_struct elem[])
 
         /* Calculate daily sink/source terms for NO3 and NH4 */
         CalSnkSrc(elem[i].ps.nlayers, &elem[i].nf, elem[i].solute);
+
+        SchedRecord(i, start, sched);
     }
 }
 
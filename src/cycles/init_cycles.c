@@ -69,7 +69,7 @@ void InitCycles(const calib_struct *calib, const agtbl_struct *agtbl,
 }
 
 void FirstDay(const soiltbl_struct *soiltbl, const ctrl_struct *ctrl,
-    elem_struct elem[])
+    const elem_struct elem[], agic_struct agic[])
 {
     int             i;
 
@@ -80,69 +80,69 @@ void FirstDay(const soiltbl_struct *soiltbl, const ctrl_struct *ctrl,
 
         soil_ind = elem[i].attrib.soil - 1;
 
-        elem[i].restart_input.water_residue_stan = 0.0;
-        elem[i].restart_input.water_residue_flat = 0.0;
-        elem[i].restart_input.c_residue_stan     = 0.0;
-        elem[i].restart_input.c_residue_flat     = 0.0;
-        elem[i].restart_input.c_manure_surface   = 0.0;
-        elem[i].restart_input.n_residue_stan     = 0.0;
-        elem[i].restart_input.n_residue_flat     = 0.0;
-        elem[i].restart_input.n_manure_surface   = 0.0;
+        agic[i].water_residue_stan = 0.0;
+        agic[i].water_residue_flat = 0.0;
+        agic[i].c_residue_stan     = 0.0;
+        agic[i].c_residue_flat     = 0.0;
+        agic[i].c_manure_surface   = 0.0;
+        agic[i].n_residue_stan     = 0.0;
+        agic[i].n_residue_flat     = 0.0;
+        agic[i].n_manure_surface   = 0.0;
 
         for (kz = 0; kz < MAXLYR; kz++)
         {
-            elem[i].restart_input.c_residue_abgd[kz]  = BADVAL;
-            elem[i].restart_input.c_residue_root[kz]  = BADVAL;
-            elem[i].restart_input.c_residue_rhizo[kz] = BADVAL;
-            elem[i].restart_input.c_manure[kz]        = BADVAL;
-            elem[i].restart_input.n_residue_abgd[kz]  = BADVAL;
-            elem[i].restart_input.n_residue_root[kz]  = BADVAL;
-            elem[i].restart_input.n_residue_rhizo[kz] = BADVAL;
-            elem[i].restart_input.n_manure[kz]        = BADVAL;
-            elem[i].restart_input.soc[kz]             = BADVAL;
-            elem[i].restart_input.mbc[kz]             = BADVAL;
-            elem[i].restart_input.son[kz]             = BADVAL;
-            elem[i].restart_input.mbn[kz]             = BADVAL;
-            elem[i].restart_input.no3[kz]             = BADVAL;
-            elem[i].restart_input.nh4[kz]             = BADVAL;
+            agic[i].c_residue_abgd[kz]  = BADVAL;
+            agic[i].c_residue_root[kz]  = BADVAL;
+            agic[i].c_residue_rhizo[kz] = BADVAL;
+            agic[i].c_manure[kz]        = BADVAL;
+            agic[i].n_residue_abgd[kz]  = BADVAL;
+            agic[i].n_residue_root[kz]  = BADVAL;
+            agic[i].n_residue_rhizo[kz] = BADVAL;
+            agic[i].n_manure[kz]        = BADVAL;
+            agic[i].soc[kz]             = BADVAL;
+            agic[i].mbc[kz]             = BADVAL;
+            agic[i].son[kz]             = BADVAL;
+            agic[i].mbn[kz]             = BADVAL;
+            agic[i].no3[kz]             = BADVAL;
+            agic[i].nh4[kz]             = BADVAL;
         }
 
         for (kz = 0; kz < elem[i].ps.nlayers; kz++)
         {
-            elem[i].restart_input.c_residue_abgd[kz]  = 0.0;
-            elem[i].restart_input.c_residue_root[kz]  = 0.0;
-            elem[i].restart_input.c_residue_rhizo[kz] = 0.0;
-            elem[i].restart_input.c_manure[kz]        = 0.0;
-            elem[i].restart_input.n_residue_abgd[kz]  = 0.0;
-            elem[i].restart_input.n_residue_root[kz]  = 0.0;
-            elem[i].restart_input.n_residue_rhizo[kz] = 0.0;
-            elem[i].restart_input.n_manure[kz]        = 0.0;
-            elem[i].restart_input.soc[kz]             = BADVAL;
-            elem[i].restart_input.mbc[kz]             = BADVAL;
-            elem[i].restart_input.son[kz]             = BADVAL;
-            elem[i].restart_input.mbn[kz]             = BADVAL;
-            elem[i].restart_input.no3[kz]             = BADVAL;
-            elem[i].restart_input.nh4[kz]             = BADVAL;
+            agic[i].c_residue_abgd[kz]  = 0.0;
+            agic[i].c_residue_root[kz]  = 0.0;
+            agic[i].c_residue_rhizo[kz] = 0.0;
+            agic[i].c_manure[kz]        = 0.0;
+            agic[i].n_residue_abgd[kz]  = 0.0;
+            agic[i].n_residue_root[kz]  = 0.0;
+            agic[i].n_residue_rhizo[kz] = 0.0;
+            agic[i].n_manure[kz]        = 0.0;
+            agic[i].soc[kz]             = BADVAL;
+            agic[i].mbc[kz]             = BADVAL;
+            agic[i].son[kz]             = BADVAL;
+            agic[i].mbn[kz]             = BADVAL;
+            agic[i].no3[kz]             = BADVAL;
+            agic[i].nh4[kz]             = BADVAL;
 
-            elem[i].restart_input.soc[kz] = soiltbl->om_layer[soil_ind][kz] /
+            agic[i].soc[kz] = soiltbl->om_layer[soil_ind][kz] /
                 100.0 * 0.58 * elem[i].ps.soil_depth[kz] * elem[i].soil.bd[kz] *
                 1.0E4;
             /* Initializes as 3% of SOC_Mass but "added" C */
-            elem[i].restart_input.mbc[kz] = 0.03 *
-                elem[i].restart_input.soc[kz];
+            agic[i].mbc[kz] = 0.03 * agic[i].soc[kz];
             /* Initializes with CN ratio = 10 */
-            elem[i].restart_input.son[kz] = elem[i].restart_input.soc[kz] * 0.1;
+            agic[i].son[kz] = agic[i].soc[kz] * 0.1;
             /* Initializes with CN ratio = 10 */
-            elem[i].restart_input.mbn[kz] = elem[i].restart_input.mbc[kz] * 0.1;
-            elem[i].restart_input.no3[kz] = soiltbl->no3[soil_ind][kz] *
+            agic[i].mbn[kz] = agic[i].mbc[kz] * 0.1;
+            agic[i].no3[kz] = soiltbl->no3[soil_ind][kz] *
                 1.0E-3 * elem[i].ps.soil_depth[kz] / ctrl->soil_depth[kz];
-            elem[i].restart_input.nh4[kz] = soiltbl->nh4[soil_ind][kz] *
+            agic[i].nh4[kz] = soiltbl->nh4[soil_ind][kz] *
                 1.0E-3 * elem[i].ps.soil_depth[kz] / ctrl->soil_depth[kz];
         }
     }
 }
 
-void InitAgVar(elem_struct elem[], river_struct river[], N_Vector CV_Y)
+void InitAgVar(const agic_struct agic[], elem_struct elem[],
+    river_struct river[], N_Vector CV_Y)
 {
     int             i;
 
@@ -150,34 +150,28 @@ void InitAgVar(elem_struct elem[], river_struct river[], N_Vector CV_Y)
     {
         int             kz;
 
-        elem[i].ws.stan_residue   = elem[i].restart_input.water_residue_stan;
-        elem[i].ws.flat_residue   = elem[i].restart_input.water_residue_flat;
-        elem[i].cs.stan_residue   = elem[i].restart_input.c_residue_stan;
-        elem[i].cs.flat_residue   = elem[i].restart_input.c_residue_flat;
-        elem[i].cs.manure_surface = elem[i].restart_input.c_manure_surface;
+        elem[i].ws.stan_residue   = agic[i].water_residue_stan;
+        elem[i].ws.flat_residue   = agic[i].water_residue_flat;
+        elem[i].cs.stan_residue   = agic[i].c_residue_stan;
+        elem[i].cs.flat_residue   = agic[i].c_residue_flat;
+        elem[i].cs.manure_surface = agic[i].c_manure_surface;
 
         for (kz = 0; kz < MAXLYR; kz++)
         {
-            elem[i].cs.abgd_residue[kz] =
-                elem[i].restart_input.c_residue_abgd[kz];
-            elem[i].cs.root_residue[kz] =
-                elem[i].restart_input.c_residue_root[kz];
-            elem[i].cs.rhizo_residue[kz] =
-                elem[i].restart_input.c_residue_rhizo[kz];
-            elem[i].cs.manure[kz] = elem[i].restart_input.c_manure[kz];
-            elem[i].ns.residue_abgd[kz] =
-                elem[i].restart_input.n_residue_abgd[kz];
-            elem[i].ns.residue_root[kz] =
-                elem[i].restart_input.n_residue_root[kz];
-            elem[i].ns.residue_rhizo[kz] =
-                elem[i].restart_input.n_residue_rhizo[kz];
-            elem[i].ns.manure[kz] = elem[i].restart_input.n_manure[kz];
-            elem[i].cs.soc[kz] = elem[i].restart_input.soc[kz];
-            elem[i].cs.mbc[kz] = elem[i].restart_input.mbc[kz];
-            elem[i].ns.son[kz] = elem[i].restart_input.son[kz];
-            elem[i].ns.mbn[kz] = elem[i].restart_input.mbn[kz];
-            elem[i].ns.no3[kz] = elem[i].restart_input.no3[kz];
-            elem[i].ns.nh4[kz] = elem[i].restart_input.nh4[kz];
+            elem[i].cs.abgd_residue[kz] = agic[i].c_residue_abgd[kz];
+            elem[i].cs.root_residue[kz] = agic[i].c_residue_root[kz];
+            elem[i].cs.rhizo_residue[kz] = agic[i].c_residue_rhizo[kz];
+            elem[i].cs.manure[kz] = agic[i].c_manure[kz];
+            elem[i].ns.residue_abgd[kz] = agic[i].n_residue_abgd[kz];
+            elem[i].ns.residue_root[kz] = agic[i].n_residue_root[kz];
+            elem[i].ns.residue_rhizo[kz] = agic[i].n_residue_rhizo[kz];
+            elem[i].ns.manure[kz] = agic[i].n_manure[kz];
+            elem[i].cs.soc[kz] = agic[i].soc[kz];
+            elem[i].cs.mbc[kz] = agic[i].mbc[kz];
+            elem[i].ns.son[kz] = agic[i].son[kz];
+            elem[i].ns.mbn[kz] = agic[i].mbn[kz];
+            elem[i].ns.no3[kz] = agic[i].no3[kz];
+            elem[i].ns.nh4[kz] = agic[i].nh4[kz];
         }
 
         ZeroFluxes(&elem[i].wf, &elem[i].cf, &elem[i].nf);
@@ -188,7 +182,6 @@ void InitAgVar(elem_struct elem[], river_struct river[], N_Vector CV_Y)
         NV_Ith(CV_Y, SOLUTE_SOIL(i, NO3)) = elem[i].ps.no3;
         NV_Ith(CV_Y, SOLUTE_SOIL(i, NH4)) = elem[i].ps.nh4;
 
-        elem[i].ns0 = elem[i].ns;
         elem[i].ps.no3_prev = elem[i].ps.no3;
         elem[i].ps.nh4_prev = elem[i].ps.nh4;
     }
@@ -225,8 +218,11 @@ void WriteCyclesIc(const char outputdir[], const elem_struct elem[])
     fp = pihm_fopen(fn, "wb");
     pihm_printf(VL_VERBOSE, "Writing Cycles initial conditions.\n");
 
+    /* Records are written in the order of element IDs (see ReadCyclesIc) */
     for (i = 0; i < nelem; i++)
     {
+        fseek(fp, (long)(elem[i].id - 1) * (long)sizeof(agic_struct),
+            SEEK_SET);
         fwrite(&elem[i].ws.stan_residue,   sizeof(double), 1, fp);
         fwrite(&elem[i].ws.flat_residue,   sizeof(double), 1, fp);
         fwrite(&elem[i].cs.stan_residue,   sizeof(double), 1, fp);
@@ -7,7 +7,7 @@ void SoluteConc(double dt, elem_struct elem[], river_struct river[])
      * Calculate solute N concentrations
      */
 #if defined(_OPENMP)
-# pragma omp parallel for
+# pragma omp for schedule(static) nowait
 #endif
     for (i = 0; i < nelem; i++)
     {
@@ -35,7 +35,7 @@ void SoluteConc(double dt, elem_struct elem[], river_struct river[])
     }
 
 #if defined(_OPENMP)
-# pragma omp parallel for
+# pragma omp for schedule(static)
 #endif
     for (i = 0; i < nriver; i++)
     {
@@ -279,7 +279,8 @@ void ReadMultOper(const agtbl_struct *agtbl, mgmt_struct mgmttbl[],
     }
 }
 
-void ReadCyclesIc(const char fn[], elem_struct elem[])
+void ReadCyclesIc(const char fn[], const elem_struct elem[],
+    agic_struct agic[])
 {
     FILE           *fp;
     int             i;
@@ -287,9 +288,12 @@ void ReadCyclesIc(const char fn[], elem_struct elem[])
     fp = pihm_fopen(fn, "rb");
     pihm_printf(VL_VERBOSE, " Reading %s\n", fn);
 
+    /* Records are stored in the order of element IDs */
     for (i = 0; i < nelem; i++)
     {
-        fread(&elem[i].restart_input, sizeof(agic_struct), 1, fp);
+        fseek(fp, (long)(elem[i].id - 1) * (long)sizeof(agic_struct),
+            SEEK_SET);
+        fread(&agic[i], sizeof(agic_struct), 1, fp);
     }
 
     fclose(fp);
@@ -0,0 +1,204 @@
+#include "pihm.h"
+
+void InitEvent(void *cvode_mem, const ctrl_struct *ctrl, event_struct *event)
+{
+    /*
+     * Register root functions at the thresholds where the flux functions
+     * switch regime. Each element has ponding, macropore, and saturation
+     * thresholds, and each river segment has its bank height
+     */
+    int             cv_flag;
+
+    event->nroot = (ctrl->root_event) ? NUM_ELEM_EVENT * nelem + nriver : 0;
+    event->rootsfound = NULL;
+    event->armed = NULL;
+    event->rearm = NULL;
+    memset(&event->stats0, 0, sizeof(cvstats_struct));
+
+    if (event->nroot == 0)
+    {
+        return;
+    }
+
+    event->rootsfound = (int *)malloc(event->nroot * sizeof(int));
+    event->armed = (int *)malloc(event->nroot * sizeof(int));
+    event->rearm = (double *)malloc(event->nroot * sizeof(double));
+
+    ArmEvents(event);
+
+    cv_flag = CVodeRootInit(cvode_mem, event->nroot, EventRoot);
+    CheckCVodeFlag(cv_flag);
+
+    /* Storages that sit exactly at a threshold at a restart are expected */
+    cv_flag = CVodeSetNoInactiveRootWarn(cvode_mem);
+    CheckCVodeFlag(cv_flag);
+
+    pihm_printf(VL_VERBOSE, "Root-finding events: %d root functions.\n",
+        event->nroot);
+}
+
+void ArmEvents(event_struct *event)
+{
+    int             k;
+
+    for (k = 0; k < event->nroot; k++)
+    {
+        event->armed[k] = 1;
+        event->rearm[k] = 0.0;
+    }
+}
+
+void FreeEvent(event_struct *event)
+{
+    free(event->rootsfound);
+    free(event->armed);
+    free(event->rearm);
+}
+
+int EventRoot(realtype t, N_Vector CV_Y, realtype *gout, void *pihm_data)
+{
+    /*
+     * Root functions change sign when a storage crosses a flux regime
+     * threshold. Disarmed root functions are held at a constant value.
+     * Thresholds are written in terms of CVODE state variables, e.g., the
+     * ponding threshold surfh = DEPRSTG corresponds to
+     * surf_eqv = 0.5 * DEPRSTG (see SurfH)
+     */
+    int             i;
+    double         *y;
+    pihm_struct     pihm;
+    elem_struct    *elem;
+    river_struct   *river;
+    const int      *armed;
+
+    y = NV_DATA(CV_Y);
+    pihm = (pihm_struct)pihm_data;
+
+    elem = &pihm->elem[0];
+    river = &pihm->river[0];
+    armed = pihm->event.armed;
+
+#if defined(_OPENMP)
+# pragma omp parallel for
+#endif
+    for (i = 0; i < nelem; i++)
+    {
+        realtype       *g;
+
+        g = &gout[NUM_ELEM_EVENT * i];
+
+        /* Depression storage filled (SurfH, AvgHsurf, OvlFlowElemToRiver) */
+        g[PONDING_EVENT] = y[SURF(i)] - 0.5 * DEPRSTG;
+
+        /* Water table enters the macropore depth (EffKh) */
+        g[MACROPORE_EVENT] = y[GW(i)] -
+            (elem[i].soil.depth - elem[i].soil.dmac);
+
+        /* Soil column saturated (Infil, EffKh) */
+        g[SATURATION_EVENT] = y[GW(i)] - elem[i].soil.depth;
+    }
+
+#if defined(_OPENMP)
+# pragma omp parallel for
+#endif
+    for (i = 0; i < nriver; i++)
+    {
+        /* River stage reaches bank height (OvlFlowElemToRiver) */
+        gout[NUM_ELEM_EVENT * nelem + i] = y[RIVER(i)] - river[i].shp.depth;
+    }
+
+    for (i = 0; i < pihm->event.nroot; i++)
+    {
+        gout[i] = (armed[i]) ? gout[i] : 1.0;
+    }
+
+    return 0;
+}
+
+void RestartAtEvent(realtype t, int hold, N_Vector CV_Y, void *cvode_mem,
+    event_struct *event)
+{
+    /*
+     * Restart CVODE at a located threshold crossing, so that the next step
+     * starts from the new flux regime with a fresh, low-order history instead
+     * of straddling the discontinuity. Root functions that found the event
+     * are disarmed for the hold-off time to keep storages hovering at a
+     * threshold from restarting CVODE at every step. Disarmed root functions
+     * are re-armed at restarts, where CVODE re-evaluates all root functions,
+     * and at model steps (see RearmEvents)
+     */
+    int             cv_flag;
+    int             k;
+
+    cv_flag = CVodeGetRootInfo(cvode_mem, event->rootsfound);
+    CheckCVodeFlag(cv_flag);
+
+    for (k = 0; k < event->nroot; k++)
+    {
+        if (event->rootsfound[k] != 0)
+        {
+            event->armed[k] = 0;
+            event->rearm[k] = (double)t + (double)hold;
+        }
+        else if (!event->armed[k] && (double)t >= event->rearm[k])
+        {
+            event->armed[k] = 1;
+        }
+    }
+
+    event->stats0.nevents++;
+
+    RestartCVode(t, CV_Y, cvode_mem, event);
+}
+
+void RearmEvents(realtype t, N_Vector CV_Y, void *cvode_mem,
+    event_struct *event)
+{
+    /*
+     * Re-arm root functions whose hold-off time has expired. CVODE locates
+     * roots from sign changes since its last step, where disarmed root
+     * functions were held at a constant value, so CVODE is restarted to
+     * re-evaluate all root functions at the current state
+     */
+    int             k;
+    int             rearmed = 0;
+
+    for (k = 0; k < event->nroot; k++)
+    {
+        if (!event->armed[k] && (double)t >= event->rearm[k])
+        {
+            event->armed[k] = 1;
+            rearmed = 1;
+        }
+    }
+
+    if (rearmed)
+    {
+        RestartCVode(t, CV_Y, cvode_mem, event);
+    }
+}
+
+void RestartCVode(realtype t, N_Vector CV_Y, void *cvode_mem,
+    event_struct *event)
+{
+    /* CVodeReInit resets solver statistics, and the attached nonlinear solver
+     * resets its iteration count at the next step */
+    int             cv_flag;
+    cvstats_struct  stats;
+
+    GetCVodeStats(cvode_mem, NULL, NULL, &stats);
+
+    event->stats0.nst += stats.nst;
+    event->stats0.nfe += stats.nfe;
+    event->stats0.nni += stats.nni;
+    event->stats0.ncfn += stats.ncfn;
+    event->stats0.netf += stats.netf;
+    event->stats0.nli += stats.nli;
+    event->stats0.npe += stats.npe;
+    event->stats0.nps += stats.nps;
+    event->stats0.nlcf += stats.nlcf;
+    event->stats0.nje += stats.nje;
+
+    cv_flag = CVodeReInit(cvode_mem, t, CV_Y);
+    CheckCVodeFlag(cv_flag);
+}
@@ -0,0 +1,331 @@
+#include "pihm.h"
+
+/*
+ * Streamed forcing keeps a window of two blocks of values of each series
+ * mapped from a binary forcing file: the block of the current forcing
+ * interval, and the next block, which a prefetch thread reads while the model
+ * runs through the current one. Forcing times stay mapped. Values are never
+ * read through the mapping, so the memory of forcing values is bounded by the
+ * FORC_MEMORY parameter regardless of simulation length
+ */
+
+void InitForcStream(double forc_mem, forc_struct *forc)
+{
+    tsdata_struct  *set[MAXBINFORC];
+    int             nset[MAXBINFORC];
+    int             i, j, k, m;
+    int             block;
+    size_t          row_bytes = 0;
+    prefetch_struct *prefetch = &forc->prefetch;
+
+    forc->nstream = 0;
+
+    if (forc_mem <= 0.0)
+    {
+        return;
+    }
+
+    set[0] = forc->meteo;
+    nset[0] = forc->nmeteo;
+    set[1] = forc->lai;
+    nset[1] = forc->nlai;
+    set[2] = forc->bc;
+    nset[2] = forc->nbc;
+#if defined(_NOAH_)
+    set[3] = forc->rad;
+    nset[3] = forc->nrad;
+#else
+    nset[3] = 0;
+#endif
+#if defined(_RT_)
+    set[4] = forc->prcpc;
+    nset[4] = forc->nprcpc;
+#else
+    nset[4] = 0;
+#endif
+
+    for (m = 0; m < MAXBINFORC; m++)
+    {
+        for (i = 0; i < nset[m]; i++)
+        {
+            if (set[m][i].mapped)
+            {
+                forc->nstream++;
+                row_bytes += set[m][i].nvrbl * sizeof(double);
+            }
+        }
+    }
+
+    if (forc->nstream == 0)
+    {
+        pihm_printf(VL_NORMAL, "Warning: FORC_MEMORY only applies to binary "
+            "forcing files. Whole forcing series are kept in memory.\n");
+        return;
+    }
+
+    /* Two buffers of block + 1 forcing times per series */
+    block = (int)(forc_mem * 1024.0 * 1024.0 / (2.0 * (double)row_bytes)) - 1;
+    if (block < 1)
+    {
+        block = 1;
+        pihm_printf(VL_NORMAL, "Warning: FORC_MEMORY is too small. Streamed "
+            "forcing uses %.3f MB.\n",
+            4.0 * (double)row_bytes / 1024.0 / 1024.0);
+    }
+
+    pihm_printf(VL_VERBOSE, " Streaming %d forcing series in blocks of %d "
+        "forcing intervals\n", forc->nstream, block);
+
+    for (m = 0; m < MAXBINFORC; m++)
+    {
+        for (i = 0; i < nset[m]; i++)
+        {
+            tsdata_struct  *ts = &set[m][i];
+            tsstream_struct *stream;
+            int             nvrbl = ts->nvrbl;
+
+            if (!ts->mapped)
+            {
+                continue;
+            }
+
+            stream = (tsstream_struct *)malloc(sizeof(tsstream_struct));
+
+            /* Locate the value columns in the binary forcing file */
+            for (j = 0; j < forc->nbinforc; j++)
+            {
+                if ((char *)ts->data[0] >= (char *)forc->binforc[j].addr &&
+                    (char *)ts->data[0] <
+                    (char *)forc->binforc[j].addr + forc->binforc[j].size)
+                {
+                    stream->fd = forc->binforc[j].fd;
+                    stream->offset = (char *)ts->data[0] -
+                        (char *)forc->binforc[j].addr;
+                    break;
+                }
+            }
+
+            stream->block = MIN(block, MAX(ts->length - 1, 1));
+            stream->buffer[0] = (double *)malloc(2 * (size_t)nvrbl *
+                (stream->block + 1) * sizeof(double));
+            stream->buffer[1] = stream->buffer[0] +
+                (size_t)nvrbl * (stream->block + 1);
+            stream->first[0] = -1;
+            stream->first[1] = -1;
+            stream->cur = 0;
+            stream->next = -1;
+            stream->pending = 0;
+            stream->scale = (double *)malloc(2 * nvrbl * sizeof(double));
+            stream->shift = stream->scale + nvrbl;
+            for (k = 0; k < nvrbl; k++)
+            {
+                stream->scale[k] = 1.0;
+                stream->shift[k] = 0.0;
+            }
+            stream->prefetch = prefetch;
+
+            ts->stream = stream;
+        }
+    }
+
+    prefetch->size = forc->nstream;
+    prefetch->queue =
+        (tsdata_struct **)malloc(prefetch->size * sizeof(tsdata_struct *));
+    prefetch->head = 0;
+    prefetch->nqueue = 0;
+
+#if defined(_OPENMP)
+    prefetch->quit = 0;
+    pthread_mutex_init(&prefetch->mutex, NULL);
+    pthread_cond_init(&prefetch->cond, NULL);
+
+    if (pthread_create(&prefetch->thread, NULL, Prefetch, prefetch) != 0)
+    {
+        pihm_printf(VL_ERROR, "Error creating the prefetch thread.\n");
+        pihm_exit(EXIT_FAILURE);
+    }
+#endif
+}
+
+void FreeForcStream(forc_struct *forc)
+{
+    prefetch_struct *prefetch = &forc->prefetch;
+
+    if (forc->nstream == 0)
+    {
+        return;
+    }
+
+#if defined(_OPENMP)
+    pthread_mutex_lock(&prefetch->mutex);
+    prefetch->quit = 1;
+    pthread_cond_broadcast(&prefetch->cond);
+    pthread_mutex_unlock(&prefetch->mutex);
+
+    pthread_join(prefetch->thread, NULL);
+    pthread_mutex_destroy(&prefetch->mutex);
+    pthread_cond_destroy(&prefetch->cond);
+#endif
+
+    free(prefetch->queue);
+    forc->nstream = 0;
+}
+
+void ReadBlock(int first, int buf, tsdata_struct *ts)
+{
+    /* Read the block starting at forcing time first into buffer buf */
+    tsstream_struct *stream = ts->stream;
+    int             n;
+    int             j, k;
+
+    n = MIN(first + stream->block, ts->length - 1) - first + 1;
+
+    for (k = 0; k < ts->nvrbl; k++)
+    {
+        double         *col;
+
+        col = stream->buffer[buf] + (size_t)k * (stream->block + 1);
+
+#if !defined(_WIN32) && !defined(_WIN64)
+        if (pread(stream->fd, col, n * sizeof(double), (off_t)(stream->offset +
+            ((long long)k * ts->length + first) * sizeof(double))) !=
+            (ssize_t)(n * sizeof(double)))
+        {
+            pihm_printf(VL_ERROR, "Error reading streamed forcing.\n");
+            pihm_exit(EXIT_FAILURE);
+        }
+#endif
+
+        /* Climate scenarios */
+        if (stream->scale[k] != 1.0 || stream->shift[k] != 0.0)
+        {
+            for (j = 0; j < n; j++)
+            {
+                col[j] = col[j] * stream->scale[k] + stream->shift[k];
+            }
+        }
+    }
+
+    stream->first[buf] = first;
+}
+
+void SeekStream(int j, tsdata_struct *ts)
+{
+    /*
+     * Make forcing times j - 1 and j available in data. Forward moves swap in
+     * the prefetched block. Other moves, e.g., rewinds of spin-up simulations,
+     * read the block right away
+     */
+    tsstream_struct *stream = ts->stream;
+    int             first;
+    int             k;
+
+    first = (j - 1) / stream->block * stream->block;
+
+    if (stream->first[stream->cur] == first)
+    {
+        return;
+    }
+
+    WaitPrefetch(stream);
+
+    stream->cur = 1 - stream->cur;
+
+    if (stream->first[stream->cur] != first)
+    {
+        ReadBlock(first, stream->cur, ts);
+    }
+
+    for (k = 0; k < ts->nvrbl; k++)
+    {
+        ts->data[k] = stream->buffer[stream->cur] +
+            (size_t)k * (stream->block + 1);
+    }
+    ts->first = first;
+
+    /* Prefetch the next block into the buffer just released */
+    if (first + stream->block < ts->length - 1)
+    {
+        QueuePrefetch(first + stream->block, ts);
+    }
+}
+
+void QueuePrefetch(int first, tsdata_struct *ts)
+{
+    /* Queue the read of the block starting at forcing time first. Without
+     * OpenMP, blocks are read when needed */
+#if defined(_OPENMP)
+    tsstream_struct *stream = ts->stream;
+    prefetch_struct *prefetch = stream->prefetch;
+
+    pthread_mutex_lock(&prefetch->mutex);
+
+    stream->first[1 - stream->cur] = -1;
+    stream->next = first;
+    stream->pending = 1;
+    prefetch->queue[(prefetch->head + prefetch->nqueue) % prefetch->size] = ts;
+    prefetch->nqueue++;
+
+    pthread_cond_broadcast(&prefetch->cond);
+    pthread_mutex_unlock(&prefetch->mutex);
+#endif
+}
+
+void WaitPrefetch(tsstream_struct *stream)
+{
+    /* Wait until the prefetch of the series is done */
+#if defined(_OPENMP)
+    prefetch_struct *prefetch = stream->prefetch;
+
+    pthread_mutex_lock(&prefetch->mutex);
+
+    while (stream->pending)
+    {
+        pthread_cond_wait(&prefetch->cond, &prefetch->mutex);
+    }
+
+    pthread_mutex_unlock(&prefetch->mutex);
+#endif
+}
+
+#if defined(_OPENMP)
+void *Prefetch(void *arg)
+{
+    /* Main function of the prefetch thread, which reads queued blocks in order
+     * of request */
+    prefetch_struct *prefetch = (prefetch_struct *)arg;
+
+    pthread_mutex_lock(&prefetch->mutex);
+
+    while (1)
+    {
+        tsdata_struct  *ts;
+
+        while (prefetch->nqueue == 0 && !prefetch->quit)
+        {
+            pthread_cond_wait(&prefetch->cond, &prefetch->mutex);
+        }
+
+        if (prefetch->nqueue == 0)
+        {
+            break;
+        }
+
+        ts = prefetch->queue[prefetch->head];
+        prefetch->head = (prefetch->head + 1) % prefetch->size;
+        prefetch->nqueue--;
+
+        pthread_mutex_unlock(&prefetch->mutex);
+        ReadBlock(ts->stream->next, 1 - ts->stream->cur, ts);
+        pthread_mutex_lock(&prefetch->mutex);
+
+        ts->stream->pending = 0;
+
+        pthread_cond_broadcast(&prefetch->cond);
+    }
+
+    pthread_mutex_unlock(&prefetch->mutex);
+
+    return NULL;
+}
+#endif
@@ -63,19 +63,13 @@ void ApplyElemBc(int t, const rttbl_struct *rttbl, forc_struct *forc,
 void ApplyElemBc(int t, forc_struct *forc, elem_struct elem[])
 #endif
 {
-    int             i, k;
+    int             i;
 
-#if defined(_OPENMP)
-# pragma omp parallel for
-#endif
-    for (k = 0; k < forc->nbc; k++)
-    {
 #if defined(_RT_)
-        IntrplForcing(t, 1 + rttbl->num_stc, INTRPL, &forc->bc[k]);
+    IntrplForcingSet(t, 1 + rttbl->num_stc, INTRPL, forc->nbc, forc->bc);
 #else
-        IntrplForcing(t, 1, INTRPL, &forc->bc[k]);
+    IntrplForcingSet(t, 1, INTRPL, forc->nbc, forc->bc);
 #endif
-    }
 
 #if defined(_OPENMP)
 # pragma omp parallel for
@@ -151,7 +145,7 @@ void ApplyMeteoForcing(int t, int rad_mode, const siteinfo_struct *siteinfo,
 void ApplyMeteoForcing(int t, forc_struct *forc, elem_struct elem[])
 #endif
 {
-    int             i, k;
+    int             i;
 #if defined(_NOAH_)
     spa_data        spa;
 #endif
@@ -159,13 +153,7 @@ void ApplyMeteoForcing(int t, forc_struct *forc, elem_struct elem[])
     /*
      * Meteorological forcing for PIHM
      */
-#if defined(_OPENMP)
-# pragma omp parallel for
-#endif
-    for (k = 0; k < forc->nmeteo; k++)
-    {
-        IntrplForcing(t, NUM_METEO_VAR, INTRPL, &forc->meteo[k]);
-    }
+    IntrplForcingSet(t, NUM_METEO_VAR, INTRPL, forc->nmeteo, forc->meteo);
 
 #if defined(_NOAH_)
     /*
@@ -173,13 +161,7 @@ void ApplyMeteoForcing(int t, forc_struct *forc, elem_struct elem[])
      */
     if (rad_mode == TOPO_SOL)
     {
-# if defined(_OPENMP)
-#  pragma omp parallel for
-# endif
-        for (k = 0; k < forc->nrad; k++)
-        {
-            IntrplForcing(t, 2, INTRPL, &forc->rad[k]);
-        }
+        IntrplForcingSet(t, 2, INTRPL, forc->nrad, forc->rad);
 
         /* Calculate Sun position for topographic solar radiation */
         SunPos(t, siteinfo, &spa);
@@ -225,7 +207,7 @@ void ApplyMeteoForcing(int t, forc_struct *forc, elem_struct elem[])
 void ApplyDailyMeteoForcing(int t, int rad_mode,
     const siteinfo_struct *siteinfo, forc_struct *forc, elem_struct elem[])
 {
-    int             i, k, kt;
+    int             i, kt;
     spa_data        spa;
 
 #if defined(_OPENMP)
@@ -248,29 +230,18 @@ void ApplyDailyMeteoForcing(int t, int rad_mode,
 
     for (kt = t; kt < t + DAYINSEC; kt += 3600)
     {
-#if defined(_OPENMP)
-#pragma omp parallel for
-#endif
         /*
         * Meteorological forcing for PIHM
         */
-        for (k = 0; k < forc->nmeteo; k++)
-        {
-            IntrplForcing(kt, NUM_METEO_VAR, INTRPL, &forc->meteo[k]);
-        }
+        IntrplForcingSet(kt, NUM_METEO_VAR, INTRPL, forc->nmeteo,
+            forc->meteo);
 
         /*
         * Topographic radiation for Noah
         */
         if (rad_mode == TOPO_SOL)
         {
-#if defined(_OPENMP)
-#pragma omp parallel for
-#endif
-            for (k = 0; k < forc->nrad; k++)
-            {
-                IntrplForcing(kt, 2, INTRPL, &forc->rad[k]);
-            }
+            IntrplForcingSet(kt, 2, INTRPL, forc->nrad, forc->rad);
 
             /* Calculate Sun position for topographic solar radiation */
             SunPos(kt, siteinfo, &spa);
@@ -358,26 +329,18 @@ void ApplyLai(int t, forc_struct *forc, elem_struct elem[])
     {
 # if defined(_LUMPEDBGC_)
         elem[i].ps.proj_lai =
-            elem[LUMPEDBGC].cs.leafc * elem[LUMPEDBGC].epc.avg_proj_sla;
+            elem[LUMPEDBGC].cs.leafc * elem[LUMPEDBGC].epc->avg_proj_sla;
 # else
-        elem[i].ps.proj_lai = elem[i].cs.leafc * elem[i].epc.avg_proj_sla;
+        elem[i].ps.proj_lai = elem[i].cs.leafc * elem[i].epc->avg_proj_sla;
 # endif
     }
 #else
     /*
      * Use LAI forcing
      */
-    int             k;
-
     if (forc->nlai > 0)
     {
-#if defined(_OPENMP)
-# pragma omp parallel for
-#endif
-        for (k = 0; k < forc->nlai; k++)
-        {
-            IntrplForcing(t, 1, INTRPL, &forc->lai[k]);
-        }
+        IntrplForcingSet(t, 1, INTRPL, forc->nlai, forc->lai);
     }
 
 # if defined(_OPENMP)
@@ -405,17 +368,12 @@ void ApplyLai(int t, forc_struct *forc, elem_struct elem[])
 void ApplyPrcpConc(int t, const rttbl_struct *rttbl, forc_struct *forc,
     elem_struct elem[])
 {
-    int             i, j;
+    int             i;
 
     if (forc->prcp_flag == 2)
     {
-#if defined(_OPENMP)
-# pragma omp parallel for
-#endif
-        for (j = 0; j < forc->nprcpc; j++)
-        {
-            IntrplForcing(t, rttbl->num_spc, NO_INTRPL, &forc->prcpc[j]);
-        }
+        IntrplForcingSet(t, rttbl->num_spc, NO_INTRPL, forc->nprcpc,
+            forc->prcpc);
 
 #if defined(_OPENMP)
 # pragma omp parallel for
@@ -454,15 +412,9 @@ void ApplyPrcpConc(int t, const rttbl_struct *rttbl, forc_struct *forc,
 
 void ApplyRiverBc(int t, forc_struct *forc, river_struct river[])
 {
-    int             i, k;
+    int             i;
 
-#if defined(_OPENMP)
-# pragma omp parallel for
-#endif
-    for (k = 0; k < forc->nriverbc; k++)
-    {
-        IntrplForcing(t, 1, INTRPL, &forc->riverbc[k]);
-    }
+    IntrplForcingSet(t, 1, INTRPL, forc->nriverbc, forc->riverbc);
 
 #if defined(_OPENMP)
 # pragma omp parallel for
@@ -486,42 +438,210 @@ void ApplyRiverBc(int t, forc_struct *forc, river_struct river[])
 
 void IntrplForcing(int t, int nvrbl, int intrpl, tsdata_struct *ts)
 {
-    int             j;
-    int             first, middle, last;
+    LocateForcing(t, ts);
+    IntrplTs(nvrbl, intrpl, ts, ts);
+}
+
+void IntrplForcingSet(int t, int nvrbl, int intrpl, int nts,
+    tsdata_struct ts[])
+{
+    /*
+     * Interpolate all series of a forcing file. The forcing interval and
+     * interpolation weights are only found once for each set of series that
+     * share forcing times
+     */
+    int             k;
 
-    if (t < ts->ftime[0])
+    for (k = 0; k < nts; k++)
     {
-        pihm_printf(VL_ERROR, "Error finding forcing for current time step.\n"
-            "Please check your forcing file.\n");
-        pihm_exit(EXIT_FAILURE);
+        if (ts[k].axis == k)
+        {
+            LocateForcing(t, &ts[k]);
+        }
+    }
+
+#if defined(_OPENMP)
+# pragma omp parallel for
+#endif
+    for (k = 0; k < nts; k++)
+    {
+        IntrplTs(nvrbl, intrpl, &ts[ts[k].axis], &ts[k]);
     }
-    else if (t > ts->ftime[ts->length - 1])
+}
+
+void LocateForcing(int t, tsdata_struct *ts)
+{
+    /*
+     * Find the forcing interval that contains t, and the interpolation
+     * weights of its two ends. Model time moves forward, so the search starts
+     * from the interval found last, and only falls back to bisection when
+     * time goes back, e.g., in spin-up simulations, or skips intervals
+     */
+    int             j = ts->cursor;
+
+    if (ts->length < 2 || t < ts->ftime[0] || t > ts->ftime[ts->length - 1])
     {
         pihm_printf(VL_ERROR, "Error finding forcing for current time step.\n"
             "Please check your forcing file.\n");
         pihm_exit(EXIT_FAILURE);
     }
 
-    first = 1;
-    last = ts->length - 1;
+    if (j > 0 && t >= ts->ftime[j - 1] &&
+        (t < ts->ftime[j] || j == ts->length - 1))
+    {
+        /* Same interval */
+    }
+    else if (j > 0 && t >= ts->ftime[j] &&
+        (j + 1 == ts->length - 1 || t < ts->ftime[j + 1]))
+    {
+        /* Next interval */
+        j++;
+    }
+    else
+    {
+        int             first, last;
 
-    while (first <= last)
+        /* Bisection for the first forcing time after t */
+        first = 1;
+        last = ts->length - 1;
+
+        while (first < last)
+        {
+            int             middle;
+
+            middle = (first + last) / 2;
+
+            if (ts->ftime[middle] > t)
+            {
+                last = middle;
+            }
+            else
+            {
+                first = middle + 1;
+            }
+        }
+
+        j = first;
+    }
+
+    if (j != ts->cursor)
     {
-        middle = (first + last) / 2;
-        if (t >= ts->ftime[middle - 1] && t < ts->ftime[middle])
+        ts->cursor = j;
+        ts->rdt = 1.0 / (double)(ts->ftime[j] - ts->ftime[j - 1]);
+    }
+
+    ts->weight[0] = (double)(ts->ftime[j] - t) * ts->rdt;
+    ts->weight[1] = (double)(t - ts->ftime[j - 1]) * ts->rdt;
+}
+
+void IntrplTs(int nvrbl, int intrpl, const tsdata_struct *axis,
+    tsdata_struct *ts)
+{
+    /* Forcing values of ts at the interval and weights found for its forcing
+     * times (axis) */
+    int             j = axis->cursor;
+    int             k;
+
+    if (ts->stream != NULL)
+    {
+        SeekStream(j, ts);
+    }
+
+    /* Index of the end of the interval in data */
+    j -= ts->first;
+
+    if (intrpl)
+    {
+        for (k = 0; k < nvrbl; k++)
+        {
+            ts->value[k] = axis->weight[0] * ts->data[k][j - 1] +
+                axis->weight[1] * ts->data[k][j];
+        }
+    }
+    else
+    {
+        for (k = 0; k < nvrbl; k++)
         {
-            for (j = 0; j < nvrbl; j++)
+            ts->value[k] = ts->data[k][j - 1];
+        }
+    }
+}
+
+void InitTsAxis(int nts, tsdata_struct ts[])
+{
+    /* Find for each series the first series with the same forcing times */
+    int             k, r;
+
+    for (k = 0; k < nts; k++)
+    {
+        ts[k].axis = k;
+        ts[k].cursor = 0;
+
+        for (r = 0; r < k; r++)
+        {
+            if (ts[r].axis == r && ts[r].length == ts[k].length &&
+                memcmp(ts[r].ftime, ts[k].ftime,
+                ts[k].length * sizeof(int)) == 0)
             {
-                ts->value[j] = (intrpl) ?
-                    ((double)(ts->ftime[middle] - t) * ts->data[middle - 1][j] +
-                    (double)(t - ts->ftime[middle - 1]) * ts->data[middle][j]) /
-                    (double)(ts->ftime[middle] - ts->ftime[middle - 1]) :
-                    ts->data[middle - 1][j];
+                ts[k].axis = r;
+                break;
             }
-            break;
         }
-        else if (ts->ftime[middle] > t)
+    }
+}
+
+int NextBreakpoint(int t, const ctrl_struct *ctrl, forc_struct *forc)
+{
+    /*
+     * Next time after t at which the RHS of the ODEs changes: the next land
+     * surface step, the next boundary condition forcing time, or the end of
+     * simulation. Breakpoints are rounded up to model steps, at which forcing
+     * is applied. Boundary conditions are interpolated between forcing times,
+     * and are sampled at every model step while any of them changes
+     */
+    int             tbreak;
+    int             k;
+
+    if (VaryingForcing(t, forc->nbc, forc->bc) ||
+        VaryingForcing(t, forc->nriverbc, forc->riverbc))
+    {
+        return MIN(t + ctrl->stepsize, ctrl->endtime);
+    }
+
+    tbreak = ctrl->starttime +
+        ((t - ctrl->starttime) / ctrl->etstep + 1) * ctrl->etstep;
+
+    for (k = 0; k < forc->nbc; k++)
+    {
+        tbreak = NextForcingTime(t, tbreak, &forc->bc[k]);
+    }
+
+    for (k = 0; k < forc->nriverbc; k++)
+    {
+        tbreak = NextForcingTime(t, tbreak, &forc->riverbc[k]);
+    }
+
+    tbreak = ctrl->starttime + (tbreak - ctrl->starttime + ctrl->stepsize - 1) /
+        ctrl->stepsize * ctrl->stepsize;
+
+    return MIN(tbreak, ctrl->endtime);
+}
+
+int NextForcingTime(int t, int tbreak, const tsdata_struct *ts)
+{
+    /* Earlier of tbreak and the first forcing time after t */
+    int             first, middle, last;
+
+    first = 0;
+    last = ts->length - 1;
+
+    while (first <= last)
+    {
+        middle = (first + last) / 2;
+
+        if (ts->ftime[middle] > t)
         {
+            tbreak = MIN(tbreak, ts->ftime[middle]);
             last = middle - 1;
         }
         else
@@ -529,6 +649,50 @@ void IntrplForcing(int t, int nvrbl, int intrpl, tsdata_struct *ts)
             first = middle + 1;
         }
     }
+
+    return tbreak;
+}
+
+int VaryingForcing(int t, int nts, tsdata_struct ts[])
+{
+    /*
+     * Whether any series of a forcing file changes over the forcing interval
+     * that contains t. Series that are interpolated in time and change need to
+     * be applied at every model step
+     */
+    int             k;
+
+    for (k = 0; k < nts; k++)
+    {
+        if (ts[k].axis == k)
+        {
+            LocateForcing(t, &ts[k]);
+        }
+    }
+
+    for (k = 0; k < nts; k++)
+    {
+        int             j = ts[ts[k].axis].cursor;
+        int             v;
+
+        if (ts[k].stream != NULL)
+        {
+            SeekStream(j, &ts[k]);
+        }
+
+        /* Index of the end of the interval in data */
+        j -= ts[k].first;
+
+        for (v = 0; v < ts[k].nvrbl; v++)
+        {
+            if (ts[k].data[v][j - 1] != ts[k].data[v][j])
+            {
+                return 1;
+            }
+        }
+    }
+
+    return 0;
 }
 
 double MonthlyLai(int t, int lc)
@@ -4,6 +4,12 @@ void FreeMem(pihm_struct pihm)
 {
     int             i;
 
+    /* Asynchronous tasks still in flight use model data and output files */
+    FreeTaskGraph(&pihm->taskgraph);
+
+    /* Write output still in blocks before output files are closed */
+    FreeOutputWriter(pihm->ctrl.ascii, &pihm->print);
+
     FreeRivtbl(&pihm->rivtbl);
 
     FreeShptbl(&pihm->shptbl);
@@ -28,6 +34,54 @@ void FreeMem(pihm_struct pihm)
     FreeEpctbl(&pihm->epctbl);
 #endif
 
+#if defined(_RT_)
+    FreeChmPool(&pihm->chmpool);
+#endif
+
+    FreeScratch(pihm->scratch);
+    FreeSched(pihm->sched);
+
+    FreeHydro(&pihm->hydro);
+
+    FreeRiverNet(&pihm->rivnet);
+
+    /* Nonlinear solvers attached by PIHM are not owned by CVODE */
+    if (pihm->nls.newton != NULL)
+    {
+        SUNNonlinSolFree(pihm->nls.newton);
+    }
+    if (pihm->nls.fixedpt != NULL)
+    {
+        SUNNonlinSolFree(pihm->nls.fixedpt);
+    }
+
+    if (pihm->ctrl.root_event)
+    {
+        FreeEvent(&pihm->event);
+    }
+
+    if (pihm->ctrl.precond != PREC_NONE)
+    {
+        FreePrecond(&pihm->prec);
+    }
+
+    if (pihm->ctrl.jtimes || (pihm->ctrl.linsol == SPARSE_LS &&
+        pihm->ctrl.sparse_jac == ANALYTIC_JAC))
+    {
+        FreeJacTimes(&pihm->jtimes);
+    }
+
+    if (pihm->ctrl.linsol == SPARSE_LS)
+    {
+        if (pihm->ctrl.sparse_jac == COLOR_FD_JAC)
+        {
+            FreeColorJac(&pihm->colorjac);
+        }
+
+        SUNMatDestroy(pihm->jac);
+        SUNMatDestroy(pihm->jac_pattern);
+    }
+
     FreeCtrl(&pihm->ctrl);
 
     /*
@@ -40,23 +94,32 @@ void FreeMem(pihm_struct pihm)
     if (debug_mode)
     {
         fclose(pihm->print.cvodeperf_file);
+        fclose(pihm->print.schedperf_file);
     }
     for (i = 0; i < pihm->print.nprint; i++)
     {
         free(pihm->print.varctrl[i].var);
         free(pihm->print.varctrl[i].buffer);
-        fclose(pihm->print.varctrl[i].datfile);
+        if (pihm->print.outfile == NULL)
+        {
+            fclose(pihm->print.varctrl[i].datfile);
+        }
         if (pihm->ctrl.ascii)
         {
             fclose(pihm->print.varctrl[i].txtfile);
         }
     }
+    if (pihm->print.outfile != NULL)
+    {
+        fclose(pihm->print.outfile);
+    }
     free(pihm->elem);
     free(pihm->river);
 }
 
 void FreeRivtbl(rivtbl_struct *rivtbl)
 {
+    free(rivtbl->id);
     free(rivtbl->from);
     free(rivtbl->to);
     free(rivtbl->down);
@@ -91,6 +154,7 @@ void FreeMeshtbl(meshtbl_struct *meshtbl)
         free(meshtbl->node[i]);
         free(meshtbl->nabr[i]);
     }
+    free(meshtbl->id);
     free(meshtbl->node);
     free(meshtbl->nabr);
     free(meshtbl->x);
@@ -179,22 +243,20 @@ void FreeLctbl(lctbl_struct *lctbl)
     free(lctbl->rsmin);
     free(lctbl->rough);
     free(lctbl->rzd);
+    free(lctbl->epc);
 }
 
 void FreeForc(forc_struct *forc)
 {
-    int             i, j;
+    int             i;
+
+    FreeForcStream(forc);
 
     if (forc->nriverbc > 0)
     {
         for (i = 0; i < forc->nriverbc; i++)
         {
-            for (j = 0; j < forc->riverbc[i].length; j++)
-            {
-                free(forc->riverbc[i].data[j]);
-            }
-            free(forc->riverbc[i].ftime);
-            free(forc->riverbc[i].data);
+            FreeTs(&forc->riverbc[i]);
         }
         free(forc->riverbc);
     }
@@ -203,13 +265,7 @@ void FreeForc(forc_struct *forc)
     {
         for (i = 0; i < forc->nmeteo; i++)
         {
-            for (j = 0; j < forc->meteo[i].length; j++)
-            {
-                free(forc->meteo[i].data[j]);
-            }
-            free(forc->meteo[i].ftime);
-            free(forc->meteo[i].data);
-            free(forc->meteo[i].value);
+            FreeTs(&forc->meteo[i]);
         }
         free(forc->meteo);
     }
@@ -218,13 +274,7 @@ void FreeForc(forc_struct *forc)
     {
         for (i = 0; i < forc->nlai; i++)
         {
-            for (j = 0; j < forc->lai[i].length; j++)
-            {
-                free(forc->lai[i].data[j]);
-            }
-            free(forc->lai[i].ftime);
-            free(forc->lai[i].data);
-            free(forc->lai[i].value);
+            FreeTs(&forc->lai[i]);
         }
         free(forc->lai);
     }
@@ -233,13 +283,7 @@ void FreeForc(forc_struct *forc)
     {
         for (i = 0; i < forc->nbc; i++)
         {
-            for (j = 0; j < forc->bc[i].length; j++)
-            {
-                free(forc->bc[i].data[j]);
-            }
-            free(forc->bc[i].ftime);
-            free(forc->bc[i].data);
-            free(forc->bc[i].value);
+            FreeTs(&forc->bc[i]);
         }
         free(forc->bc);
     }
@@ -249,13 +293,7 @@ void FreeForc(forc_struct *forc)
     {
         for (i = 0; i < forc->nrad; i++)
         {
-            for (j = 0; j < forc->rad[i].length; j++)
-            {
-                free(forc->rad[i].data[j]);
-            }
-            free(forc->rad[i].ftime);
-            free(forc->rad[i].data);
-            free(forc->rad[i].value);
+            FreeTs(&forc->rad[i]);
         }
         free(forc->rad);
     }
@@ -264,25 +302,13 @@ void FreeForc(forc_struct *forc)
 #if defined(_BGC_)
     if (forc->nco2 > 0)
     {
-        for (j = 0; j < forc->co2[0].length; j++)
-        {
-            free(forc->co2[0].data[j]);
-        }
-        free(forc->co2[0].ftime);
-        free(forc->co2[0].data);
-        free(forc->co2[0].value);
+        FreeTs(&forc->co2[0]);
     }
     free(forc->co2);
 
     if (forc->nndep > 0)
     {
-        for (j = 0; j < forc->ndep[0].length; j++)
-        {
-            free(forc->ndep[0].data[j]);
-        }
-        free(forc->ndep[0].ftime);
-        free(forc->ndep[0].data);
-        free(forc->ndep[0].value);
+        FreeTs(&forc->ndep[0]);
     }
     free(forc->ndep);
 #endif
@@ -292,16 +318,12 @@ void FreeForc(forc_struct *forc)
     {
         for (i = 0; i < forc->nprcpc; i++)
         {
-            for (j = 0; j < forc->prcpc[i].length; j++)
-            {
-                free(forc->prcpc[i].data[j]);
-            }
-            free(forc->prcpc[i].ftime);
-            free(forc->prcpc[i].data);
-            free(forc->prcpc[i].value);
+            FreeTs(&forc->prcpc[i]);
         }
     }
 #endif
+
+    UnmapForcing(forc);
 }
 
 #if defined(_BGC_)
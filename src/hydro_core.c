@@ -0,0 +1,395 @@
+#include "pihm.h"
+
+void InitHydro(const elem_struct elem[], hydro_struct *hydro)
+{
+    /*
+     * Allocate the structure-of-arrays mirror of the lateral flux kernels and
+     * copy element parameters, which do not change after initialization
+     * except for land cover (see UpdateHydroLc). States are written by Ode at
+     * every RHS evaluation
+     */
+    int             i;
+
+    hydro->surfh = (double *)calloc(nelem, sizeof(double));
+    hydro->gw = (double *)calloc(nelem, sizeof(double));
+    hydro->zmin = (double *)malloc(nelem * sizeof(double));
+    hydro->zmax = (double *)malloc(nelem * sizeof(double));
+    hydro->rough = (double *)malloc(nelem * sizeof(double));
+    hydro->ksath = (double *)malloc(nelem * sizeof(double));
+    hydro->kmac = (double *)malloc(nelem * sizeof(double));
+    hydro->depth = (double *)malloc(nelem * sizeof(double));
+    hydro->dmac = (double *)malloc(nelem * sizeof(double));
+    hydro->nabr = (int *)malloc(NUM_EDGE * nelem * sizeof(int));
+    hydro->nabr_river = (int *)malloc(NUM_EDGE * nelem * sizeof(int));
+    hydro->edge = (double *)malloc(NUM_EDGE * nelem * sizeof(double));
+    hydro->dist_nabr = (double *)malloc(NUM_EDGE * nelem * sizeof(double));
+    hydro->x_nabr = (double *)malloc(NUM_EDGE * nelem * sizeof(double));
+    hydro->y_nabr = (double *)malloc(NUM_EDGE * nelem * sizeof(double));
+#if defined(_BGC_) || defined(_CYCLES_) || defined(_RT_)
+    hydro->avg_smcmax = (double *)malloc(NUM_EDGE * nelem * sizeof(double));
+    hydro->avg_depth = (double *)malloc(NUM_EDGE * nelem * sizeof(double));
+# if defined(_DGW_)
+    hydro->avg_smcmax_geol =
+        (double *)malloc(NUM_EDGE * nelem * sizeof(double));
+    hydro->avg_depth_geol =
+        (double *)malloc(NUM_EDGE * nelem * sizeof(double));
+# endif
+#endif
+
+    /* Arrays are first written with the static partition of Ode, so that on
+     * NUMA systems their pages are placed close to the threads using them */
+#if defined(_OPENMP)
+# pragma omp parallel for schedule(static)
+#endif
+    for (i = 0; i < nelem; i++)
+    {
+        int             j;
+        int             k;
+#if defined(_BGC_) || defined(_CYCLES_) || defined(_RT_)
+        int             nabr;
+#endif
+
+        hydro->zmin[i] = elem[i].topo.zmin;
+        hydro->zmax[i] = elem[i].topo.zmax;
+        hydro->ksath[i] = elem[i].soil.ksath;
+        hydro->kmac[i] = elem[i].soil.kmach * elem[i].soil.areafv +
+            elem[i].soil.ksath * (1.0 - elem[i].soil.areafv);
+        hydro->depth[i] = elem[i].soil.depth;
+        hydro->dmac[i] = elem[i].soil.dmac;
+
+        for (j = 0; j < NUM_EDGE; j++)
+        {
+            k = NUM_EDGE * i + j;
+
+            hydro->nabr[k] = elem[i].nabr[j] - 1;
+            hydro->nabr_river[k] = elem[i].nabr_river[j] - 1;
+            hydro->edge[k] = elem[i].topo.edge[j];
+            hydro->dist_nabr[k] = elem[i].topo.dist_nabr[j];
+            hydro->x_nabr[k] = elem[i].topo.x_nabr[j];
+            hydro->y_nabr[k] = elem[i].topo.y_nabr[j];
+
+#if defined(_BGC_) || defined(_CYCLES_) || defined(_RT_)
+            /* Averages of solute transport. Boundary edges take the values
+             * of the element */
+            nabr = (elem[i].nabr[j] > 0) ? elem[i].nabr[j] - 1 : i;
+
+            hydro->avg_smcmax[k] =
+                0.5 * (elem[i].soil.smcmax + elem[nabr].soil.smcmax);
+            hydro->avg_depth[k] =
+                0.5 * (elem[i].soil.depth + elem[nabr].soil.depth);
+# if defined(_DGW_)
+            hydro->avg_smcmax_geol[k] =
+                0.5 * (elem[i].geol.smcmax + elem[nabr].geol.smcmax);
+            hydro->avg_depth_geol[k] =
+                0.5 * (elem[i].geol.depth + elem[nabr].geol.depth);
+# endif
+#endif
+        }
+    }
+
+    InitFaces(hydro);
+
+    UpdateHydroLc(elem, hydro);
+}
+
+void InitFaces(hydro_struct *hydro)
+{
+    /*
+     * Build the list of element-to-element interfaces, each listed once from
+     * the element with the lower index, and the list of domain boundary edges.
+     * Both sides of an interface store their own fluxes, so interfaces do not
+     * share output slots and can be evaluated in any order
+     */
+    int             i;
+    int             j;
+    int             k;
+    int             nabr;
+    int             jn;
+    int             nface = 0;
+    int             nbound = 0;
+
+    for (k = 0; k < NUM_EDGE * nelem; k++)
+    {
+        nface += (hydro->nabr[k] > k / NUM_EDGE) ? 1 : 0;
+        nbound += (hydro->nabr[k] < 0) ? 1 : 0;
+    }
+
+    hydro->nface = nface;
+    hydro->nbound = nbound;
+    hydro->face = (int *)malloc(2 * nface * sizeof(int));
+    hydro->bound = (int *)malloc(nbound * sizeof(int));
+    hydro->inv_dist = (double *)malloc(nface * sizeof(double));
+    hydro->cond_sub = (double *)malloc(nface * sizeof(double));
+    hydro->cond_ovl = (double *)malloc(nface * sizeof(double));
+    hydro->qsub = (double *)malloc(nface * sizeof(double));
+    hydro->qovl = (double *)malloc(2 * nface * sizeof(double));
+
+    nface = 0;
+    nbound = 0;
+    for (i = 0; i < nelem; i++)
+    {
+        for (j = 0; j < NUM_EDGE; j++)
+        {
+            k = NUM_EDGE * i + j;
+            nabr = hydro->nabr[k];
+
+            if (nabr < 0)
+            {
+                hydro->bound[nbound++] = k;
+            }
+            else if (nabr > i)
+            {
+                for (jn = 0; jn < NUM_EDGE; jn++)
+                {
+                    if (hydro->nabr[NUM_EDGE * nabr + jn] == i)
+                    {
+                        break;
+                    }
+                }
+
+                if (jn == NUM_EDGE || hydro->nabr_river[k] !=
+                    hydro->nabr_river[NUM_EDGE * nabr + jn])
+                {
+                    pihm_printf(VL_ERROR,
+                        "Error: Elements %d and %d do not share edge %d.\n",
+                        i + 1, nabr + 1, j + 1);
+                    pihm_exit(EXIT_FAILURE);
+                }
+
+                hydro->face[2 * nface] = k;
+                hydro->face[2 * nface + 1] = NUM_EDGE * nabr + jn;
+
+                /* Geometry of the flux laws */
+                hydro->inv_dist[nface] = 1.0 / hydro->dist_nabr[k];
+                hydro->cond_sub[nface] = hydro->edge[k] / hydro->dist_nabr[k];
+                nface++;
+            }
+        }
+    }
+
+    pihm_printf(VL_VERBOSE,
+        "Lateral flux: %d interfaces, %d boundary edges.\n", hydro->nface,
+        hydro->nbound);
+}
+
+void UpdateHydroLc(const elem_struct elem[], hydro_struct *hydro)
+{
+    /*
+     * Copy land cover parameters, and update the coefficients of the overland
+     * flux law that depend on them. Called at initialization, and whenever the
+     * land cover of an element changes
+     */
+    int             i;
+    int             f;
+
+#if defined(_OPENMP)
+# pragma omp parallel for schedule(static)
+#endif
+    for (i = 0; i < nelem; i++)
+    {
+        hydro->rough[i] = elem[i].lc.rough;
+    }
+
+#if defined(_OPENMP)
+# pragma omp parallel for schedule(static)
+#endif
+    for (f = 0; f < hydro->nface; f++)
+    {
+        int             k;
+        int             i, nabr;
+
+        k = hydro->face[2 * f];
+        i = k / NUM_EDGE;
+        nabr = hydro->face[2 * f + 1] / NUM_EDGE;
+
+        hydro->cond_ovl[f] = hydro->edge[k] /
+            (0.5 * (hydro->rough[i] + hydro->rough[nabr]));
+    }
+}
+
+void FreeHydro(hydro_struct *hydro)
+{
+    free(hydro->surfh);
+    free(hydro->gw);
+    free(hydro->zmin);
+    free(hydro->zmax);
+    free(hydro->rough);
+    free(hydro->ksath);
+    free(hydro->kmac);
+    free(hydro->depth);
+    free(hydro->dmac);
+    free(hydro->nabr);
+    free(hydro->nabr_river);
+    free(hydro->edge);
+    free(hydro->dist_nabr);
+    free(hydro->x_nabr);
+    free(hydro->y_nabr);
+#if defined(_BGC_) || defined(_CYCLES_) || defined(_RT_)
+    free(hydro->avg_smcmax);
+    free(hydro->avg_depth);
+# if defined(_DGW_)
+    free(hydro->avg_smcmax_geol);
+    free(hydro->avg_depth_geol);
+# endif
+#endif
+    free(hydro->face);
+    free(hydro->bound);
+    free(hydro->inv_dist);
+    free(hydro->cond_sub);
+    free(hydro->cond_ovl);
+    free(hydro->qsub);
+    free(hydro->qovl);
+}
+
+void InterfaceFlux(const double sf[], hydro_struct *hydro)
+{
+    /*
+     * Subsurface and overland fluxes of all element-to-element interfaces.
+     * The loop uses selections instead of branches, and no operation in it can
+     * trap for either outcome of a selection, so that it can be vectorized.
+     * This file is compiled without trapping math (see Makefile). Interfaces
+     * are shared among the threads of the parallel region of Ode. Geometry
+     * and roughness enter through coefficients of each interface, which are
+     * computed at initialization
+     */
+    int             f;
+    int             nface;
+    const int      *face;
+    const double   *gw, *surfh;
+    const double   *zmin, *zmax;
+    const double   *depth, *dmac;
+    const double   *ksath, *kmac;
+    const double   *inv_dist;
+    const double   *cond_sub, *cond_ovl;
+    double         *qsub, *qovl;
+
+    /* Arrays are read through local pointers, which the vectorizer does not
+     * need to reload at every face */
+    nface = hydro->nface;
+    face = hydro->face;
+    gw = hydro->gw;
+    surfh = hydro->surfh;
+    zmin = hydro->zmin;
+    zmax = hydro->zmax;
+    depth = hydro->depth;
+    dmac = hydro->dmac;
+    ksath = hydro->ksath;
+    kmac = hydro->kmac;
+    inv_dist = hydro->inv_dist;
+    cond_sub = hydro->cond_sub;
+    cond_ovl = hydro->cond_ovl;
+    qsub = hydro->qsub;
+    qovl = hydro->qovl;
+
+#if defined(_OPENMP)
+# pragma omp for simd schedule(static)
+#endif
+    for (f = 0; f < nface; f++)
+    {
+        int             i, nabr;
+        double          diff_h;
+        double          grad_h;
+        double          h_up, h_up_nabr;
+        double          avg_h, avg_h_nabr;
+        double          effk, effk_nabr;
+        double          avg_sf;
+        double          coeff;
+
+        i = face[2 * f] / NUM_EDGE;
+        nabr = face[2 * f + 1] / NUM_EDGE;
+
+        /*
+         * Subsurface flow between triangular elements
+         */
+        diff_h = (gw[i] + zmin[i]) - (gw[nabr] + zmin[nabr]);
+
+        /* Upstream water depth (see AvgH) */
+        h_up = (diff_h > 0.0) ? gw[i] : gw[nabr];
+        avg_h = MAX(h_up, 0.0);
+
+        /* Take into account macropore effect */
+        effk = HydroEffKh(gw[i], depth[i], dmac[i], kmac[i], ksath[i]);
+        effk_nabr = HydroEffKh(gw[nabr], depth[nabr], dmac[nabr], kmac[nabr],
+            ksath[nabr]);
+
+        /* Groundwater flow modeled by Darcy's Law */
+        qsub[f] = 0.5 * (effk + effk_nabr) * diff_h * avg_h * cond_sub[f];
+
+        /*
+         * Surface flow between triangular elements. Fluxes out of the element
+         * and out of the neighbor use the water depth upstream of the
+         * interface (see AvgHsurf), and only differ in the gradient, which is
+         * raised to GRADMIN on either side. At a level interface each side
+         * takes the water depth of the other
+         */
+        diff_h = (surfh[i] + zmax[i]) - (surfh[nabr] + zmax[nabr]);
+        grad_h = diff_h * inv_dist[f];
+        h_up = (diff_h > 0.0) ? surfh[i] : surfh[nabr];
+        h_up_nabr = (-diff_h > 0.0) ? surfh[nabr] : surfh[i];
+        avg_h = MAX(h_up - DEPRSTG, 0.0);
+        avg_h_nabr = MAX(h_up_nabr - DEPRSTG, 0.0);
+
+        /* avg_sf not needed in kinematic mode */
+        avg_sf = MAX(0.5 * (sf[i] + sf[nabr]), GRADMIN);
+        coeff = cond_ovl[f] / sqrt(avg_sf);
+
+        /* Manning's equation (see OverLandFlow) */
+        qovl[2 * f] = coeff * avg_h * Pow23(avg_h) * MAX(grad_h, GRADMIN);
+        qovl[2 * f + 1] = coeff * avg_h_nabr * Pow23(avg_h_nabr) *
+            MAX(-grad_h, GRADMIN);
+    }
+}
+
+double HydroEffKh(double gw, double depth, double dmac, double kmac,
+    double ksath)
+{
+    /*
+     * EffKh without branches, with the conductivity of the macropore layer
+     * kmac precomputed. Saturated thickness of the macropore layer (d1) and
+     * thickness of the soil below it (d2) weight the two conductivities
+     */
+    double          d1, d2;
+
+    d2 = depth - dmac;
+    d1 = MIN(gw - d2, dmac);
+    d1 = MAX(d1, 0.0);
+
+    return ksath + (kmac - ksath) * d1 / MAX(d1 + d2, DBL_MIN);
+}
+
+double Pow23(double x)
+{
+    /*
+     * x ^ (2 / 3) for x >= 0 without a call to pow, so that loops calling
+     * Manning's equation can be vectorized. The cube root starts from an
+     * estimate built on the bits of x (a third of the exponent, as in cbrt of
+     * fdlibm) and is refined with Newton iterations to double precision.
+     * Arguments below 1E-30 m are treated as zero
+     */
+    unsigned long long bits;
+    double          xc;
+    double          y;
+    int             k;
+
+    xc = MAX(x, 1.0E-30);
+
+    memcpy(&bits, &xc, sizeof(bits));
+
+    /* bits / 3 with shifts and additions */
+    bits = (bits >> 2) + (bits >> 4);
+    bits += bits >> 4;
+    bits += bits >> 8;
+    bits += bits >> 16;
+    bits += 0x2a9f789300000000ULL;
+
+    memcpy(&y, &bits, sizeof(y));
+
+    for (k = 0; k < 4; k++)
+    {
+        y = (2.0 * y + xc / (y * y)) / 3.0;
+    }
+
+    y *= y;
+
+    return (x > 1.0E-30) ? y : 0.0;
+}
@@ -1,27 +1,42 @@
 #include "pihm.h"
 
-void Hydrol(const ctrl_struct *ctrl, elem_struct elem[], river_struct river[])
+void Hydrol(const ctrl_struct *ctrl, scratch_struct scratch[],
+    hydro_struct *hydro, const rivnet_struct *rivnet, elem_struct elem[],
+    river_struct river[])
 {
+    /*
+     * Called by all threads of the parallel region of Ode. Loops over elements
+     * use the static partition of Ode, so loops that only read states of
+     * their own elements do not wait for each other
+     */
     int             i;
 
 #if defined(_OPENMP)
-# pragma omp parallel for
+# pragma omp for schedule(static) nowait
 #endif
     for (i = 0; i < nelem; i++)
     {
         /* Calculate actual surface water depth */
         elem[i].ws.surfh = SurfH(elem[i].ws.surf);
+        hydro->surfh[i] = elem[i].ws.surfh;
     }
 
     /* Determine which layers does ET extract water from */
     EtUptake(elem);
 
     /* Water flow */
-    LateralFlow(river, elem);
+    LateralFlow(river, scratch, hydro, elem);
+
+    /* Infiltration takes overland fluxes of all edges of an element */
+#if defined(_OPENMP)
+# pragma omp barrier
+#endif
 
+    /* Returns after all threads are done, because overland fluxes to river
+     * segments are overwritten by RiverFlow */
     VerticalFlow((double)ctrl->stepsize, elem);
 
-    RiverFlow(elem, river);
+    RiverFlow(rivnet, elem, river);
 }
 
 void EtUptake(elem_struct elem[])
@@ -29,7 +44,7 @@ void EtUptake(elem_struct elem[])
     int             i;
 
 #if defined(_OPENMP)
-# pragma omp parallel for
+# pragma omp for schedule(static) nowait
 #endif
     for (i = 0; i < nelem; i++)
     {
@@ -124,3 +139,32 @@ double SurfH(double surf_eqv)
 
     return surfh;
 }
+
+double DSurfH(double surf_eqv)
+{
+    /* Derivative of actual surface water depth with respect to equivalent
+     * surface water depth (see SurfH) */
+    double          dsurfh;
+
+    if (DEPRSTG == 0.0)
+    {
+        dsurfh = 1.0;
+    }
+    else
+    {
+        if (surf_eqv <= 0.0)
+        {
+            dsurfh = 0.0;
+        }
+        else if (surf_eqv <= 0.5 * DEPRSTG)
+        {
+            dsurfh = sqrt(0.5 * DEPRSTG / surf_eqv);
+        }
+        else
+        {
+            dsurfh = 1.0;
+        }
+    }
+
+    return dsurfh;
+}
@@ -701,7 +701,7 @@ typedef struct bc_struct
                                              * condition (m3 s-1) */
     };
 #if defined(_RT_)
-    double          conc[NUM_EDGE][MAXSPS]; /* value of chemical concentration
+    double         *conc[NUM_EDGE];         /* value of chemical concentration
                                              * boundary condition (mol LH2O-1)*/
 #endif
 } bc_struct;
@@ -1511,29 +1511,31 @@ typedef struct rtic_struct
     double          ssa[MAXSPS];
 } rtic_struct;
 
+/* Species arrays below are sized to the number of species of the simulation
+ * (see InitChmPool) */
 typedef struct prcpchem_struct
 {
-    double          tot_conc[MAXSPS];       /* concentration (mol kgH2O-1) */
+    double         *tot_conc;               /* concentration (mol kgH2O-1) */
 } prcpchem_struct;
 
 typedef struct chmstate_struct
 {
-    double          tot_conc[MAXSPS];       /* concentration (mol kgH2O-1) */
-    double          prim_conc[MAXSPS];      /* primary concentration
+    double         *tot_conc;               /* concentration (mol kgH2O-1) */
+    double         *prim_conc;              /* primary concentration
                                              * (mol kgH2O-1) */
-    double          sec_conc[MAXSPS];       /* secondary concentration
+    double         *sec_conc;               /* secondary concentration
                                              * (mol kgH2O-1) */
-    double          prim_actv[MAXSPS];      /* activity of primary species */
-    double          ssa[MAXSPS];            /* specific surface area (m2 g-1) */
-    double          tot_mol[MAXSPS];        /* total moles (kmol m-2) */
+    double         *prim_actv;              /* activity of primary species */
+    double         *ssa;                    /* specific surface area (m2 g-1) */
+    double         *tot_mol;                /* total moles (kmol m-2) */
 } chmstate_struct;
 
 typedef struct chmflux_struct
 {
-    double          react[MAXSPS];          /* reaction flux in unsaturated zone
+    double         *react;                  /* reaction flux in unsaturated zone
                                              * (mol L-1 s-1) */
 # if defined(_DGW_)
-    double          react_geol[MAXSPS];     /* reaction flux in deep groundwater
+    double         *react_geol;             /* reaction flux in deep groundwater
                                              * (mol L-1 s-1) */
 # endif
 } chmflux_struct;
@@ -1562,11 +1564,11 @@ typedef struct elem_struct
     int             nabr_river[NUM_EDGE];   /* adjacent river channel (0: no
                                              * river on edge i) */
     int             ind;                    /* index */
+    int             id;                     /* ID in input and output files */
     attrib_struct   attrib;
     topo_struct     topo;
     soil_struct     soil;
     lc_struct       lc;
-    ic_struct       ic;
     bc_struct       bc;
     wstate_struct   ws;
     wstate_struct   ws0;
@@ -1574,12 +1576,12 @@ typedef struct elem_struct
     estate_struct   es;
     eflux_struct    ef;
     phystate_struct   ps;
-#if defined(_BGC_) || defined(_CYCLES_) || defined(_RT_)
+#if defined(_RT_)
+    solute_struct  *solute;                 /* one for each primary species */
+#elif defined(_BGC_) || defined(_CYCLES_)
     solute_struct   solute[NSOLUTE];
 #endif
 #if defined(_BGC_)
-    bgcic_struct    restart_input;
-    bgcic_struct    restart_output;
     cstate_struct   cs;
     cflux_struct    cf;
     nstate_struct   ns;
@@ -1594,15 +1596,14 @@ typedef struct elem_struct
 #if defined(_CYCLES_)
     crop_struct     crop[MAXCROP];
     mgmt_struct     mgmt;
-    agic_struct     restart_input;
     weather_struct  weather;
     cstate_struct   cs;
     cflux_struct    cf;
     nstate_struct   ns;
-    nstate_struct   ns0;
     nflux_struct    nf;
 #endif
-    epconst_struct  epc;
+    const epconst_struct *epc;              /* ecophysiological constants of
+                                             * the land cover type */
 #if defined(_DAILY_)
     daily_struct    daily;
 #endif
@@ -1611,8 +1612,6 @@ typedef struct elem_struct
     bc_struct       bc_geol;
 #endif
 #if defined(_RT_)
-    rtic_struct     restart_input[NCHMVOL];
-    rtic_struct     restart_output[NCHMVOL];
     prcpchem_struct prcpchm;
     chmstate_struct chms;
 # if defined(_DGW_)
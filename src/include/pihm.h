@@ -16,12 +16,15 @@
 # include <io.h>
 #else
 # include <unistd.h>
+# include <fcntl.h>
+# include <sys/mman.h>
 #endif
 #if defined(unix) || defined(__unix__) || defined(__unix)
 # include <fenv.h>
 #endif
 #if defined(_OPENMP)
 # include <omp.h>
+# include <pthread.h>
 #endif
 
 #define VERSION    "1.0.0-rc2"
@@ -32,8 +35,19 @@
 /* Prototypes for CVODE fcts., consts. */
 #include "cvode/cvode.h"
 
-/* Access to SPGMR SUNLinearSolver */
+/* Access to Krylov SUNLinearSolvers */
 #include "sunlinsol/sunlinsol_spgmr.h"
+#include "sunlinsol/sunlinsol_spfgmr.h"
+#include "sunlinsol/sunlinsol_spbcgs.h"
+#include "sunlinsol/sunlinsol_sptfqmr.h"
+#include "sunlinsol/sunlinsol_pcg.h"
+
+/* Access to SUNNonlinearSolvers */
+#include "sunnonlinsol/sunnonlinsol_newton.h"
+#include "sunnonlinsol/sunnonlinsol_fixedpoint.h"
+
+/* Access to sparse SUNMatrix */
+#include "sunmatrix/sunmatrix_sparse.h"
 
 /* Access to N_Vector */
 #if defined(_CVODE_OMP)
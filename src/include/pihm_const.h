@@ -49,9 +49,63 @@
 #define CN_STEP                 2
 #define RT_STEP                 3
 
+/* Layouts of output variables */
+#define MISC_VAR                0           /* other variables */
+#define ELEM_VAR                1           /* one value per element */
+#define RIVER_VAR               2           /* one value per river segment */
+
+/* Element loops with cost-aware schedules */
+#define LSM_SCHED               0           /* land surface (Noah) loop */
+#define REACT_SCHED             1           /* reaction loop */
+#define BGC_SCHED               2           /* daily BGC loop */
+#define CYCLES_SCHED            3           /* daily Cycles loop */
+#define NUM_SCHED               4
+#define SCHED_INTVL             10          /* number of calls between two
+                                             * refreshes of a schedule */
+
+/* Tasks of a PIHM step, in program order */
+#define BC_TASK                 0           /* boundary conditions */
+#define FORC_TASK               1           /* meteorological forcing */
+#define LSM_TASK                2           /* land surface processes */
+#define REACT_TASK              3           /* reaction */
+#define CYCLES_TASK             4           /* daily Cycles processes */
+#define ODE_TASK                5           /* hydrology ODE */
+#define HYDROL_TASK             6           /* updates after the ODE */
+#define DAILY_TASK              7           /* daily averages and BGC */
+#define WATBAL_TASK             8           /* water balance output */
+#define OUTPUT_TASK             9           /* model variable output */
+#define NUM_TASK                10
+
+/* Data read or written by the tasks of a PIHM step */
+#define BC_DATA                 0x01        /* boundary conditions */
+#define MET_DATA                0x02        /* meteorological forcing */
+#define LSM_DATA                0x04        /* land surface states and fluxes */
+#define SOLUTE_DATA             0x08        /* solute states and fluxes */
+#define HYDROL_DATA             0x10        /* hydrologic states and fluxes */
+#define DAILY_DATA              0x20        /* daily averages and CN states */
+#define PRINT_DATA              0x40        /* print buffers and output files */
+#define WATBAL_DATA             0x80        /* water balance file */
+
 /* Maximum number of output files */
 #define MAXPRINT                1024
 
+/* Model variable output */
+#define OUTBLOCK_SIZE           65536       /* bytes of an output block */
+#define FLUSH_OUTPUT            0           /* write output blocks at every
+                                             * output time */
+#define FLUSH_CHECKPOINT        1           /* write output blocks when restart
+                                             * files are written */
+#define FLUSH_FULL              2           /* write output blocks when they
+                                             * are full */
+#define DAT_FORMAT              0           /* one .dat file per variable */
+#define CONTAINER_FORMAT        1           /* one output container file */
+#define OUTFILE_MAGIC           "PIHMOUT"   /* first bytes of an output
+                                             * container */
+#define OUTFILE_VERSION         1           /* output container format version
+                                             */
+#define MAXOUTNAME              64          /* maximum length of variable names
+                                             * in output containers */
+
 /* Meteorological forcing related */
 #define NUM_METEO_VAR           7           /* number of meteorological forcing
                                              * variables */
@@ -67,6 +121,13 @@
 #define PRES_TS                 6           /* index of surface pressure forcing
                                              */
 
+/* Binary forcing files */
+#define BINFORC_MAGIC           "PIHMFORC"  /* first bytes of a binary forcing
+                                             * file */
+#define BINFORC_VERSION         1           /* binary forcing format version */
+#define MAXBINFORC              5           /* maximum number of mapped binary
+                                             * forcing files */
+
 /* Radiation forcing variables */
 #define UNIF_SOL                0           /* use global solar radiation */
 #define TOPO_SOL                1           /* use topographic solar radiation*/
@@ -198,6 +259,52 @@
 #define KINEMATIC               1
 #define DIFF_WAVE               2
 
+/* Number of hydrologic state variables of an element */
+#if defined(_DGW_)
+# define NUM_ELEM_HYDROL        5
+#else
+# define NUM_ELEM_HYDROL        3
+#endif
+
+/* Linear solver type */
+#define ITERATIVE_LS            0
+#define SPARSE_LS               1
+
+/* Krylov method of the iterative linear solver */
+#define KRYLOV_SPGMR            0
+#define KRYLOV_SPFGMR           1
+#define KRYLOV_SPBCGS           2
+#define KRYLOV_SPTFQMR          3
+#define KRYLOV_PCG              4
+
+/* Integration method and nonlinear solver */
+#define BDF_NEWTON              0
+#define ADAMS_FIXEDPT           1
+#define AUTO_NLS                2
+
+/* Attached nonlinear solver */
+#define NEWTON_NLS              0
+#define FIXEDPT_NLS             1
+
+/* Number of consecutive non-stiff model steps before switching to the
+ * fixed-point solver */
+#define NLS_SWITCH_STEPS        10
+
+/* Root functions of each element */
+#define PONDING_EVENT           0
+#define MACROPORE_EVENT         1
+#define SATURATION_EVENT        2
+#define NUM_ELEM_EVENT          3
+
+/* Sparse Jacobian type */
+#define ANALYTIC_JAC            0
+#define COLOR_FD_JAC            1
+
+/* Element and river renumbering */
+#define NO_RENUMBER             0
+#define RCM_RENUMBER            1
+#define HILBERT_RENUMBER        2
+
 /* Initialization type */
 #define RELAX                   0
 #define RST_FILE                1
@@ -299,6 +406,9 @@
 #define KIN_REACTION            0
 #define TRANSPORT_ONLY          1
 
+/* RT speciation step (s) */
+#define SPECIATION_STEP         3600
+
 /* RT primary species types */
 #define AQUEOUS                 1
 #define ADSORPTION              2
@@ -501,15 +611,18 @@ extern int     append_mode;
 extern int     corr_mode;
 extern int     spinup_mode;
 extern int     fixed_length;
+extern int     bench_rhs;
+extern int     check_mode;
+extern int     trace_mode;
+extern int     mem_report;
+extern int     convert_mode;
 extern char    project[MAXSTRING];
 extern int     nelem;
 extern int     nriver;
 #if defined(_BGC_)
 extern int     first_balance;
 #endif
-#if defined(_OPENMP)
 extern int     nthreads;
-#endif
 #if defined(_BGC_) || defined(_CYCLES_) || defined(_RT_)
 int            nsolute;
 #endif
@@ -86,7 +86,10 @@ int             feenableexcept(int);
 void            _InitLc(const lctbl_struct *, const calib_struct *,
     elem_struct *);
 double          _WsAreaElev(int, const elem_struct *);
-void            AdjCVodeMaxStep(void *, ctrl_struct *);
+void            AdjCVodeMaxStep(void *, const cvstats_struct *, nls_struct *,
+    ctrl_struct *);
+void            AppendOutput(const void *, size_t, int, outblock_struct **,
+    outwriter_struct *);
 #if defined(_RT_)
 void            ApplyBc(int, const rttbl_struct *, forc_struct *,
     elem_struct [], river_struct []);
@@ -120,10 +123,20 @@ void            ApplyMeteoForcing(int, int, const siteinfo_struct *,
 void            ApplyMeteoForcing(int, forc_struct *, elem_struct []);
 #endif
 void            ApplyRiverBc(int, forc_struct *, river_struct []);
+void            ArmEvents(event_struct *);
+void            AttachNonlinSolver(void *, int, nls_struct *);
 double          AvgKv(double, double, const soil_struct *);
 double          AvgH(double, double, double);
+int             AddElemCols(int, int, sunindextype [], int);
+int             AddIndex(sunindextype, sunindextype [], int);
+int             AddRiverCols(int, int, sunindextype [], int);
+void            AddSparseEntry(sunindextype, sunindextype, double, SUNMatrix);
 double          AvgHsurf(double, double, double);
 void            BackupInput(const char [], const filename_struct *);
+double          BankFlux(const river_struct *, double, elem_struct *);
+void            BenchRhs(int, pihm_struct, N_Vector);
+void            BeginTask(int, int, taskgraph_struct *);
+size_t          BinTsSize(int, int);
 void            BoundFluxElem(int, int, const topo_struct *,
     const soil_struct *, const bc_struct *, const wstate_struct *,
     wflux_struct *);
@@ -136,38 +149,105 @@ double          ChannelFlowElemToRiver(double, double, const river_struct *,
 double          ChannelFlowRiverToRiver(const river_struct *,
     const river_struct *);
 void            CheckCVodeFlag(int);
+void            CheckFluxKernels(void);
 int             CheckHeader(const char [], int , ...);
 #if defined(_BGC_)
 int             CheckSteadyState(int, int, int, double, const elem_struct []);
 #else
 int             CheckSteadyState(int, int, double, const elem_struct []);
 #endif
+double         *ChunkRecord(int, int, int, int, outblock_struct **,
+    outwriter_struct *);
+int             ColorJac(realtype, N_Vector, N_Vector, SUNMatrix, void *,
+    N_Vector, N_Vector, N_Vector);
+int             ColorRowPattern(sunindextype, const elem_struct [],
+    const river_struct [], const rivnet_struct *, sunindextype []);
+int             CompareKey(const void *, const void *);
+void            ConvertForcing(const pihm_struct);
 void            CorrectElev(const river_struct [], elem_struct []);
 void            CreateOutputDir(char []);
+double          DBoundFluxElem(int, int, const topo_struct *,
+    const soil_struct *, const bc_struct *, const wstate_struct *);
+void            DChannelFlowElemToRiver(double, double, double,
+    const river_struct *, const elem_struct *, double []);
+void            DChannelFlowRiverToRiver(const river_struct *,
+    const river_struct *, double []);
+double          DEffKh(double, const soil_struct *);
 double          DhByDl(const double [], const double [], const double []);
+void            DOvlFlowElemToElem(int, double, const elem_struct *,
+    const elem_struct *, double []);
+void            DOvlFlowElemToRiver(const river_struct *, const elem_struct *,
+    double []);
+double          DRiverCrossSectArea(int, double, double);
+double          DRiverPerim(int, double, double);
+void            DSubsurfFlow(int, const elem_struct *, const elem_struct *,
+    double []);
+double          DSurfH(double);
 double          EffKh(double, const soil_struct *);
 double          EffKinf(double, double, double, double, double,
     const soil_struct *);
 double          EffKv(const soil_struct *, double, int);
+void            ElemHilbertOrder(const meshtbl_struct *, int []);
+void            ElemRcmOrder(const meshtbl_struct *, int []);
+void            ElemVertJac(double, double, const elem_struct *,
+    double [][NUM_ELEM_HYDROL]);
+void            ElemVertRhs(double, const elem_struct *, const double [],
+    double []);
+void            EndTask(int, taskgraph_struct *);
 void            EtUptake(elem_struct []);
+int             EventRoot(realtype, N_Vector, realtype *, void *);
 double          FieldCapacity(double, double, double, double);
+void            FlushBlock(outblock_struct **, outwriter_struct *);
+int             FlushNow(int, const ctrl_struct *);
 void            FreeAtttbl(atttbl_struct *);
+void            FreeColorJac(colorjac_struct *);
 void            FreeCtrl(ctrl_struct *);
+void            FreeEvent(event_struct *);
 void            FreeForc(forc_struct *);
+void            FreeForcStream(forc_struct *);
+void            FreeHydro(hydro_struct *);
+void            FreeInit(init_struct *);
+void            FreeJacTimes(jtimes_struct *);
+void            FreeScratch(scratch_struct []);
 void            FreeLctbl(lctbl_struct *);
 void            FreeMatltbl(matltbl_struct *);
 void            FreeMeshtbl(meshtbl_struct *);
+void            FreePrecond(prec_struct *);
 void            FreeMem(pihm_struct);
+void            FreeOutputWriter(int, print_struct *);
+void            FreeRiverNet(rivnet_struct *);
 void            FreeRivtbl(rivtbl_struct *);
+void            FreeSched(sched_struct []);
 void            FreeShptbl(shptbl_struct *);
 void            FreeSoiltbl(soiltbl_struct *);
-void            FrictionSlope(const elem_struct [], const river_struct [],
+void            FreeTaskGraph(taskgraph_struct *);
+void            FreeTs(tsdata_struct *);
+void            FrictionSlope(const hydro_struct *, const river_struct [],
     double [], double []);
-void            Hydrol(const ctrl_struct *, elem_struct [], river_struct []);
+outblock_struct *GetBlock(int, outwriter_struct *);
+void            GetCVodeStats(void *, const nls_struct *, const event_struct *,
+    cvstats_struct *);
+unsigned long long HilbertDist(unsigned int, unsigned int);
+#if defined(_OPENMP)
+# pragma omp declare simd notinbranch
+#endif
+double          HydroEffKh(double, double, double, double, double);
+void            Hydrol(const ctrl_struct *, scratch_struct [], hydro_struct *,
+    const rivnet_struct *, elem_struct [], river_struct []);
 double          Infil(double, const topo_struct *, const soil_struct *,
     const wstate_struct *, const wstate_struct *, const wflux_struct *);
+void            InitColorJac(SUNMatrix, colorjac_struct *);
 void            InitEFlux(eflux_struct *);
+#if defined(_NOAH_)
+void            InitEpc(int, const lctbl_struct *, const calib_struct *,
+    epconst_struct *);
+#else
+void            InitEpc(int, const lctbl_struct *, epconst_struct *);
+#endif
+void            InitEvent(void *, const ctrl_struct *, event_struct *);
 void            InitEState(estate_struct *);
+void            InitFaces(hydro_struct *);
+void            InitForcStream(double, forc_struct *);
 #if defined(_RT_)
 void            InitForcing(const rttbl_struct *, const calib_struct *,
     forc_struct *, elem_struct []);
@@ -175,23 +255,33 @@ void            InitForcing(const rttbl_struct *, const calib_struct *,
 void            InitForcing(const calib_struct *, forc_struct *,
     elem_struct []);
 #endif
+void            InitHydro(const elem_struct [], hydro_struct *);
 void            Initialize(pihm_struct, N_Vector, void **);
-void            InitLc(const lctbl_struct *, const calib_struct *,
-    elem_struct []);
+int             IsAsyncTask(int);
+void            IssueTask(int, int, int, taskgraph_struct *);
+void            InitJacTimes(jtimes_struct *);
+void            InitLc(lctbl_struct *, const calib_struct *, elem_struct []);
+void            InitNonlinSolver(N_Vector, void *, const ctrl_struct *,
+    nls_struct *);
 void            InitMesh(const meshtbl_struct *, elem_struct []);
 #if defined(_LUMPED_) && defined(_RT_)
-void            InitOutputFiles(const char [], int, int, const chemtbl_struct [],
-    const rttbl_struct *, print_struct *);
+void            InitOutputFiles(const char [], int, int, int,
+    const chemtbl_struct [], const rttbl_struct *, print_struct *);
 #else
-void            InitOutputFiles(const char [], int, int, print_struct *);
+void            InitOutputFiles(const char [], int, int, int, print_struct *);
 #endif
-void            InitPrintCtrl(const char [], const char [], int, int, int,
+void            InitOutputContainer(const char [], print_struct *);
+void            InitOutputWriter(int, print_struct *);
+void            InitPrecond(prec_struct *);
+void            InitPrintCtrl(const char [], const char [], int, int, int, int,
     varctrl_struct *);
 void            InitRiver(const meshtbl_struct *, const rivtbl_struct *,
     const shptbl_struct *, const matltbl_struct *, const calib_struct *,
     elem_struct [], river_struct []);
+void            InitRiverNet(const river_struct [], rivnet_struct *);
 void            InitRiverWFlux(river_wflux_struct *);
 void            InitRiverWState(river_wstate_struct *);
+void            InitSched(sched_struct []);
 #if defined(_NOAH_)
 void            InitSoil(const soiltbl_struct *, const noahtbl_struct *,
     const calib_struct *, elem_struct []);
@@ -200,15 +290,30 @@ void            InitSoil(const soiltbl_struct *, const calib_struct *,
     elem_struct []);
 #endif
 void            InitSurfL(const meshtbl_struct *, elem_struct []);
+void            InitTaskGraph(const char [], pihm_struct, taskgraph_struct *);
 void            InitTopo(const meshtbl_struct *, elem_struct []);
-void            InitVar(elem_struct [], river_struct [], N_Vector);
+void            InitTsAxis(int, tsdata_struct []);
+void            InitVar(const init_struct *, elem_struct [], river_struct [],
+    N_Vector);
 void            InitWbFile(char *, char *, FILE *);
 void            InitWFlux(wflux_struct *);
 void            InitWState(wstate_struct *);
-void            IntcpSnowEt(int, double, const calib_struct *, elem_struct []);
+void            InterfaceFlux(const double [], hydro_struct *);
+void            IntcpSnowEt(int, double, elem_struct []);
 void            IntrplForcing(int, int, int, tsdata_struct *);
+void            IntrplForcingSet(int, int, int, int, tsdata_struct []);
+void            IntrplTs(int, int, const tsdata_struct *, tsdata_struct *);
+int             JacTimesSetup(realtype, N_Vector, N_Vector, void *);
+int             JacTimesVec(N_Vector, N_Vector, realtype, N_Vector, N_Vector,
+    void *, N_Vector);
+int             KernelError(const char [], int, double, double, double *);
 double          KrFunc(double, double);
-void            LateralFlow(const river_struct [], elem_struct []);
+void            LateralFlow(const river_struct [], scratch_struct [],
+    hydro_struct *, elem_struct []);
+void            LocateForcing(int, tsdata_struct *);
+void            MaskSparseCols(const double [], SUNMatrix);
+int             MapForcing(const char [], int, int *, tsdata_struct **,
+    forc_struct *);
 #if defined(_CYCLES_)
 void            MapOutput(const char [], const int [], const crop_struct [],
     const elem_struct [], const river_struct [], print_struct *);
@@ -220,6 +325,8 @@ void            MapOutput(const char [], const int [], const chemtbl_struct [],
 void            MapOutput(const char [], const int [], const elem_struct [],
     const river_struct [],  print_struct *);
 #endif
+void            MapOutputIds(const elem_struct [], const river_struct [],
+    print_struct *);
 #if defined(_DGW_)
 void            AdjustFluxes(double, double, const soil_struct *,
     const soil_struct *, const wstate_struct *, const wstate_struct *,
@@ -231,8 +338,25 @@ void            AdjustFluxes(double, double, const soil_struct *,
 double          MonthlyLai(int, int);
 double          MonthlyMf(int);
 double          MonthlyRl(int, int);
+void            NabrIndexDist(const meshtbl_struct *, int *, double *);
+outblock_struct *NewBlock(outwriter_struct *);
+void            NewInit(init_struct *);
+SUNLinearSolver NewKrylov(N_Vector, const ctrl_struct *);
+#if defined(_RT_)
+scratch_struct *NewScratch(const rttbl_struct *);
+#else
+scratch_struct *NewScratch(void);
+#endif
+void            NewTs(int, int, tsdata_struct *);
+SUNLinearSolver NewSparseLu(sunindextype);
+int             NextBreakpoint(int, const ctrl_struct *, forc_struct *);
+int             NextForcingTime(int, int, const tsdata_struct *);
+int             NextPrintTime(int, int, int, int);
+int             NextStep(pihm_struct);
+long int        NumNonlinIters(void *, const nls_struct *);
 int             NumStateVar(void);
 int             Ode(realtype, N_Vector, N_Vector, void *);
+void           *OutputWriter(void *);
 double          OutletFlux(int, const river_topo_struct *, const shp_struct *,
     const matl_struct *, const river_bc_struct *, const river_wstate_struct *);
 double          OverLandFlow(double, double, double, double, double);
@@ -240,18 +364,36 @@ double          OvlFlowElemToElem(int, double, const elem_struct *,
     const elem_struct *);
 double          OvlFlowElemToRiver(const river_struct *, elem_struct *);
 void            ParseCmdLineParam(int, char *[], char []);
+void            PermuteInt(int, const int [], int []);
+void            PermuteIntPtr(int, const int [], int *[]);
 void            PIHM(double, pihm_struct, void *, N_Vector);
 pihm_t_struct   PIHMTime(int);
-void            PrintCVodeFinalStats(void *);
-void            PrintData(int, int, int, int, varctrl_struct *);
+#if defined(_OPENMP)
+# pragma omp declare simd notinbranch
+#endif
+double          Pow23(double);
+#if defined(_OPENMP)
+void           *Prefetch(void *);
+#endif
+int             PrecSetup(realtype, N_Vector, N_Vector, booleantype,
+    booleantype *, realtype, void *);
+int             PrecSolve(realtype, N_Vector, N_Vector, N_Vector, N_Vector,
+    realtype, realtype, int, void *);
+void            PrintCVodeFinalStats(const cvstats_struct *,
+    const nls_struct *);
+void            PrintData(int, int, int, int, print_struct *);
 void            PrintInit(const char [], int, int, int, int,
     const elem_struct [], const river_struct []);
+void            PrintMemReport(const pihm_struct);
 int             PrintNow(int, int, pihm_t_struct);
-void            PrintPerf(int, int, double, double, double, FILE *, void *);
+void            PrintPerf(int, int, double, double, double,
+    const colorjac_struct *, const cvstats_struct *, FILE *);
 void            PrintWaterBalance(int, int, int, const elem_struct [],
     const river_struct [], FILE *);
 void            ProgressBar(double);
 double          Psi(double, double, double);
+void            QueueBlock(outblock_struct *, outwriter_struct *);
+void            QueuePrefetch(int, tsdata_struct *);
 double          PtfAlpha(double, double, double, double, int);
 double          PtfBeta(double, double, double, double, int);
 double          PtfKv(double, double, double, double, int);
@@ -266,9 +408,11 @@ void            ReadBc(const char [], const atttbl_struct *,
 #else
 void            ReadBc(const char [], const atttbl_struct *, forc_struct *);
 #endif
+void            ReadBlock(int, int, tsdata_struct *);
 void            ReadCalib(const char [], calib_struct *);
 void            ReadMeteo(const char [], forc_struct *);
-void            ReadIc(const char [], elem_struct [], river_struct []);
+void            ReadIc(const char [], const elem_struct [],
+    const river_struct [], init_struct *);
 int             ReadKeyword(const char [], const char [], char, const char [],
     int, void *);
 void            ReadLai(const char [], const atttbl_struct *, forc_struct *);
@@ -279,40 +423,97 @@ int             ReadPrintCtrl(const char [], const char [], const char [], int);
 void            ReadRiver(const char [], rivtbl_struct *, shptbl_struct *,
     matltbl_struct *, forc_struct *);
 void            ReadSoil(const char [], soiltbl_struct *);
+int             ReadSolverKeyword(const char [], const char [], int,
+    ctrl_struct *);
 int             ReadTs(const char [], int, int *, double *);
 double          Recharge(const soil_struct *, const wstate_struct *,
     const wflux_struct *);
 double          RiverCrossSectArea(int, double, double);
 double          RiverEqWid(int, double, double);
-void            RiverFlow(elem_struct [], river_struct []);
+void            RiverFlow(const rivnet_struct *, elem_struct [],
+    river_struct []);
+void            RiverOrder(const rivtbl_struct *, const int [], int []);
 double          RiverPerim(int, double, double);
 void            RiverToElem(river_struct *, elem_struct *, elem_struct *);
+double          RiverStrgRhs(double, const river_struct *, elem_struct [],
+    const river_struct []);
 int             roundi(double);
 #if defined(_OPENMP)
 void            RunTime(double, double *, double *);
 #else
 void            RunTime (clock_t, double *, double *);
 #endif
-void            RelaxIc(elem_struct [], river_struct []);
+void            RcmOrder(sunindextype, const sunindextype [],
+    const sunindextype [], sunindextype []);
+void            RearmEvents(realtype, N_Vector, void *, event_struct *);
+void            RelaxIc(const elem_struct [], init_struct *);
+void            ReleaseBlock(outblock_struct *, outwriter_struct *);
+void            Renumber(pihm_struct);
+void            RestartAtEvent(realtype, int, N_Vector, void *, event_struct *);
+void            RestartCVode(realtype, N_Vector, void *, event_struct *);
+double         *ScratchAlloc(size_t, scratch_struct *);
+void            ScratchRelease(const double *, scratch_struct *);
+void            SeekStream(int, tsdata_struct *);
 void            SetCVodeParam(pihm_struct, void *, SUNLinearSolver *, N_Vector);
 int             SoilTex(double, double);
-void            SolveCVode(double, const ctrl_struct *, int *, void *,
-    N_Vector);
+void            SolveCVode(double, const ctrl_struct *, event_struct *, int *,
+    void *, N_Vector);
+int             SortIndex(int, sunindextype []);
+int             SparseJac(realtype, N_Vector, N_Vector, SUNMatrix, void *,
+    N_Vector, N_Vector, N_Vector);
+SUNMatrix       SparseJacPattern(int, const elem_struct [],
+    const river_struct [], const rivnet_struct *);
+void            SparseLuAnalyze(sparselu_struct *, const sunindextype [],
+    const sunindextype []);
+int             SparseLuFree(SUNLinearSolver);
+SUNLinearSolver_Type SparseLuGetType(SUNLinearSolver);
+int             SparseLuInitialize(SUNLinearSolver);
+long int        SparseLuLastFlag(SUNLinearSolver);
+int             SparseLuSetup(SUNLinearSolver, SUNMatrix);
+int             SparseLuSolve(SUNLinearSolver, SUNMatrix, N_Vector, N_Vector,
+    realtype);
+void            RunTask(int, taskgraph_struct *);
+void            SchedRecord(int, double, sched_struct *);
+int             SparseLuSpace(SUNLinearSolver, long int *, long int *);
+int             SparseRowPattern(sunindextype, const elem_struct [],
+    const river_struct [], const rivnet_struct *, sunindextype []);
 void            Spinup(pihm_struct, N_Vector, void *, SUNLinearSolver *);
 void            StartupScreen(void);
 int             StrTime(const char []);
 double          SubsurfFlow(int, const elem_struct *, const elem_struct *);
+void            SwitchNonlinSolver(void *, double, double, const ctrl_struct *,
+    nls_struct *);
+#if defined(_OPENMP)
+void           *TaskHelper(void *);
+#endif
+int             TaskConflicts(int);
+scratch_struct *ThreadScratch(scratch_struct []);
+void            TraceTask(int, const char [], double, taskgraph_struct *);
+void            UnmapForcing(forc_struct *);
+void            UpdateHydroLc(const elem_struct [], hydro_struct *);
+void            UpdateSched(int, int, sched_struct [], FILE *);
 void            UpdateVar(double, elem_struct [], river_struct [], N_Vector);
 double          SurfH(double);
-void            UpdatePrintVar(int, int, varctrl_struct *);
+void            UpdatePrintVar(int, int, int, varctrl_struct *);
 void            UpdPrintVarT(varctrl_struct *, int);
+int             VaryingForcing(int, int, tsdata_struct []);
 void            VerticalFlow(double, elem_struct []);
+void            WaitConflicts(int, taskgraph_struct *);
+void            WaitPrefetch(tsstream_struct *);
+void            WaitTasks(taskgraph_struct *);
+double          WallClock(void);
 double          WiltingPoint(double, double, double, double);
+void            WriteBinForcing(const char [], int, const tsdata_struct []);
+void            WriteBlock(const outblock_struct *);
 
 /*
  * DGW functions
  */
 #if defined(_DGW_)
+double          DDeepBoundFluxElem(int, int, const topo_struct *,
+    const soil_struct *, const bc_struct *, const wstate_struct *);
+void            DDeepFlowElemToElem(double, double, const elem_struct *,
+    const elem_struct *, double []);
 double          DeepBoundFluxElem(int, int, const topo_struct *,
     const soil_struct *, const bc_struct *, const wstate_struct *);
 double          DeepFlowElemToElem(double, double, const elem_struct *,
@@ -374,8 +575,8 @@ void            IcePac(int, double, double, double, double,
 void            InitLsm(const char [], const ctrl_struct *,
     const noahtbl_struct *, const calib_struct *, elem_struct []);
 double          Mod(double, double);
-void            Noah(double, const lctbl_struct *, const calib_struct *,
-    elem_struct []);
+int             Noah(double, const lctbl_struct *, const calib_struct *,
+    sched_struct *, elem_struct []);
 void            NoahHydrol(double, elem_struct []);
 # if defined(_CYCLES_)
 void            NoPac(double, double, const soil_struct *, const lc_struct *,
@@ -415,7 +616,7 @@ void            SFlx(double, const weather_struct *, const cstate_struct *,
     soil_struct *, lc_struct *, crop_struct [], phystate_struct *,
     wstate_struct *, wflux_struct *, estate_struct *, eflux_struct *);
 # else
-void            SFlx(double, soil_struct *, lc_struct *, epconst_struct *,
+void            SFlx(double, soil_struct *, lc_struct *, const epconst_struct *,
     phystate_struct *, wstate_struct *, wflux_struct *, estate_struct *,
     eflux_struct *);
 # endif
@@ -479,8 +680,8 @@ void            RiverElemSoluteFlow(int, int, int, elem_struct *,
 # else
 void            RiverElemSoluteFlow(int, int, elem_struct *, river_struct *);
 # endif
-void            SoluteTranspt(double, double, double, elem_struct [],
-                    river_struct []);
+void            SoluteTranspt(double, double, double, const hydro_struct *,
+                    const rivnet_struct *, elem_struct [], river_struct []);
 #endif
 
 #if defined(_BGC_)
@@ -506,8 +707,8 @@ void            Decomp(double, const epconst_struct *, const cstate_struct *,
     ntemp_struct *);
 void            EvergreenPhenology(const epconst_struct *,
     const cstate_struct *, epvar_struct *);
-void            FirstDay(const cninit_struct *, elem_struct [],
-    river_struct []);
+void            FirstDay(const cninit_struct *, const elem_struct [],
+    init_struct *);
 void            FRootLitFall(double, const epconst_struct *, cflux_struct *,
     nflux_struct *);
 void            FreeEpctbl(epctbl_struct *);
@@ -515,8 +716,9 @@ double          GetCO2(int, tsdata_struct *);
 double          GetNdep(int, tsdata_struct *);
 void            GrowthResp(const epconst_struct *, cflux_struct *);
 void            InitBgc(const epctbl_struct *, const calib_struct *,
-    elem_struct []);
-void            InitBgcVar(elem_struct [], river_struct [], N_Vector);
+    const elem_struct [], lctbl_struct *);
+void            InitBgcVar(const init_struct *, elem_struct [], river_struct [],
+    N_Vector);
 void            LeafLitFall(double, const epconst_struct *, cflux_struct *,
     nflux_struct *);
 void            LivewoodTurnover(const epconst_struct *, const cstate_struct *,
@@ -551,7 +753,8 @@ void            RadTrans(const cstate_struct *, const epconst_struct *,
 void            ReadAnnualFile(const char [], tsdata_struct *);
 void            ReadBgc(const char [], char [], char [], ctrl_struct *,
     co2control_struct *, ndepcontrol_struct *, cninit_struct *);
-void            ReadBgcIc(const char [], elem_struct [], river_struct []);
+void            ReadBgcIc(const char [], const elem_struct [],
+    const river_struct [], init_struct *);
 void            ReadEpc(epctbl_struct *);
 void            ResetSpinupStat(elem_struct []);
 void            RestartInput(const bgcic_struct *, epvar_struct *,
@@ -609,7 +812,7 @@ void            CropNUptake(int, double, double, const double [],
     const phystate_struct *, double [], double [], crop_struct [],
     nstate_struct *, nflux_struct *);
 void            CropStage(int, crop_struct []);
-void            Cycles(int, elem_struct []);
+void            Cycles(int, sched_struct *, elem_struct []);
 void            DailyOper(int, int, int, weather_struct *,
     mgmt_struct *, crop_struct [], soil_struct *, wstate_struct *,
     wflux_struct *, estate_struct *, cstate_struct *, cflux_struct *,
@@ -635,7 +838,7 @@ double          FindIrrigVolume(int, double, const soil_struct *,
     const wstate_struct *, const wflux_struct *, const phystate_struct *);
 int             FinalHarvestDate(int, double, double, double);
 void            FirstDay(const soiltbl_struct *, const ctrl_struct *,
-    elem_struct []);
+    const elem_struct [], agic_struct []);
 void            FirstDOY(int, const cstate_struct *, mgmt_struct *);
 void            FixedHarvest(int, int, const tillage_struct *,
     const phystate_struct *, crop_struct [], wstate_struct *, cstate_struct *,
@@ -652,7 +855,8 @@ void            GrowingCrop(int, int, int, const soil_struct *,
     const weather_struct *, crop_struct [], wstate_struct *,
     wflux_struct *, cstate_struct *, nstate_struct *, nflux_struct *,
     phystate_struct *);
-void            InitAgVar(elem_struct [], river_struct [], N_Vector);
+void            InitAgVar(const agic_struct [], elem_struct [], river_struct [],
+    N_Vector);
 void            InitCropStateVar(crop_struct *);
 void            InitCycles(const calib_struct *, const agtbl_struct *,
     const mgmt_struct [], const crop_struct [], const soiltbl_struct *,
@@ -699,7 +903,8 @@ double          Profile(int, const double []);
 void            RadIntcp(crop_struct []);
 void            ReadCrop(const char [], crop_struct []);
 void            ReadCyclesCtrl(const char [], agtbl_struct *, ctrl_struct *);
-void            ReadCyclesIc(const char [], elem_struct []);
+void            ReadCyclesIc(const char [], const elem_struct [],
+    agic_struct []);
 void            ReadMultOper(const agtbl_struct *, mgmt_struct [],
     crop_struct []);
 void            ReadOper(const char [], int, int, mgmt_struct *,
@@ -761,19 +966,27 @@ void            NRT(double, double, double [], const soil_struct *,
 #if defined(_RT_)
 void            InitChem(const char [], const calib_struct *, forc_struct *forc,
     chemtbl_struct [], kintbl_struct [], rttbl_struct *, chmictbl_struct *,
-    elem_struct []);
+    const elem_struct [], rtic_struct []);
+void            InitChmPool(const rttbl_struct *, elem_struct [], river_struct [],
+    chmpool_struct *);
+int             ChmStateSize(const rttbl_struct *);
+double         *CarveChmState(const rttbl_struct *, double *,
+    chmstate_struct *);
+int             ElemChmSize(const rttbl_struct *);
+void            FreeChmPool(chmpool_struct *);
 void            Reaction(double, const chemtbl_struct [], const kintbl_struct [],
-    const rttbl_struct *, elem_struct []);
+    const rttbl_struct *, scratch_struct [], sched_struct *, elem_struct []);
 int             _React(double, const chemtbl_struct [], const kintbl_struct [],
-    const rttbl_struct *, double, double, chmstate_struct *);
+    const rttbl_struct *, double, double, realtype **, chmstate_struct *);
 void            ReactControl(const chemtbl_struct [], const kintbl_struct [],
-    const rttbl_struct *, double, double, double, chmstate_struct *, double []);
+    const rttbl_struct *, double, double, double, realtype **,
+    chmstate_struct *, double []);
 void            Lookup(FILE *, const calib_struct *, chemtbl_struct [],
     kintbl_struct [], rttbl_struct *);
 void            Speciation(const chemtbl_struct [], const rttbl_struct *,
-    river_struct []);
+    scratch_struct [], river_struct []);
 int             _Speciation(const chemtbl_struct [], const rttbl_struct *, int,
-    chmstate_struct *);
+    realtype **, chmstate_struct *);
 int             SpeciesType(FILE *, const char []);
 void            Unwrap(const char [], char []);
 double          EqvUnsatH(double, double, double, double, double);
@@ -794,7 +1007,8 @@ void            SoluteConc(const chemtbl_struct [], const rttbl_struct *,
     elem_struct [], river_struct []);
 void            RTUpdate(const rttbl_struct *, elem_struct [], river_struct []);
 void            InitRTVar(const chemtbl_struct [], const rttbl_struct *,
-    elem_struct [], river_struct [], N_Vector);
+    const rtic_struct [], scratch_struct [], elem_struct [], river_struct [],
+    N_Vector);
 int             MatchWrappedKey(const char [], const char []);
 void            ReadTempPoints(const char [], double, int *, int *);
 void            ReadDHParam(const char [], int, double *);
@@ -810,9 +1024,9 @@ void            ReadCationEchg(const char [], double, chemtbl_struct [],
 void            ReadMinKin(FILE *, int, double, int *, char [], chemtbl_struct [],
     kintbl_struct *);
 void            InitChemS(const chemtbl_struct [], const rttbl_struct *,
-    const rtic_struct *, double, double, chmstate_struct *);
+    const rtic_struct *, double, double, realtype **, chmstate_struct *);
 void            ReadChemAtt(const char *, atttbl_struct *);
-void            ReadRtIc(const char *, elem_struct []);
+void            ReadRtIc(const char *, const elem_struct [], rtic_struct []);
 void            UpdatePConc(const rttbl_struct *, elem_struct [],
     river_struct []);
 void            WriteRtIc(const char *, const chemtbl_struct [],
@@ -55,6 +55,8 @@ typedef struct filename_struct
 /* River input structure */
 typedef struct rivtbl_struct
 {
+    int            *id;                     /* river segment ID in input and
+                                             * output files */
     int            *from;               /* upstream node id */
     int            *to;                 /* downstream node id */
     int            *down;                   /* downstream channel id */
@@ -96,6 +98,8 @@ typedef struct matltbl_struct
 typedef struct meshtbl_struct
 {
     int             numnodes;               /* number of nodes */
+    int            *id;                     /* element ID in input and output
+                                             * files */
     int           **node;                   /* nodes of grids */
     int           **nabr;                   /* neighbors */
     double         *x;                      /* x of node (m) */
@@ -256,14 +260,86 @@ typedef struct lctbl_struct
                                              * interception calculation (-) */
     double          topt;                   /* optimum transpiration air
                                              * temperature (K) */
+    struct epconst_struct *epc;             /* calibrated ecophysiological
+                                             * constants of each land cover
+                                             * type, shared by elements */
 } lctbl_struct;
 
+/* Prefetcher of forcing series streamed from binary forcing files */
+typedef struct prefetch_struct
+{
+    struct tsdata_struct **queue;           /* series waiting for their next
+                                             * block */
+    int             size;                   /* capacity of queue */
+    int             head;                   /* position of first queued series
+                                             */
+    int             nqueue;                 /* number of queued series */
+#if defined(_OPENMP)
+    int             quit;                   /* flag to stop the prefetch thread
+                                             */
+    pthread_t       thread;                 /* prefetch thread */
+    pthread_mutex_t mutex;                  /* lock of queue and pending flags
+                                             */
+    pthread_cond_t  cond;                   /* signals queued and finished
+                                             * blocks */
+#endif
+} prefetch_struct;
+
+/* Window of a time series streamed from a binary forcing file. Values are
+ * read in blocks of forcing times. Consecutive blocks share one forcing time,
+ * so that every forcing interval lies in one block */
+typedef struct tsstream_struct
+{
+    int             fd;                     /* binary forcing file */
+    long long       offset;                 /* byte offset of the first value
+                                             * column */
+    int             block;                  /* number of forcing intervals per
+                                             * block */
+    double         *buffer[2];              /* current and next blocks, each
+                                             * with one column of block + 1
+                                             * values per variable */
+    int             first[2];               /* index of the first forcing time
+                                             * in each buffer (-1 = empty) */
+    int             cur;                    /* buffer of the current block */
+    int             next;                   /* index of the first forcing time
+                                             * of the block being prefetched */
+    int             pending;                /* flag that the next block is
+                                             * being prefetched */
+    double         *scale;                  /* calibration factor of each
+                                             * variable */
+    double         *shift;                  /* calibration offset of each
+                                             * variable */
+    prefetch_struct *prefetch;              /* prefetcher of the series */
+} tsstream_struct;
+
 /* Time series data structure */
 typedef struct tsdata_struct
 {
     int             length;                 /* length of time series */
+    int             nvrbl;                  /* number of variables */
+    int             mapped;                 /* flag that forcing times and
+                                             * values point into a mapped
+                                             * binary forcing file */
     int            *ftime;                  /* forcing time */
-    double        **data;                   /* forcing values at forcing time */
+    double        **data;                   /* forcing values at forcing time,
+                                             * one array of length values per
+                                             * variable */
+    int             first;                  /* index of the forcing time of
+                                             * data[k][0] */
+    tsstream_struct *stream;                /* window of a streamed series
+                                             * (NULL = whole series in memory)
+                                             */
+    int             cursor;                 /* index of the end of the last
+                                             * forcing interval found (0 = none)
+                                             */
+    double          rdt;                    /* reciprocal of the length of the
+                                             * last forcing interval found
+                                             * (s-1) */
+    double          weight[2];              /* interpolation weights of the
+                                             * two ends of the interval at t */
+    int             axis;                   /* index of the first series of
+                                             * the set with the same forcing
+                                             * times */
     double         *value;                  /* forcing values at model time t */
     union
     {
@@ -274,6 +350,35 @@ typedef struct tsdata_struct
     };
 } tsdata_struct;
 
+/* Header of a binary forcing file */
+typedef struct binhdr_struct
+{
+    char            magic[8];               /* BINFORC_MAGIC */
+    int             version;                /* binary forcing format version */
+    int             nts;                    /* number of time series */
+} binhdr_struct;
+
+/* Time series entry of a binary forcing file. Entries follow the header */
+typedef struct bints_struct
+{
+    int             length;                 /* length of time series */
+    int             nvrbl;                  /* number of variables */
+    double          attrib;                 /* bytes of boundary condition type
+                                             * or wind height */
+    long long       offset;                 /* byte offset of forcing times,
+                                             * which are followed by one column
+                                             * of values per variable */
+} bints_struct;
+
+/* Memory-mapped binary forcing file */
+typedef struct binforc_struct
+{
+    void           *addr;                   /* start of mapping */
+    size_t          size;                   /* size of mapping (bytes) */
+    int             fd;                     /* file descriptor, kept open to
+                                             * stream values */
+} binforc_struct;
+
 /* Forcing structure */
 typedef struct forc_struct
 {
@@ -309,6 +414,11 @@ typedef struct forc_struct
                                              * concentration time series */
     tsdata_struct  *prcpc;                  /* concentration in precipitation */
 #endif
+    int             nbinforc;               /* number of mapped binary forcing
+                                             * files */
+    binforc_struct  binforc[MAXBINFORC];    /* mapped binary forcing files */
+    int             nstream;                /* number of streamed series */
+    prefetch_struct prefetch;               /* prefetcher of streamed series */
 } forc_struct;
 
 #if defined(_NOAH_)
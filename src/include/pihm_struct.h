@@ -171,6 +171,68 @@ typedef struct ctrl_struct
     double          incr;                   /* increase factor (-) */
     int             maxspinyears;           /* maximum number of years for
                                              * spinup run */
+    int             precond;                /* preconditioner type:
+                                             * 0 = none, 1 = left, 2 = right */
+    int             jtimes;                 /* Jacobian-times-vector type:
+                                             * 0 = difference quotient,
+                                             * 1 = analytic */
+    int             linsol;                 /* linear solver type:
+                                             * 0 = iterative (SPGMR),
+                                             * 1 = sparse direct */
+    int             krylov;                 /* Krylov method of the iterative
+                                             * solver: 0 = SPGMR, 1 = SPFGMR,
+                                             * 2 = SPBCGS, 3 = SPTFQMR,
+                                             * 4 = PCG */
+    int             maxl;                   /* Krylov subspace dimension
+                                             * (0 = SUNDIALS default) */
+    int             gstype;                 /* Gram-Schmidt orthogonalization
+                                             * of SPGMR and SPFGMR:
+                                             * 1 = modified, 2 = classical */
+    double          epslin;                 /* ratio of linear to nonlinear
+                                             * convergence tolerance
+                                             * (0 = SUNDIALS default) */
+    int             msbj;                   /* maximum number of steps between
+                                             * Jacobian or preconditioner
+                                             * setups (0 = SUNDIALS default) */
+    int             nls;                    /* integration method and nonlinear
+                                             * solver: 0 = BDF and Newton,
+                                             * 1 = Adams and fixed point,
+                                             * 2 = BDF and automatic switching
+                                             */
+    int             anderson;               /* Anderson acceleration depth of
+                                             * the fixed-point solver */
+    int             sparse_jac;             /* sparse Jacobian type:
+                                             * 0 = analytic,
+                                             * 1 = colored finite difference */
+    int             dense;                  /* flag to only stop CVODE at
+                                             * forcing breakpoints and
+                                             * interpolate model steps */
+    int             tstop;                  /* end of current integration
+                                             * segment in dense output mode
+                                             * (ctime) */
+    int             schedule;               /* flag to advance the time loop
+                                             * from event to event */
+    int             nextstep;               /* index of the model step the
+                                             * time loop advances to */
+    int             root_event;             /* flag to locate flux regime
+                                             * thresholds and restart CVODE */
+    int             event_hold;             /* time a root function stays
+                                             * disarmed after an event (s) */
+    int             renumber;               /* element and river renumbering:
+                                             * 0 = input order,
+                                             * 1 = reverse Cuthill-McKee,
+                                             * 2 = Hilbert curve */
+    double          forc_mem;               /* memory of streamed forcing
+                                             * values (MB). 0 = binary forcing
+                                             * files are mapped whole */
+    int             output_flush;           /* when partly filled output
+                                             * blocks are written:
+                                             * 0 = every output time,
+                                             * 1 = restart file times,
+                                             * 2 = only when full */
+    int             output_format;          /* model variable output:
+                                             * 0 = one .dat file per variable,
+                                             * 1 = one output container */
 #if defined(_BGC_)
     int             read_bgc_restart;       /* flag to read BGC restart file */
     int             write_bgc_restart;      /* flag to write BGC restart file */
@@ -205,24 +267,408 @@ typedef struct varctrl_struct
     int             upd_intvl;              /* 0: hydrology step
                                              * 1: land surface step
                                              * 2: CN step */
+    int             vartype;                /* 0: other variables
+                                             * 1: one value per element
+                                             * 2: one value per river segment */
     int             nvar;                   /* number of variables for print */
     const double  **var;                    /* pointers to model variables */
     double         *buffer;                 /* buffer for averaging variables */
     int             counter;                /* counter for averaging variables*/
     FILE           *txtfile;                /* pointer to txt file */
     FILE           *datfile;                /* pointer to binary file */
+    struct outblock_struct *txtblock;       /* block being filled with txt
+                                             * output (NULL = none) */
+    struct outblock_struct *datblock;       /* block being filled with binary
+                                             * output (NULL = none) */
 } varctrl_struct;
 
+/* Block of bytes of one output file */
+typedef struct outblock_struct
+{
+    int             fd;                     /* descriptor of output file */
+    size_t          len;                    /* number of bytes in block */
+    char           *data;                   /* block bytes */
+    struct outblock_struct *next;           /* next free or queued block */
+} outblock_struct;
+
+/* Writer of model variable output. Output records are copied into blocks,
+ * which a writer thread writes to the output files */
+typedef struct outwriter_struct
+{
+    outblock_struct *free;                  /* free blocks */
+    outblock_struct *head;                  /* first block waiting to be
+                                             * written */
+    outblock_struct *tail;                  /* last block waiting to be written
+                                             */
+    int             nblock;                 /* number of allocated blocks */
+    size_t          size;                   /* bytes of a block */
+#if defined(_OPENMP)
+    int             quit;                   /* flag to stop the writer thread */
+    pthread_t       thread;                 /* writer thread */
+    pthread_mutex_t mutex;                  /* lock of free and queued blocks */
+    pthread_cond_t  cond;                   /* signals queued and written blocks
+                                             */
+#endif
+} outwriter_struct;
+
+/*
+ * An output container holds all model variable output of a simulation. The
+ * header and one index entry per variable are followed by chunks. A chunk
+ * holds consecutive records of one variable, each record being the output time
+ * followed by the values, as in .dat files
+ */
+typedef struct outhdr_struct
+{
+    char            magic[8];               /* OUTFILE_MAGIC */
+    int             version;                /* OUTFILE_VERSION */
+    int             nprint;                 /* number of output variables */
+    int             nelem;                  /* number of elements */
+    int             nriver;                 /* number of river segments */
+} outhdr_struct;
+
+/* Index entry of a variable in an output container */
+typedef struct outidx_struct
+{
+    char            name[MAXOUTNAME];       /* variable name, e.g., "gw" */
+    int             intvl;                  /* output interval (s) */
+    int             nvar;                   /* number of values per record */
+} outidx_struct;
+
+/* Header of a chunk of an output container */
+typedef struct outchunk_struct
+{
+    int             ivar;                   /* index of the variable */
+    int             nrec;                   /* number of records */
+    int             first;                  /* time of the first record */
+    int             last;                   /* time of the last record */
+} outchunk_struct;
+
 /* Print structure */
 typedef struct print_struct
 {
     varctrl_struct  varctrl[MAXPRINT];
     int             nprint;                 /* number of output variables */
+    outwriter_struct writer;                /* writer of model variable output
+                                             */
+    FILE           *outfile;                /* output container (NULL = one
+                                             * .dat file per variable) */
     FILE           *watbal_file;            /* pointer to water balance file */
     FILE           *cvodeperf_file;         /* pointer to CVode performance file
                                              */
+    FILE           *schedperf_file;         /* pointer to load balance file */
 } print_struct;
 
+/* Block-Jacobi preconditioner structure */
+typedef struct prec_struct
+{
+    realtype     ***jac_elem;               /* vertical Jacobian blocks of
+                                             * elements */
+    realtype     ***p_elem;                 /* factored preconditioner blocks of
+                                             * elements */
+    sunindextype  **pivot;                  /* pivots of element blocks */
+    double         *jac_river;              /* storage Jacobian of river
+                                             * segments */
+    double         *p_river;                /* preconditioner of river segments
+                                             */
+} prec_struct;
+
+/* Envelope LU factorization used by the sparse direct linear solver */
+typedef struct sparselu_struct
+{
+    sunindextype    n;                      /* matrix dimension */
+    sunindextype   *perm;                   /* reverse Cuthill-McKee index of
+                                             * each state variable */
+    sunindextype   *first;                  /* first column of each permuted row
+                                             * in the envelope */
+    sunindextype   *env_ptr;                /* offset of each permuted row in the
+                                             * envelope */
+    double         *lower;                  /* strict lower factor, by rows */
+    double         *upper;                  /* strict upper factor, by columns
+                                             */
+    double         *diag;                   /* diagonal of the upper factor */
+    double         *work;                   /* permuted right-hand side */
+    long int        last_flag;              /* last return flag */
+} sparselu_struct;
+
+/* Flux derivatives of an element used by the Jacobian-times-vector routine */
+typedef struct jvelem_struct
+{
+    double          vert[NUM_ELEM_HYDROL][NUM_ELEM_HYDROL];
+                                            /* vertical Jacobian block
+                                             * (column, row) */
+    double          ovl[NUM_EDGE][2];       /* overland flux derivatives with
+                                             * respect to the element and the
+                                             * neighbor (element or river) */
+    double          sub[NUM_EDGE][3];       /* subsurface flux derivatives with
+                                             * respect to the element, the
+                                             * neighbor, and the river */
+#if defined(_DGW_)
+    double          dgw[NUM_EDGE][2];       /* deep groundwater flux derivatives
+                                             * with respect to the element and
+                                             * the neighbor */
+#endif
+} jvelem_struct;
+
+/* Flux derivatives of a river segment used by the Jacobian-times-vector
+ * routine */
+typedef struct jvriver_struct
+{
+    double          self;                   /* derivative of total outflow with
+                                             * respect to stage */
+    double          down[2];                /* downstream flux derivatives with
+                                             * respect to the segment and the
+                                             * downstream segment */
+    double          surf[2];                /* overland flux derivatives with
+                                             * respect to left and right banks */
+    double          gw[2];                  /* aquifer flux derivatives with
+                                             * respect to left and right banks */
+} jvriver_struct;
+
+/* Colored finite difference Jacobian structure */
+typedef struct colorjac_struct
+{
+    int             ncolors;                /* number of column colors */
+    int            *color;                  /* color of each column */
+    sunindextype   *color_ptr;              /* offset of each color in the
+                                             * grouped column list */
+    sunindextype   *color_col;              /* columns grouped by color */
+    sunindextype   *col_ptr;                /* offset of each column in the
+                                             * transposed pattern */
+    sunindextype   *col_row;                /* row of each non-zero, by columns
+                                             */
+    sunindextype   *col_pos;                /* position of each non-zero in the
+                                             * CSR data, by columns */
+    double         *inc;                    /* difference increment of each
+                                             * column */
+    double          time;                   /* cumulative Jacobian setup time
+                                             * (s) */
+} colorjac_struct;
+
+/* Jacobian-times-vector structure */
+typedef struct jtimes_struct
+{
+    jvelem_struct  *elem;
+    jvriver_struct *river;
+    double         *dh_dx;                  /* surface slope in x direction */
+    double         *dh_dy;                  /* surface slope in y direction */
+} jtimes_struct;
+
+/* Nonlinear solver structure */
+typedef struct nls_struct
+{
+    SUNNonlinearSolver newton;              /* Newton solver */
+    SUNNonlinearSolver fixedpt;             /* Anderson-accelerated fixed-point
+                                             * solver */
+    int             active;                 /* attached solver: 0 = Newton,
+                                             * 1 = fixed point */
+    int             fixedpt_init;           /* flag that the fixed-point solver
+                                             * has been initialized */
+    int             nsmooth;                /* number of consecutive non-stiff
+                                             * model steps */
+    long int        nsteps[2];              /* number of CVODE steps taken with
+                                             * each solver */
+} nls_struct;
+
+/* Cumulative CVODE statistics */
+typedef struct cvstats_struct
+{
+    long int        nst;                    /* number of steps */
+    long int        nfe;                    /* number of RHS evaluations */
+    long int        nni;                    /* number of nonlinear iterations */
+    long int        ncfn;                   /* number of nonlinear convergence
+                                             * failures */
+    long int        netf;                   /* number of error test failures */
+    long int        nli;                    /* number of linear iterations */
+    long int        npe;                    /* number of preconditioner
+                                             * evaluations */
+    long int        nps;                    /* number of preconditioner solves
+                                             */
+    long int        nlcf;                   /* number of linear convergence
+                                             * failures */
+    long int        nje;                    /* number of Jacobian evaluations */
+    long int        nevents;                /* number of root-finding events */
+} cvstats_struct;
+
+/* Root-finding events at flux regime thresholds */
+typedef struct event_struct
+{
+    int             nroot;                  /* number of root functions */
+    int            *rootsfound;             /* root functions found by CVODE */
+    int            *armed;                  /* flag that a root function is
+                                             * armed */
+    double         *rearm;                  /* solver time after which a root
+                                             * function that found an event is
+                                             * re-armed (s) */
+    cvstats_struct  stats0;                 /* statistics accumulated before
+                                             * the latest restart */
+} event_struct;
+
+/* Structure-of-arrays mirror of the element states and parameters read by
+ * the lateral flux kernels. Edge arrays are indexed by NUM_EDGE * i + j. Each
+ * interface between two elements is listed once in the face list */
+typedef struct hydro_struct
+{
+    double         *surfh;                  /* actual surface water depth (m) */
+    double         *gw;                     /* groundwater storage (m) */
+    double         *zmin;                   /* bedrock elevation (m) */
+    double         *zmax;                   /* surface elevation (m) */
+    double         *rough;                  /* surface roughness (Manning's n)
+                                             * (s m-1/3) */
+    double         *ksath;                  /* horizontal saturated hydraulic
+                                             * conductivity (m s-1) */
+    double         *kmac;                   /* horizontal conductivity of the
+                                             * macropore layer (m s-1) */
+    double         *depth;                  /* soil depth (m) */
+    double         *dmac;                   /* macropore depth (m) */
+    int            *nabr;                   /* neighbor element (-1: boundary)
+                                             */
+    int            *nabr_river;             /* adjacent river segment (-1: no
+                                             * river) */
+    double         *edge;                   /* length of edge (m) */
+    double         *dist_nabr;              /* distance to neighbor (m) */
+    double         *x_nabr;                 /* x of neighbor centroid (m) */
+    double         *y_nabr;                 /* y of neighbor centroid (m) */
+#if defined(_BGC_) || defined(_CYCLES_) || defined(_RT_)
+    double         *avg_smcmax;             /* average porosity with neighbor
+                                             * (m3 m-3) */
+    double         *avg_depth;              /* average soil depth with neighbor
+                                             * (m) */
+# if defined(_DGW_)
+    double         *avg_smcmax_geol;        /* average porosity of deep zone
+                                             * with neighbor (m3 m-3) */
+    double         *avg_depth_geol;         /* average deep zone depth with
+                                             * neighbor (m) */
+# endif
+#endif
+    int             nface;                  /* number of element-to-element
+                                             * interfaces */
+    int            *face;                   /* edge indices of both sides of
+                                             * each interface (2 * nface) */
+    double         *inv_dist;               /* inverse of distance between
+                                             * centroids of each interface
+                                             * (m-1) */
+    double         *cond_sub;               /* edge length over distance
+                                             * between centroids of each
+                                             * interface (-) */
+    double         *cond_ovl;               /* edge length over average
+                                             * roughness of each interface
+                                             * (m4/3 s-1) */
+    int             nbound;                 /* number of domain boundary edges
+                                             */
+    int            *bound;                  /* edge indices of domain boundary
+                                             * edges */
+    double         *qsub;                   /* subsurface flux of each
+                                             * interface (m3 s-1) */
+    double         *qovl;                   /* overland fluxes out of both
+                                             * sides of each interface (m3 s-1)
+                                             */
+} hydro_struct;
+
+/* Upstream segments of each river segment in compressed sparse row format */
+typedef struct rivnet_struct
+{
+    int            *up_ptr;                 /* start of the upstream segments
+                                             * of each segment in up
+                                             * (nriver + 1) */
+    int            *up;                     /* indices of upstream segments */
+} rivnet_struct;
+
+/* Scratch arena for temporaries of the RHS, reaction, and daily kernels */
+typedef struct scratch_struct
+{
+    double         *buffer;                 /* preallocated work array */
+    size_t          size;                   /* length of work array */
+    size_t          top;                    /* number of borrowed doubles */
+#if defined(_RT_)
+    realtype      **jcb;                    /* dense Jacobian of chemistry
+                                             * Newton iterations */
+#endif
+} scratch_struct;
+
+/* Cost-aware schedule of an element loop of which the cost per element is
+ * uneven */
+typedef struct sched_struct
+{
+    int            *order;                  /* elements in decreasing order of
+                                             * measured cost */
+    double         *cost;                   /* wall time of each element since
+                                             * the latest refresh (s) */
+    double         *busy;                   /* wall time of each thread since
+                                             * the latest refresh (s) */
+    int             ncall;                  /* number of calls since the latest
+                                             * refresh */
+} sched_struct;
+
+/* Initial conditions and restart inputs of elements and river segments, which
+ * are only used during initialization */
+typedef struct init_struct
+{
+    ic_struct      *ic;                     /* land surface and hydrologic
+                                             * initial conditions */
+    river_ic_struct *river_ic;              /* river initial conditions */
+#if defined(_BGC_)
+    bgcic_struct   *bgcic;                  /* CN initial conditions */
+# if !defined(_LUMPEDBGC_) && !defined(_LEACHING_)
+    river_bgcic_struct *river_bgcic;        /* river CN initial conditions */
+# endif
+#endif
+#if defined(_CYCLES_)
+    agic_struct    *agic;                   /* Cycles initial conditions */
+#endif
+#if defined(_RT_)
+    rtic_struct    *rtic;                   /* chemical initial conditions of
+                                             * each volume (NCHMVOL * i + j) */
+#endif
+} init_struct;
+
+#if defined(_RT_)
+/* Contiguous blocks from which the species arrays of elements and river
+ * segments are carved */
+typedef struct chmpool_struct
+{
+    double         *conc;                   /* concentrations, fluxes, and
+                                             * boundary conditions */
+    solute_struct  *solute;                 /* element solutes */
+    river_solute_struct *river_solute;      /* river solutes */
+} chmpool_struct;
+#endif
+
+/* Task runner of a PIHM step */
+typedef struct taskgraph_struct
+{
+    struct pihm_struct *pihm;               /* model data used by asynchronous
+                                             * tasks */
+    int             helper;                 /* flag that asynchronous tasks run
+                                             * on the helper thread */
+    int             pending;                /* bit mask of asynchronous tasks
+                                             * queued or running */
+    int             queue[NUM_TASK];        /* queued asynchronous tasks */
+    int             head;                   /* position of the next task to
+                                             * run in queue */
+    int             nqueue;                 /* number of queued tasks */
+    int             quit;                   /* flag that the helper thread
+                                             * should exit */
+    int             t[NUM_TASK];            /* model time of asynchronous tasks
+                                             * (s) */
+    int             dt[NUM_TASK];           /* length of the step of
+                                             * asynchronous tasks (s) */
+    int             ncall[NUM_TASK];        /* number of runs of each task */
+    double          start[NUM_TASK];        /* wall clock at the start of the
+                                             * latest run of each task (s) */
+    double          busy[NUM_TASK];         /* run time of each task (s) */
+    double          wait;                   /* time the main thread waited for
+                                             * asynchronous tasks (s) */
+    double          clock0;                 /* wall clock at initialization (s)
+                                             */
+    FILE           *trace_file;             /* pointer to task trace file */
+#if defined(_OPENMP)
+    pthread_t       thread;                 /* helper thread */
+    pthread_mutex_t mutex;                  /* lock of the task runner */
+    pthread_cond_t  cond;                   /* signals queued and finished
+                                             * tasks */
+#endif
+} taskgraph_struct;
+
 typedef struct pihm_struct
 {
     siteinfo_struct siteinfo;
@@ -255,11 +701,25 @@ typedef struct pihm_struct
     calib_struct    calib;
     ctrl_struct     ctrl;
     print_struct    print;
+    prec_struct     prec;
+    jtimes_struct   jtimes;
+    colorjac_struct colorjac;
+    nls_struct      nls;
+    event_struct    event;
+    hydro_struct    hydro;
+    rivnet_struct   rivnet;
+    scratch_struct *scratch;                /* one arena per thread */
+    sched_struct    sched[NUM_SCHED];       /* schedules of land surface,
+                                             * reaction, and daily loops */
+    taskgraph_struct taskgraph;
+    SUNMatrix       jac;
+    SUNMatrix       jac_pattern;
 #if defined(_RT_)
     chemtbl_struct  chemtbl[MAXSPS];
     kintbl_struct   kintbl[MAXSPS];
     rttbl_struct    rttbl;
     chmictbl_struct chmictbl;
+    chmpool_struct  chmpool;
 #endif
 } *pihm_struct;
 
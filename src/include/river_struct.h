@@ -19,6 +19,8 @@ typedef struct river_topo_struct
                                              * (m) */
     double          dist_left;              /* distance to left neighbor (m) */
     double          dist_right;             /* distance to right neighbor (m) */
+    double          dist_down;              /* distance to downstream segment
+                                             * (m) */
 } river_topo_struct;
 
 /* River water states */
@@ -51,6 +53,8 @@ typedef struct matl_struct
     double          cwr;                    /* discharge coefficient (-) */
     double          ksath;                  /* bank hydraulic conductivity
                                              * (m s-1) */
+    double          rough_down;             /* average roughness with the
+                                             * downstream segment (s m-1/3) */
 } matl_struct;
 
 /* River boundary conditions */
@@ -111,6 +115,8 @@ typedef struct river_solute_struct
 typedef struct river_struct
 {
     int             ind;                    /* river index */
+    int             id;                     /* river ID in input and output
+                                             * files */
     int             left;                   /* left neighbor*/
     int             right;                  /* right neighbor */
     int             from;                   /* upstream node */
@@ -122,9 +128,10 @@ typedef struct river_struct
     matl_struct     matl;
     river_wstate_struct ws;
     river_wflux_struct wf;
-    river_ic_struct ic;
     river_bc_struct bc;
-#if defined(_BGC_) || defined(_CYCLES_) || defined(_RT_)
+#if defined(_RT_)
+    river_solute_struct *solute;            /* one for each primary species */
+#elif defined(_BGC_) || defined(_CYCLES_)
     river_solute_struct solute[NSOLUTE];
 #endif
 #if defined(_CYCLES_)
@@ -134,8 +141,6 @@ typedef struct river_struct
     river_nstate_struct ns;
     river_nflux_struct nf;
     river_solute_struct nsol;
-    river_bgcic_struct restart_input;
-    river_bgcic_struct restart_output;
 #endif
 #if defined(_RT_)
     chmstate_struct     chms;
@@ -10,16 +10,38 @@ void InitForcing(const calib_struct *calib, forc_struct *forc,
 {
     int             i, j;
 
-    /* Apply climate scenarios */
+    /* Apply climate scenarios. Forcing values mapped from binary forcing files
+     * are only copied into memory when they are changed. Streamed forcing
+     * values are changed when they are read */
     for (i = 0; i < forc->nmeteo; i++)
     {
+        if (forc->meteo[i].stream != NULL)
+        {
+            forc->meteo[i].stream->scale[PRCP_TS] = calib->prcp;
+            forc->meteo[i].stream->shift[SFCTMP_TS] = calib->sfctmp;
+            continue;
+        }
+
+        if (calib->prcp != 1.0)
+        {
 #if defined(_OPENMP)
 # pragma omp parallel for
 #endif
-        for (j = 0; j < forc->meteo[i].length; j++)
+            for (j = 0; j < forc->meteo[i].length; j++)
+            {
+                forc->meteo[i].data[PRCP_TS][j] *= calib->prcp;
+            }
+        }
+
+        if (calib->sfctmp != 0.0)
         {
-            forc->meteo[i].data[j][PRCP_TS] *= calib->prcp;
-            forc->meteo[i].data[j][SFCTMP_TS] += calib->sfctmp;
+#if defined(_OPENMP)
+# pragma omp parallel for
+#endif
+            for (j = 0; j < forc->meteo[i].length; j++)
+            {
+                forc->meteo[i].data[SFCTMP_TS][j] += calib->sfctmp;
+            }
         }
     }
 
@@ -86,6 +108,19 @@ void InitForcing(const calib_struct *calib, forc_struct *forc,
     }
 #endif
 
+    /* Series of a forcing file that share forcing times also share the search
+     * for the forcing interval */
+    InitTsAxis(forc->nmeteo, forc->meteo);
+    InitTsAxis(forc->nlai, forc->lai);
+    InitTsAxis(forc->nbc, forc->bc);
+    InitTsAxis(forc->nriverbc, forc->riverbc);
+#if defined(_NOAH_)
+    InitTsAxis(forc->nrad, forc->rad);
+#endif
+#if defined(_RT_)
+    InitTsAxis(forc->nprcpc, forc->prcpc);
+#endif
+
 #if defined(_OPENMP)
 # pragma omp parallel for
 #endif
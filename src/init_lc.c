@@ -1,10 +1,24 @@
 #include "pihm.h"
 
-void InitLc(const lctbl_struct *lctbl, const calib_struct *calib,
+void InitLc(lctbl_struct *lctbl, const calib_struct *calib,
     elem_struct elem[])
 {
     int             i;
 
+    /* Ecophysiological constants only depend on the land cover type, so
+     * elements point to one shared copy of each type */
+    lctbl->epc =
+        (epconst_struct *)malloc(lctbl->number * sizeof(epconst_struct));
+
+    for (i = 0; i < lctbl->number; i++)
+    {
+#if defined(_NOAH_)
+        InitEpc(i + 1, lctbl, calib, &lctbl->epc[i]);
+#else
+        InitEpc(i + 1, lctbl, &lctbl->epc[i]);
+#endif
+    }
+
 #if defined(_OPENMP)
 # pragma omp parallel for
 #endif
@@ -33,14 +47,9 @@ void _InitLc(const lctbl_struct *lctbl, const calib_struct *calib,
 
     lc_ind = elem_ptr->attrib.lc - 1;
 
+    elem_ptr->epc = &lctbl->epc[lc_ind];
+
     elem_ptr->ps.rzd = calib->rzd * lctbl->rzd[lc_ind];
-#if !defined(_CYCLES_OBSOLETE_)
-    elem_ptr->epc.rsmin = lctbl->rsmin[lc_ind];
-    elem_ptr->epc.rgl = lctbl->rgl[lc_ind];
-    elem_ptr->epc.hs = lctbl->hs[lc_ind];
-    elem_ptr->epc.rsmax = lctbl->rsmax;
-    elem_ptr->epc.topt = lctbl->topt;
-#endif
     elem_ptr->lc.shdfac = calib->vegfrac * lctbl->vegfrac[lc_ind];
     elem_ptr->lc.laimin = lctbl->laimin[lc_ind];
     elem_ptr->lc.laimax = lctbl->laimax[lc_ind];
@@ -71,12 +80,44 @@ void _InitLc(const lctbl_struct *lctbl, const calib_struct *calib,
 #endif
 
 #if defined(_NOAH_)
-# if !defined(_CYCLES_OBSOLETE_)
-    elem_ptr->epc.rgl *= calib->rgl;
-    elem_ptr->epc.hs *= calib->hs;
-    elem_ptr->epc.rsmin *= calib->rsmin;
-# endif
     elem_ptr->lc.cmcfactr *= calib->cmcmax;
     elem_ptr->lc.cfactr *= calib->cfactr;
 #endif
 }
+
+#if defined(_NOAH_)
+void InitEpc(int lc, const lctbl_struct *lctbl, const calib_struct *calib,
+    epconst_struct *epc)
+#else
+void InitEpc(int lc, const lctbl_struct *lctbl, epconst_struct *epc)
+#endif
+{
+    int             lc_ind;
+
+    lc_ind = lc - 1;
+
+#if !defined(_CYCLES_OBSOLETE_)
+    epc->rsmin = lctbl->rsmin[lc_ind];
+    epc->rgl = lctbl->rgl[lc_ind];
+    epc->hs = lctbl->hs[lc_ind];
+    epc->rsmax = lctbl->rsmax;
+    epc->topt = lctbl->topt;
+#endif
+
+#if defined(_NOAH_)
+# if !defined(_CYCLES_OBSOLETE_)
+    epc->rgl *= calib->rgl;
+    epc->hs *= calib->hs;
+    epc->rsmin *= calib->rsmin;
+# endif
+# if !defined(_CYCLES_)
+    /* Urban minimum canopy resistance of Noah LSM */
+    if (IGBP_URBAN_BUILDUP == lc || NLCD40_DEVELOPED_OPEN == lc ||
+        NLCD40_DEVELOPED_LOW == lc || NLCD40_DEVELOPED_MID == lc ||
+        NLCD40_DEVELOPED_HIGH == lc)
+    {
+        epc->rsmin = 400.0;
+    }
+# endif
+#endif
+}
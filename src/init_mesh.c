@@ -12,6 +12,7 @@ void InitMesh(const meshtbl_struct *meshtbl, elem_struct elem[])
         int             j;
 
         elem[i].ind = i + 1;
+        elem[i].id = meshtbl->id[i];
 
         for (j = 0; j < NUM_EDGE; j++)
         {
@@ -11,6 +11,7 @@ void InitRiver(const meshtbl_struct *meshtbl, const rivtbl_struct *rivtbl,
         int             j;
 
         river[i].ind = i + 1;
+        river[i].id = rivtbl->id[i];
         river[i].left = rivtbl->left[i];
         river[i].right = rivtbl->right[i];
         river[i].from = rivtbl->from[i];
@@ -72,6 +73,85 @@ void InitRiver(const meshtbl_struct *meshtbl, const rivtbl_struct *rivtbl,
             RiverEqWid(river[i].shp.intrpl_ord, river[i].shp.depth,
             river[i].shp.coeff);
     }
+
+    /* Coefficients of channel flow to the downstream segment, which do not
+     * change during the simulation */
+    for (i = 0; i < nriver; i++)
+    {
+        const river_struct *down;
+
+        if (river[i].down > 0)
+        {
+            down = &river[river[i].down - 1];
+
+            river[i].topo.dist_down =
+                0.5 * (river[i].shp.length + down->shp.length);
+            river[i].matl.rough_down =
+                0.5 * (river[i].matl.rough + down->matl.rough);
+        }
+        else
+        {
+            river[i].topo.dist_down = BADVAL;
+            river[i].matl.rough_down = BADVAL;
+        }
+    }
+}
+
+void InitRiverNet(const river_struct river[], rivnet_struct *rivnet)
+{
+    /*
+     * List the upstream segments of each river segment, so that in-flows of
+     * all segments can be gathered at the same time. Upstream segments are
+     * listed in ascending order, which is the order in which their fluxes were
+     * summed by the serial accumulation
+     */
+    int             i;
+    int             k;
+    int             down;
+    int             maxup = 0;
+    int            *count;
+
+    rivnet->up_ptr = (int *)calloc(nriver + 1, sizeof(int));
+    count = (int *)calloc(nriver, sizeof(int));
+
+    for (i = 0; i < nriver; i++)
+    {
+        if (river[i].down > 0)
+        {
+            rivnet->up_ptr[river[i].down]++;
+        }
+    }
+
+    for (i = 0; i < nriver; i++)
+    {
+        maxup = MAX(maxup, rivnet->up_ptr[i + 1]);
+        rivnet->up_ptr[i + 1] += rivnet->up_ptr[i];
+    }
+
+    rivnet->up = (int *)malloc(MAX(rivnet->up_ptr[nriver], 1) * sizeof(int));
+
+    for (i = 0; i < nriver; i++)
+    {
+        if (river[i].down > 0)
+        {
+            down = river[i].down - 1;
+            k = rivnet->up_ptr[down] + count[down];
+            rivnet->up[k] = i;
+            count[down]++;
+        }
+    }
+
+    free(count);
+
+    pihm_printf(VL_VERBOSE,
+        "River network: %d upstream links, at most %d per segment.\n",
+        rivnet->up_ptr[nriver], maxup);
+}
+
+void FreeRiverNet(rivnet_struct *rivnet)
+{
+    free(rivnet->up_ptr);
+    free(rivnet->up);
 }
 
 double RiverEqWid(int order, double depth, double coeff)
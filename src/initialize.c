@@ -6,6 +6,7 @@ void Initialize(pihm_struct pihm, N_Vector CV_Y, void **cvode_mem)
 {
     int             i, j;
     int             bc;
+    init_struct     init;
 #if defined(_LUMPEDBGC_)
     int             soil_counter[MAX_TYPE];
     int             lc_counter[MAX_TYPE];
@@ -19,8 +20,10 @@ void Initialize(pihm_struct pihm, N_Vector CV_Y, void **cvode_mem)
 
     pihm_printf(VL_VERBOSE, "\n\nInitialize data structure\n");
 
-    /* Allocate memory for solver */
-    *cvode_mem = CVodeCreate(CV_BDF);
+    /* Allocate memory for solver. Adams methods are only used with the
+     * fixed-point nonlinear solver */
+    *cvode_mem = CVodeCreate((pihm->ctrl.nls == ADAMS_FIXEDPT) ?
+        CV_ADAMS : CV_BDF);
     if (*cvode_mem == NULL)
     {
         pihm_printf(VL_ERROR, "Error in allocating memory for solver.\n");
@@ -37,6 +40,10 @@ void Initialize(pihm_struct pihm, N_Vector CV_Y, void **cvode_mem)
 #endif
     pihm->river = (river_struct *)malloc(nriver * sizeof(river_struct));
 
+    /* Initial conditions and restart inputs are kept in side tables that are
+     * freed at the end of initialization */
+    NewInit(&init);
+
     for (i = 0; i < nelem; i++)
     {
         pihm->elem[i].attrib.soil = pihm->atttbl.soil[i];
@@ -161,6 +168,9 @@ void Initialize(pihm_struct pihm, N_Vector CV_Y, void **cvode_mem)
     /* Initialize element land cover properties */
     InitLc(&pihm->lctbl, &pihm->calib, pihm->elem);
 
+    /* Stream forcing values from binary forcing files */
+    InitForcStream(pihm->ctrl.forc_mem, &pihm->forc);
+
     /* Initialize element forcing */
 #if defined(_RT_)
     InitForcing(&pihm->rttbl, &pihm->calib, &pihm->forc, pihm->elem);
@@ -172,6 +182,9 @@ void Initialize(pihm_struct pihm, N_Vector CV_Y, void **cvode_mem)
     InitRiver(&pihm->meshtbl, &pihm->rivtbl, &pihm->shptbl, &pihm->matltbl,
         &pihm->calib, pihm->elem, pihm->river);
 
+    /* Upstream segments used to gather in-flows of river segments */
+    InitRiverNet(pihm->river, &pihm->rivnet);
+
     /* Correct element elevations to avoid sinks */
     if (corr_mode)
     {
@@ -194,18 +207,36 @@ void Initialize(pihm_struct pihm, N_Vector CV_Y, void **cvode_mem)
 
 #if defined(_BGC_)
     /* Initialize CN (Biome-BGC) module */
-    InitBgc(&pihm->epctbl, &pihm->calib, pihm->elem);
+    InitBgc(&pihm->epctbl, &pihm->calib, pihm->elem, &pihm->lctbl);
 #endif
 
 #if defined(_RT_)
     InitChem(pihm->filename.cdbs, &pihm->calib, &pihm->forc, pihm->chemtbl,
-        pihm->kintbl, &pihm->rttbl, &pihm->chmictbl, pihm->elem);
+        pihm->kintbl, &pihm->rttbl, &pihm->chmictbl, pihm->elem, init.rtic);
+
+    /* Species arrays are sized once the number of species is known */
+    InitChmPool(&pihm->rttbl, pihm->elem, pihm->river, &pihm->chmpool);
 #endif
 
 #if defined(_BGC_) || defined(_CYCLES_) || defined(_RT_)
     InitSolute(pihm->elem);
 #endif
 
+    /* Allocate scratch arenas so that kernels do not allocate memory during
+     * the simulation */
+#if defined(_RT_)
+    pihm->scratch = NewScratch(&pihm->rttbl);
+#else
+    pihm->scratch = NewScratch();
+#endif
+
+    /* Cost-aware schedules of the land surface, reaction, and daily loops */
+    InitSched(pihm->sched);
+
+    /* Compact copy of the element parameters used by the lateral flux
+     * kernels */
+    InitHydro(pihm->elem, &pihm->hydro);
+
     /*
      * Create hydrological and land surface initial conditions
      */
@@ -221,54 +252,57 @@ void Initialize(pihm_struct pihm, N_Vector CV_Y, void **cvode_mem)
             &pihm->forc, pihm->elem);
 #endif
 
-        RelaxIc(pihm->elem, pihm->river);
+        RelaxIc(pihm->elem, &init);
     }
     else if (pihm->ctrl.init_type == RST_FILE)
     {
         /* Hot start (using .ic file) */
-        ReadIc(pihm->filename.ic, pihm->elem, pihm->river);
+        ReadIc(pihm->filename.ic, pihm->elem, pihm->river, &init);
     }
 
     /* Initialize state variables */
-    InitVar(pihm->elem, pihm->river, CV_Y);
+    InitVar(&init, pihm->elem, pihm->river, CV_Y);
 
 #if defined(_CYCLES_)
     /* Initialize Cycles module */
     if (pihm->ctrl.read_cycles_restart)
     {
-        ReadCyclesIc(pihm->filename.cyclesic, pihm->elem);
+        ReadCyclesIc(pihm->filename.cyclesic, pihm->elem, init.agic);
     }
     else
     {
-        FirstDay(&pihm->soiltbl, &pihm->ctrl, pihm->elem);
+        FirstDay(&pihm->soiltbl, &pihm->ctrl, pihm->elem, init.agic);
     }
 
-    InitAgVar(pihm->elem, pihm->river, CV_Y);
+    InitAgVar(init.agic, pihm->elem, pihm->river, CV_Y);
 #endif
 
 #if defined(_BGC_)
     /* Initialize CN variables */
     if (pihm->ctrl.read_bgc_restart)
     {
-        ReadBgcIc(pihm->filename.bgcic, pihm->elem, pihm->river);
+        ReadBgcIc(pihm->filename.bgcic, pihm->elem, pihm->river, &init);
     }
     else
     {
-        FirstDay(&pihm->cninit, pihm->elem, pihm->river);
+        FirstDay(&pihm->cninit, pihm->elem, &init);
     }
 
-    InitBgcVar(pihm->elem, pihm->river, CV_Y);
+    InitBgcVar(&init, pihm->elem, pihm->river, CV_Y);
 #endif
 
 #if defined(_RT_)
     if (pihm->ctrl.read_rt_restart)
     {
-        ReadRtIc(pihm->filename.rtic, pihm->elem);
+        ReadRtIc(pihm->filename.rtic, pihm->elem, init.rtic);
     }
 
-    InitRTVar(pihm->chemtbl, &pihm->rttbl, pihm->elem, pihm->river, CV_Y);
+    InitRTVar(pihm->chemtbl, &pihm->rttbl, init.rtic, pihm->scratch,
+        pihm->elem, pihm->river, CV_Y);
 #endif
 
+    FreeInit(&init);
+
     /* Calculate model time steps */
     CalcModelSteps(&pihm->ctrl);
 
@@ -310,7 +344,7 @@ void CorrectElev(const river_struct river[], elem_struct elem[])
 
         if (sink == 1)
         {
-            pihm_printf(VL_NORMAL, "Element %4d is a sink.\n", i + 1);
+            pihm_printf(VL_NORMAL, "Element %4d is a sink.\n", elem[i].id);
 
             /* Note: Following correction is being applied for correction
              * mode only */
@@ -350,7 +384,7 @@ void CorrectElev(const river_struct river[], elem_struct elem[])
                 river_flag = 1;
                 pihm_printf(VL_NORMAL,
                     "River %d is lower than downstream River %d.\n",
-                    i + 1, river[i].down);
+                    river[i].id, river[river[i].down - 1].id);
             }
         }
         else
@@ -361,7 +395,7 @@ void CorrectElev(const river_struct river[], elem_struct elem[])
                 river_flag = 1;
                 pihm_printf(VL_NORMAL,
                     "River outlet is higher than the channel (River %d).\n",
-                    i + 1);
+                    river[i].id);
             }
         }
     }
@@ -472,7 +506,7 @@ double _WsAreaElev(int type, const elem_struct *elem)
     return (type == WS_AREA) ? ans : ans / (double)nelem;
 }
 
-void RelaxIc(elem_struct elem[], river_struct river[])
+void RelaxIc(const elem_struct elem[], init_struct *init)
 {
     int             i;
     const double    INIT_UNSAT = 0.1;
@@ -485,15 +519,16 @@ void RelaxIc(elem_struct elem[], river_struct river[])
 #endif
     for (i = 0; i < nelem; i++)
     {
-        elem[i].ic.cmc   = 0.0;
-        elem[i].ic.sneqv = 0.0;
-        elem[i].ic.surf  = 0.0;
-        elem[i].ic.unsat = INIT_UNSAT;
-        elem[i].ic.gw    = elem[i].soil.depth - INIT_UNSAT;
+        init->ic[i].cmc   = 0.0;
+        init->ic[i].sneqv = 0.0;
+        init->ic[i].surf  = 0.0;
+        init->ic[i].unsat = INIT_UNSAT;
+        init->ic[i].gw    = elem[i].soil.depth - INIT_UNSAT;
 
 #if defined(_DGW_)
-        elem[i].ic.gw_geol = MIN(elem[i].geol.depth, INIT_DGW);
-        elem[i].ic.unsat_geol = 0.5 * (elem[i].geol.depth - elem[i].ic.gw_geol);
+        init->ic[i].gw_geol = MIN(elem[i].geol.depth, INIT_DGW);
+        init->ic[i].unsat_geol =
+            0.5 * (elem[i].geol.depth - init->ic[i].gw_geol);
 #endif
 
 #if defined(_NOAH_)
@@ -502,16 +537,16 @@ void RelaxIc(elem_struct elem[], river_struct river[])
 
         sfctmp = elem[i].es.sfctmp;
 
-        elem[i].ic.t1 = sfctmp;
+        init->ic[i].t1 = sfctmp;
 
-        elem[i].ic.stc[0] = sfctmp +
+        init->ic[i].stc[0] = sfctmp +
             (sfctmp - elem[i].ps.tbot) / elem[i].ps.zbot *
             elem[i].ps.soil_depth[0] * 0.5;
 
         for (j = 1; j < MAXLYR; j++)
         {
-            elem[i].ic.stc[j] = (elem[i].ps.soil_depth[j] > 0.0) ?
-                 elem[i].ic.stc[j - 1] +
+            init->ic[i].stc[j] = (elem[i].ps.soil_depth[j] > 0.0) ?
+                 init->ic[i].stc[j - 1] +
                 (sfctmp - elem[i].ps.tbot) / elem[i].ps.zbot * 0.5 *
                 (elem[i].ps.soil_depth[j - 1] + elem[i].ps.soil_depth[j]) :
                 BADVAL;
@@ -519,13 +554,13 @@ void RelaxIc(elem_struct elem[], river_struct river[])
 
         for (j = 0; j < MAXLYR; j++)
         {
-            elem[i].ic.smc[j] = (elem[i].ps.soil_depth[j] > 0.0) ?
+            init->ic[i].smc[j] = (elem[i].ps.soil_depth[j] > 0.0) ?
                 elem[i].soil.smcmax : BADVAL;
-            elem[i].ic.swc[j] = (elem[i].ps.soil_depth[j] > 0.0) ?
+            init->ic[i].swc[j] = (elem[i].ps.soil_depth[j] > 0.0) ?
                 elem[i].soil.smcmax : BADVAL;
         }
 
-        elem[i].ic.snowh = 0.0;
+        init->ic[i].snowh = 0.0;
 #endif
     }
 
@@ -534,11 +569,12 @@ void RelaxIc(elem_struct elem[], river_struct river[])
 #endif
     for (i = 0; i < nriver; i++)
     {
-        river[i].ic.stage = 0.0;
+        init->river_ic[i].stage = 0.0;
     }
 }
 
-void InitVar(elem_struct elem[], river_struct river[], N_Vector CV_Y)
+void InitVar(const init_struct *init, elem_struct elem[], river_struct river[],
+    N_Vector CV_Y)
 {
     int             i;
 
@@ -549,39 +585,39 @@ void InitVar(elem_struct elem[], river_struct river[], N_Vector CV_Y)
     for (i = 0; i < nelem; i++)
     {
 #if defined(_CYCLES_OBSOLETE_)
-        elem[i].ws.flatResidueWater = elem[i].ic.cmc;
+        elem[i].ws.flatResidueWater = init->ic[i].cmc;
 #else
-        elem[i].ws.cmc   = elem[i].ic.cmc;
+        elem[i].ws.cmc   = init->ic[i].cmc;
 #endif
-        elem[i].ws.sneqv = elem[i].ic.sneqv;
+        elem[i].ws.sneqv = init->ic[i].sneqv;
 
-        elem[i].ws.surf  = elem[i].ic.surf;
-        elem[i].ws.unsat = elem[i].ic.unsat;
-        elem[i].ws.gw    = elem[i].ic.gw;
+        elem[i].ws.surf  = init->ic[i].surf;
+        elem[i].ws.unsat = init->ic[i].unsat;
+        elem[i].ws.gw    = init->ic[i].gw;
 
-        NV_Ith(CV_Y, SURF(i))  = elem[i].ic.surf;
-        NV_Ith(CV_Y, UNSAT(i)) = elem[i].ic.unsat;
-        NV_Ith(CV_Y, GW(i))    = elem[i].ic.gw;
+        NV_Ith(CV_Y, SURF(i))  = init->ic[i].surf;
+        NV_Ith(CV_Y, UNSAT(i)) = init->ic[i].unsat;
+        NV_Ith(CV_Y, GW(i))    = init->ic[i].gw;
 
 #if defined(_DGW_)
-        elem[i].ws.unsat_geol = elem[i].ic.unsat_geol;
-        elem[i].ws.gw_geol    = elem[i].ic.gw_geol;
+        elem[i].ws.unsat_geol = init->ic[i].unsat_geol;
+        elem[i].ws.gw_geol    = init->ic[i].gw_geol;
 
-        NV_Ith(CV_Y, UNSAT_GEOL(i)) = elem[i].ic.unsat_geol;
-        NV_Ith(CV_Y, GW_GEOL(i))    = elem[i].ic.gw_geol;
+        NV_Ith(CV_Y, UNSAT_GEOL(i)) = init->ic[i].unsat_geol;
+        NV_Ith(CV_Y, GW_GEOL(i))    = init->ic[i].gw_geol;
 #endif
 
 #if defined(_NOAH_)
         int             j;
 
-        elem[i].es.t1    = elem[i].ic.t1;
-        elem[i].ps.snowh = elem[i].ic.snowh;
+        elem[i].es.t1    = init->ic[i].t1;
+        elem[i].ps.snowh = init->ic[i].snowh;
 
         for (j = 0; j < MAXLYR; j++)
         {
-            elem[i].es.stc[j] = elem[i].ic.stc[j];
-            elem[i].ws.smc[j] = elem[i].ic.smc[j];
-            elem[i].ws.swc[j] = elem[i].ic.swc[j];
+            elem[i].es.stc[j] = init->ic[i].stc[j];
+            elem[i].ws.smc[j] = init->ic[i].smc[j];
+            elem[i].ws.swc[j] = init->ic[i].swc[j];
         }
 #endif
 
@@ -593,9 +629,9 @@ void InitVar(elem_struct elem[], river_struct river[], N_Vector CV_Y)
 #endif
     for (i = 0; i < nriver; i++)
     {
-        river[i].ws.stage = river[i].ic.stage;
+        river[i].ws.stage = init->river_ic[i].stage;
 
-        NV_Ith(CV_Y, RIVER(i)) = river[i].ic.stage;
+        NV_Ith(CV_Y, RIVER(i)) = init->river_ic[i].stage;
     }
 
     /* Other variables */
@@ -774,3 +810,47 @@ void InitEFlux(eflux_struct *ef)
     ef->swabs_per_plaishade = 0.0;
 #endif
 }
+
+void NewInit(init_struct *init)
+{
+    /* Side tables of initial conditions and restart inputs, indexed like
+     * elements and river segments */
+    init->ic = (ic_struct *)malloc(nelem * sizeof(ic_struct));
+    init->river_ic = (river_ic_struct *)malloc(nriver *
+        sizeof(river_ic_struct));
+#if defined(_BGC_)
+# if defined(_LUMPEDBGC_)
+    init->bgcic = (bgcic_struct *)malloc((nelem + 1) * sizeof(bgcic_struct));
+# else
+    init->bgcic = (bgcic_struct *)malloc(nelem * sizeof(bgcic_struct));
+# endif
+# if !defined(_LUMPEDBGC_) && !defined(_LEACHING_)
+    init->river_bgcic = (river_bgcic_struct *)malloc(nriver *
+        sizeof(river_bgcic_struct));
+# endif
+#endif
+#if defined(_CYCLES_)
+    init->agic = (agic_struct *)malloc(nelem * sizeof(agic_struct));
+#endif
+#if defined(_RT_)
+    init->rtic = (rtic_struct *)malloc(nelem * NCHMVOL * sizeof(rtic_struct));
+#endif
+}
+
+void FreeInit(init_struct *init)
+{
+    free(init->ic);
+    free(init->river_ic);
+#if defined(_BGC_)
+    free(init->bgcic);
+# if !defined(_LUMPEDBGC_) && !defined(_LEACHING_)
+    free(init->river_bgcic);
+# endif
+#endif
+#if defined(_CYCLES_)
+    free(init->agic);
+#endif
+#if defined(_RT_)
+    free(init->rtic);
+#endif
+}
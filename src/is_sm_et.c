@@ -1,8 +1,7 @@
 #include "pihm.h"
 
 #if !defined(_NOAH_)
-void IntcpSnowEt(int t, double stepsize, const calib_struct *calib,
-    elem_struct elem[])
+void IntcpSnowEt(int t, double stepsize, elem_struct elem[])
 {
     int             i;
     const double    TSNOW = -3.0;
@@ -135,18 +134,18 @@ void IntcpSnowEt(int t, double stepsize, const calib_struct *calib,
                 intcp_max, elem[i].lc.cfactr) * etp;
             elem[i].wf.ec = (elem[i].wf.ec < 0.0) ? 0.0 : elem[i].wf.ec;
 
-            fr = 1.1 * radnet / (elem[i].epc.rgl * lai);
+            fr = 1.1 * radnet / (elem[i].epc->rgl * lai);
             fr = (fr < 0.0) ? 0.0 : fr;
             alphar =
-                (1.0 + fr) / (fr + (elem[i].epc.rsmin / elem[i].epc.rsmax));
+                (1.0 + fr) / (fr + (elem[i].epc->rsmin / elem[i].epc->rsmax));
             alphar = (alphar > 10000.0) ? 10000.0 : alphar;
             etas =
-                1.0 - 0.0016 * (pow((elem[i].epc.topt - 273.15 - sfctmp), 2));
+                1.0 - 0.0016 * (pow((elem[i].epc->topt - 273.15 - sfctmp), 2));
             etas = (etas < 0.0001) ? 0.0001 : etas;
             gammas = 1.0 / (1.0 + 0.00025 * (vp / rh - vp));
             gammas = (gammas < 0.01) ? 0.01 : gammas;
-            rs = elem[i].epc.rsmin * alphar / (betas * lai * etas * gammas);
-            rs = (rs > elem[i].epc.rsmax) ? elem[i].epc.rsmax : rs;
+            rs = elem[i].epc->rsmin * alphar / (betas * lai * etas * gammas);
+            rs = (rs > elem[i].epc->rsmax) ? elem[i].epc->rsmax : rs;
 
             pc = (1.0 + delta / gamma) / (1.0 + rs / ra + delta / gamma);
 
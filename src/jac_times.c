@@ -0,0 +1,394 @@
+#include "pihm.h"
+
+void InitJacTimes(jtimes_struct *jtimes)
+{
+    jtimes->elem = (jvelem_struct *)malloc(nelem * sizeof(jvelem_struct));
+    jtimes->river = (jvriver_struct *)malloc(nriver * sizeof(jvriver_struct));
+    jtimes->dh_dx = (double *)malloc(nelem * sizeof(double));
+    jtimes->dh_dy = (double *)malloc(nelem * sizeof(double));
+}
+
+void FreeJacTimes(jtimes_struct *jtimes)
+{
+    free(jtimes->elem);
+    free(jtimes->river);
+    free(jtimes->dh_dx);
+    free(jtimes->dh_dy);
+}
+
+int JacTimesSetup(realtype t, N_Vector CV_Y, N_Vector fy, void *pihm_data)
+{
+    /*
+     * Evaluate flux derivatives at the current solution. CVODE calls this
+     * function before each linear solve, right after evaluating Ode at CV_Y,
+     * so the water states in elem and river are up to date
+     */
+    int             i;
+    pihm_struct     pihm;
+    elem_struct    *elem;
+    river_struct   *river;
+    jtimes_struct  *jtimes;
+
+    pihm = (pihm_struct)pihm_data;
+
+    elem = &pihm->elem[0];
+    river = &pihm->river[0];
+    jtimes = &pihm->jtimes;
+
+    /* FrictionSlope shares its loop among the threads of a parallel region */
+#if defined(_OPENMP)
+# pragma omp parallel
+#endif
+    FrictionSlope(&pihm->hydro, river, jtimes->dh_dx, jtimes->dh_dy);
+
+#if defined(_OPENMP)
+# pragma omp parallel for
+#endif
+    for (i = 0; i < nelem; i++)
+    {
+        int             j;
+        double          avg_sf;
+        elem_struct    *nabr;
+        jvelem_struct  *jv;
+
+        jv = &jtimes->elem[i];
+
+        /* Vertical fluxes */
+        ElemVertJac((double)pihm->ctrl.stepsize, pihm->ctrl.abstol, &elem[i],
+            jv->vert);
+
+        /* Lateral fluxes. Fluxes to river segments are added in the river loop
+         */
+        for (j = 0; j < NUM_EDGE; j++)
+        {
+            jv->ovl[j][0] = 0.0;
+            jv->ovl[j][1] = 0.0;
+            jv->sub[j][0] = 0.0;
+            jv->sub[j][1] = 0.0;
+            jv->sub[j][2] = 0.0;
+
+            if (elem[i].nabr[j] == 0)
+            {
+                jv->sub[j][0] = DBoundFluxElem(elem[i].attrib.bc[j], j,
+                    &elem[i].topo, &elem[i].soil, &elem[i].bc, &elem[i].ws);
+            }
+            else
+            {
+                nabr = &elem[elem[i].nabr[j] - 1];
+
+                DSubsurfFlow(j, &elem[i], nabr, jv->sub[j]);
+
+                if (elem[i].nabr_river[j] == 0)
+                {
+                    avg_sf = 0.5 * (sqrt(jtimes->dh_dx[i] * jtimes->dh_dx[i] +
+                        jtimes->dh_dy[i] * jtimes->dh_dy[i]) +
+                        sqrt(jtimes->dh_dx[nabr->ind - 1] *
+                        jtimes->dh_dx[nabr->ind - 1] +
+                        jtimes->dh_dy[nabr->ind - 1] *
+                        jtimes->dh_dy[nabr->ind - 1]));
+
+                    DOvlFlowElemToElem(j, avg_sf, &elem[i], nabr, jv->ovl[j]);
+                }
+            }
+
+#if defined(_DGW_)
+            if (elem[i].nabr[j] == 0)
+            {
+                jv->dgw[j][0] = DDeepBoundFluxElem(elem[i].attrib.bc_geol[j],
+                    j, &elem[i].topo, &elem[i].geol, &elem[i].bc_geol,
+                    &elem[i].ws);
+                jv->dgw[j][1] = 0.0;
+            }
+            else
+            {
+                DDeepFlowElemToElem(elem[i].topo.dist_nabr[j],
+                    elem[i].topo.edge[j], &elem[i], &elem[elem[i].nabr[j] - 1],
+                    jv->dgw[j]);
+            }
+#endif
+        }
+    }
+
+#if defined(_OPENMP)
+# pragma omp parallel for
+#endif
+    for (i = 0; i < nriver; i++)
+    {
+        const double    SRUR = sqrt(UNIT_ROUNDOFF);
+        double          inc;
+        river_wstate_struct ws;
+        jvriver_struct *jv;
+        int             k;
+
+        jv = &jtimes->river[i];
+
+        jv->self = 0.0;
+        jv->down[0] = 0.0;
+        jv->down[1] = 0.0;
+
+        /* Boundary and outlet fluxes only depend on the stage of the segment,
+         * and are differenced locally */
+        ws = river[i].ws;
+        inc = SRUR * MAX(ws.stage, pihm->ctrl.abstol);
+        ws.stage += inc;
+
+        if (river[i].down > 0)
+        {
+            if (river[i].attrib.riverbc_type != 0)
+            {
+                jv->self += (BoundFluxRiver(river[i].attrib.riverbc_type,
+                    &river[i].topo, &river[i].shp, &river[i].matl,
+                    &river[i].bc, &ws) -
+                    BoundFluxRiver(river[i].attrib.riverbc_type,
+                    &river[i].topo, &river[i].shp, &river[i].matl,
+                    &river[i].bc, &river[i].ws)) / inc;
+            }
+
+            DChannelFlowRiverToRiver(&river[i], &river[river[i].down - 1],
+                jv->down);
+
+            jv->self += jv->down[0];
+        }
+        else
+        {
+            jv->self += (OutletFlux(river[i].down, &river[i].topo,
+                &river[i].shp, &river[i].matl, &river[i].bc, &ws) -
+                OutletFlux(river[i].down, &river[i].topo, &river[i].shp,
+                &river[i].matl, &river[i].bc, &river[i].ws)) / inc;
+        }
+
+        /* Fluxes between river segment and bank elements */
+        for (k = 0; k < 2; k++)
+        {
+            int             bank_ind;
+            int             j;
+            double          dist;
+            double          dovl[2];
+            double          daqf[2];
+            elem_struct    *bank;
+            jvelem_struct  *jvbank;
+
+            bank_ind = (k == 0) ? river[i].left : river[i].right;
+            dist = (k == 0) ?
+                river[i].topo.dist_left : river[i].topo.dist_right;
+
+            jv->surf[k] = 0.0;
+            jv->gw[k] = 0.0;
+
+            if (bank_ind <= 0)
+            {
+                continue;
+            }
+
+            bank = &elem[bank_ind - 1];
+            jvbank = &jtimes->elem[bank_ind - 1];
+
+            DOvlFlowElemToRiver(&river[i], bank, dovl);
+            DChannelFlowElemToRiver(EffKh(bank->ws.gw, &bank->soil),
+                DEffKh(bank->ws.gw, &bank->soil), dist, &river[i], bank, daqf);
+
+            jv->self += dovl[0] + daqf[0];
+            jv->surf[k] = dovl[1];
+            jv->gw[k] = daqf[1];
+
+            for (j = 0; j < NUM_EDGE; j++)
+            {
+                if (bank->nabr_river[j] == river[i].ind)
+                {
+                    jvbank->ovl[j][0] = -dovl[1];
+                    jvbank->ovl[j][1] = -dovl[0];
+                    jvbank->sub[j][0] -= daqf[1];
+                    jvbank->sub[j][2] = -daqf[0];
+                    break;
+                }
+            }
+        }
+    }
+
+    return 0;
+}
+
+int JacTimesVec(N_Vector v, N_Vector Jv, realtype t, N_Vector CV_Y,
+    N_Vector fy, void *pihm_data, N_Vector tmp)
+{
+    /*
+     * Jacobian-times-vector product assembled from the flux derivatives saved
+     * by JacTimesSetup. Rows are built the same way as in Ode
+     */
+    int             i;
+    double         *y;
+    double         *vv;
+    double         *jvv;
+    pihm_struct     pihm;
+    elem_struct    *elem;
+    river_struct   *river;
+    jtimes_struct  *jtimes;
+
+    y = NV_DATA(CV_Y);
+    vv = NV_DATA(tmp);
+    jvv = NV_DATA(Jv);
+    pihm = (pihm_struct)pihm_data;
+
+    elem = &pihm->elem[0];
+    river = &pihm->river[0];
+    jtimes = &pihm->jtimes;
+
+    /* Ode sees negative storages as zero, so the RHS does not depend on them.
+     * Those components of v are masked out */
+    N_VScale(1.0, v, tmp);
+
+#if defined(_OPENMP)
+# pragma omp parallel for
+#endif
+    for (i = 0; i < nelem; i++)
+    {
+        vv[SURF(i)] = (y[SURF(i)] < 0.0) ? 0.0 : vv[SURF(i)];
+        vv[UNSAT(i)] = (y[UNSAT(i)] < 0.0) ? 0.0 : vv[UNSAT(i)];
+        vv[GW(i)] = (y[GW(i)] < 0.0) ? 0.0 : vv[GW(i)];
+#if defined(_DGW_)
+        vv[UNSAT_GEOL(i)] = (y[UNSAT_GEOL(i)] < 0.0) ?
+            0.0 : vv[UNSAT_GEOL(i)];
+        vv[GW_GEOL(i)] = (y[GW_GEOL(i)] < 0.0) ? 0.0 : vv[GW_GEOL(i)];
+#endif
+    }
+
+#if defined(_OPENMP)
+# pragma omp parallel for
+#endif
+    for (i = 0; i < nriver; i++)
+    {
+        vv[RIVER(i)] = (y[RIVER(i)] < 0.0) ? 0.0 : vv[RIVER(i)];
+    }
+
+    N_VConst(0.0, Jv);
+
+#if defined(_OPENMP)
+# pragma omp parallel for
+#endif
+    for (i = 0; i < nelem; i++)
+    {
+        int             j, k;
+        int             nabr, rnabr;
+        double          vs[NUM_ELEM_HYDROL];
+        double          jvs[NUM_ELEM_HYDROL];
+        const jvelem_struct *jv;
+
+        jv = &jtimes->elem[i];
+
+        vs[0] = vv[SURF(i)];
+        vs[1] = vv[UNSAT(i)];
+        vs[2] = vv[GW(i)];
+#if defined(_DGW_)
+        vs[3] = vv[UNSAT_GEOL(i)];
+        vs[4] = vv[GW_GEOL(i)];
+#endif
+
+        /* Vertical fluxes */
+        for (k = 0; k < NUM_ELEM_HYDROL; k++)
+        {
+            jvs[k] = 0.0;
+            for (j = 0; j < NUM_ELEM_HYDROL; j++)
+            {
+                jvs[k] += jv->vert[j][k] * vs[j];
+            }
+        }
+
+        /* Lateral fluxes */
+        for (j = 0; j < NUM_EDGE; j++)
+        {
+            double          dovl;
+            double          dsub;
+
+            nabr = elem[i].nabr[j] - 1;
+            rnabr = elem[i].nabr_river[j] - 1;
+
+            dovl = jv->ovl[j][0] * vs[0];
+            dsub = jv->sub[j][0] * vs[2];
+
+            if (rnabr >= 0)
+            {
+                dovl += jv->ovl[j][1] * vv[RIVER(rnabr)];
+                dsub += jv->sub[j][2] * vv[RIVER(rnabr)];
+            }
+            else if (nabr >= 0)
+            {
+                dovl += jv->ovl[j][1] * vv[SURF(nabr)];
+            }
+
+            if (nabr >= 0)
+            {
+                dsub += jv->sub[j][1] * vv[GW(nabr)];
+            }
+
+            jvs[0] -= dovl / elem[i].topo.area;
+            jvs[2] -= dsub / elem[i].topo.area / elem[i].soil.porosity;
+
+#if defined(_DGW_)
+            jvs[4] -= (jv->dgw[j][0] * vs[4] +
+                ((nabr >= 0) ? jv->dgw[j][1] * vv[GW_GEOL(nabr)] : 0.0)) /
+                elem[i].topo.area / elem[i].geol.porosity;
+#endif
+        }
+
+        jvv[SURF(i)] = jvs[0];
+        jvv[UNSAT(i)] = jvs[1];
+        jvv[GW(i)] = jvs[2];
+#if defined(_DGW_)
+        jvv[UNSAT_GEOL(i)] = jvs[3];
+        jvv[GW_GEOL(i)] = jvs[4];
+#endif
+    }
+
+#if defined(_OPENMP)
+# pragma omp parallel for
+#endif
+    for (i = 0; i < nriver; i++)
+    {
+        double          dflux;
+        const jvriver_struct *jv;
+
+        jv = &jtimes->river[i];
+
+        dflux = jv->self * vv[RIVER(i)];
+
+        if (river[i].down > 0)
+        {
+            dflux += jv->down[1] * vv[RIVER(river[i].down - 1)];
+        }
+
+        if (river[i].left > 0)
+        {
+            dflux += jv->surf[0] * vv[SURF(river[i].left - 1)] +
+                jv->gw[0] * vv[GW(river[i].left - 1)];
+        }
+
+        if (river[i].right > 0)
+        {
+            dflux += jv->surf[1] * vv[SURF(river[i].right - 1)] +
+                jv->gw[1] * vv[GW(river[i].right - 1)];
+        }
+
+        jvv[RIVER(i)] = -dflux / river[i].topo.area;
+    }
+
+    /*
+     * Accumulate inflow derivatives for down segments
+     * NOTE: Summation must be calculated outside OMP to avoid different
+     * threads accessing the same variable at the same time
+     */
+    for (i = 0; i < nriver; i++)
+    {
+        int             down;
+
+        if (river[i].down > 0)
+        {
+            down = river[i].down - 1;
+
+            jvv[RIVER(down)] += (jtimes->river[i].down[0] * vv[RIVER(i)] +
+                jtimes->river[i].down[1] * vv[RIVER(down)]) /
+                river[down].topo.area;
+        }
+    }
+
+    return 0;
+}
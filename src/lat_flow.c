@@ -1,135 +1,183 @@
 #include "pihm.h"
 
-void LateralFlow(const river_struct river[], elem_struct elem[])
+void LateralFlow(const river_struct river[], scratch_struct scratch[],
+    hydro_struct *hydro, elem_struct elem[])
 {
-    int             i;
+    /*
+     * Element-to-element fluxes gather neighbor states and parameters from the
+     * structure-of-arrays mirror, so that cold element structures are only
+     * touched to store the fluxes of each element. Each interface is evaluated
+     * once and its fluxes are stored on both sides. Called in the parallel
+     * region of Ode. Fluxes are stored without a barrier at the end
+     */
+    int             f;
     double         *dh_dx;
     double         *dh_dy;
+    double         *sf;
+    scratch_struct *ws;
 
-    dh_dx = (double *)malloc(nelem * sizeof(double));
-    dh_dy = (double *)malloc(nelem * sizeof(double));
+    /* Whole-domain temporaries are borrowed from the arena of the master
+     * thread by one thread, and shared with the others. The barrier at the end
+     * of the single construct also waits for surface water depths of all
+     * elements */
+    ws = &scratch[0];
+
+#if defined(_OPENMP)
+# pragma omp single copyprivate(dh_dx, dh_dy, sf)
+#endif
+    {
+        dh_dx = ScratchAlloc(nelem, ws);
+        dh_dy = ScratchAlloc(nelem, ws);
+        sf = ScratchAlloc(nelem, ws);
+    }
 
-    FrictionSlope(elem, river, dh_dx, dh_dy);
+    FrictionSlope(hydro, river, dh_dx, dh_dy);
 
+    /* Same partition as FrictionSlope */
 #if defined(_OPENMP)
-# pragma omp parallel for
+# pragma omp for schedule(static)
 #endif
-    for (i = 0; i < nelem; i++)
+    for (f = 0; f < nelem; f++)
+    {
+        sf[f] = sqrt(dh_dx[f] * dh_dx[f] + dh_dy[f] * dh_dy[f]);
+    }
+
+    /* Boundary condition flux */
+#if defined(_OPENMP)
+# pragma omp for schedule(static) nowait
+#endif
+    for (f = 0; f < hydro->nbound; f++)
     {
+        int             i;
         int             j;
-        double          avg_sf;
-        elem_struct    *nabr;
 
-        for (j = 0; j < NUM_EDGE; j++)
-        {
-            if (elem[i].nabr[j] == 0)       /* Boundary condition flux */
-            {
-                BoundFluxElem(elem[i].attrib.bc[j], j, &elem[i].topo,
-                    &elem[i].soil, &elem[i].bc, &elem[i].ws, &elem[i].wf);
-            }
-            else
-            {
-                nabr = &elem[elem[i].nabr[j] - 1];
-
-                /* Subsurface flow between triangular elements */
-                elem[i].wf.subsurf[j] = SubsurfFlow(j, &elem[i], nabr);
-
-                /* Surface flow between triangular elements */
-                if (elem[i].nabr_river[j] == 0)
-                {
-                    /* Surface flux between triangular elements */
-                    /* avg_sf not needed in kinematic mode */
-                    avg_sf = 0.5 *
-                        (sqrt(dh_dx[i] * dh_dx[i] + dh_dy[i] * dh_dy[i]) +
-                        sqrt(dh_dx[nabr->ind - 1] * dh_dx[nabr->ind - 1] +
-                        dh_dy[nabr->ind - 1] * dh_dy[nabr->ind - 1]));
-
-                    elem[i].wf.overland[j] = OvlFlowElemToElem(j, avg_sf,
-                        &elem[i], nabr);
-                }
-            }
-        }    /* End of neighbor loop */
-    }    /* End of element loop */
+        i = hydro->bound[f] / NUM_EDGE;
+        j = hydro->bound[f] % NUM_EDGE;
+
+        BoundFluxElem(elem[i].attrib.bc[j], j, &elem[i].topo, &elem[i].soil,
+            &elem[i].bc, &elem[i].ws, &elem[i].wf);
+    }
+
+    InterfaceFlux(sf, hydro);
+
+#if defined(_OPENMP)
+# pragma omp single nowait
+#endif
+    ScratchRelease(dh_dx, ws);
+
+    /* Store interface fluxes on both sides. Overland fluxes of interfaces with
+     * a river segment are computed by RiverFlow */
+#if defined(_OPENMP)
+# pragma omp for schedule(static) nowait
+#endif
+    for (f = 0; f < hydro->nface; f++)
+    {
+        int             k, kn;
+
+        k = hydro->face[2 * f];
+        kn = hydro->face[2 * f + 1];
+
+        elem[k / NUM_EDGE].wf.subsurf[k % NUM_EDGE] = hydro->qsub[f];
+        elem[kn / NUM_EDGE].wf.subsurf[kn % NUM_EDGE] = -hydro->qsub[f];
 
-    free(dh_dx);
-    free(dh_dy);
+        if (hydro->nabr_river[k] < 0)
+        {
+            elem[k / NUM_EDGE].wf.overland[k % NUM_EDGE] = hydro->qovl[2 * f];
+            elem[kn / NUM_EDGE].wf.overland[kn % NUM_EDGE] =
+                hydro->qovl[2 * f + 1];
+        }
+    }
 
 #if defined(_DGW_)
     /*
      * Lateral deep groundwater flow
      */
 # if defined(_OPENMP)
-#  pragma omp parallel for
+#  pragma omp for schedule(static) nowait
 # endif
-    for (i = 0; i < nelem; i++)
+    for (f = 0; f < hydro->nbound; f++)
     {
+        int             i;
         int             j;
-        elem_struct    *nabr;
 
-        for (j = 0; j < NUM_EDGE; j++)
-        {
-            if (elem[i].nabr[j] == 0)
-            {
-                elem[i].wf.dgw[j] =
-                    DeepBoundFluxElem(elem[i].attrib.bc_geol[j], j,
-                    &elem[i].topo, &elem[i].geol, &elem[i].bc_geol,
-                    &elem[i].ws);
-            }
-            else
-            {
-                nabr = &elem[elem[i].nabr[j] - 1];
+        i = hydro->bound[f] / NUM_EDGE;
+        j = hydro->bound[f] % NUM_EDGE;
 
-                /* Groundwater flow modeled by Darcy's Law */
-                elem[i].wf.dgw[j] =
-                    DeepFlowElemToElem(elem[i].topo.dist_nabr[j],
-                        elem[i].topo.edge[j], &elem[i], nabr);
-            }
-        }
+        elem[i].wf.dgw[j] = DeepBoundFluxElem(elem[i].attrib.bc_geol[j], j,
+            &elem[i].topo, &elem[i].geol, &elem[i].bc_geol, &elem[i].ws);
+    }
+
+# if defined(_OPENMP)
+#  pragma omp for schedule(static) nowait
+# endif
+    for (f = 0; f < hydro->nface; f++)
+    {
+        int             k, kn;
+        int             i, nabr;
+        double          flux;
+
+        k = hydro->face[2 * f];
+        kn = hydro->face[2 * f + 1];
+        i = k / NUM_EDGE;
+        nabr = kn / NUM_EDGE;
+
+        /* Groundwater flow modeled by Darcy's Law */
+        flux = DeepFlowElemToElem(hydro->dist_nabr[k], hydro->edge[k],
+            &elem[i], &elem[nabr]);
+        elem[i].wf.dgw[k % NUM_EDGE] = flux;
+        elem[nabr].wf.dgw[kn % NUM_EDGE] = -flux;
     }
 #endif
 }
 
-void FrictionSlope(const elem_struct elem[], const river_struct river[],
+void FrictionSlope(const hydro_struct *hydro, const river_struct river[],
     double dh_dx[], double dh_dy[])
 {
+    /*
+     * Shares elements among the threads of the enclosing parallel region,
+     * without a barrier at the end
+     */
     int             i;
+
 #if defined(_OPENMP)
-# pragma omp parallel for
+# pragma omp for schedule(static) nowait
 #endif
     for (i = 0; i < nelem; i++)
     {
         int             j;
+        int             k;
+        int             nabr;
         double          surfh[NUM_EDGE];
         double          x[NUM_EDGE];
         double          y[NUM_EDGE];
-        const elem_struct *nabr;
         const river_struct *river_nabr;
 
         for (j = 0; j < NUM_EDGE; j++)
         {
-            if (elem[i].nabr[j] == 0)
+            k = NUM_EDGE * i + j;
+            nabr = hydro->nabr[k];
+
+            if (nabr < 0)
             {
-                surfh[j] = elem[i].topo.zmax + elem[i].ws.surfh;
-                x[j] = elem[i].topo.x_nabr[j];
-                y[j] = elem[i].topo.y_nabr[j];
+                surfh[j] = hydro->zmax[i] + hydro->surfh[i];
+                x[j] = hydro->x_nabr[k];
+                y[j] = hydro->y_nabr[k];
             }
-            else if (elem[i].nabr_river[j] == 0)
+            else if (hydro->nabr_river[k] < 0)
             {
-                nabr = &elem[elem[i].nabr[j] - 1];
-
-                surfh[j] = nabr->topo.zmax + nabr->ws.surfh;
-                x[j] = elem[i].topo.x_nabr[j];
-                y[j] = elem[i].topo.y_nabr[j];
+                surfh[j] = hydro->zmax[nabr] + hydro->surfh[nabr];
+                x[j] = hydro->x_nabr[k];
+                y[j] = hydro->y_nabr[k];
             }
             else
             {
-                river_nabr = &river[elem[i].nabr_river[j] - 1];
+                river_nabr = &river[hydro->nabr_river[k]];
 
                 surfh[j] = (river_nabr->ws.stage > river_nabr->shp.depth) ?
                     river_nabr->topo.zbed + river_nabr->ws.stage :
                     river_nabr->topo.zmax;
-                x[j] = river[elem[i].nabr_river[j] - 1].topo.x;
-                y[j] = river[elem[i].nabr_river[j] - 1].topo.y;
+                x[j] = river_nabr->topo.x;
+                y[j] = river_nabr->topo.y;
             }
         }
 
@@ -191,12 +239,16 @@ double EffKh(double gw, const soil_struct *soil)
 double OverLandFlow(double avg_h, double grad_h, double avg_sf,
     double cross_area, double avg_rough)
 {
-    return cross_area * pow(avg_h, 0.6666667) * grad_h /
+    return cross_area * pow(avg_h, 2.0 / 3.0) * grad_h /
         (sqrt(avg_sf) * avg_rough);
 }
 
 double SubsurfFlow(int j, const elem_struct *elem_ptr, const elem_struct *nabr)
 {
+    /*
+     * Scalar form of the subsurface flux of InterfaceFlux, which is checked
+     * against it (see CheckFluxKernels)
+     */
     double          diff_h;
     double          avg_h;
     double          grad_h;
@@ -223,6 +275,10 @@ double SubsurfFlow(int j, const elem_struct *elem_ptr, const elem_struct *nabr)
 double OvlFlowElemToElem(int j, double avg_sf, const elem_struct *elem_ptr,
     const elem_struct *nabr)
 {
+    /*
+     * Scalar form of the overland flux of InterfaceFlux out of the element,
+     * which is checked against it (see CheckFluxKernels)
+     */
     double          diff_h;
     double          avg_h;
     double          grad_h;
@@ -240,6 +296,107 @@ double OvlFlowElemToElem(int j, double avg_sf, const elem_struct *elem_ptr,
     return OverLandFlow(avg_h, grad_h, avg_sf, cross_area, avg_rough);
 }
 
+double DEffKh(double gw, const soil_struct *soil)
+{
+    /* Derivative of EffKh with respect to groundwater storage */
+    double          k1, k2;
+    double          d1, d2;
+
+    if (gw > soil->depth - soil->dmac && gw <= soil->depth && gw > 0.0)
+    {
+        k1 = soil->kmach * soil->areafv + soil->ksath * (1.0 - soil->areafv);
+        k2 = soil->ksath;
+
+        d1 = gw - (soil->depth - soil->dmac);
+        d2 = soil->depth - soil->dmac;
+
+        return (k1 - (k1 * d1 + k2 * d2) / (d1 + d2)) / (d1 + d2);
+    }
+    else
+    {
+        return 0.0;
+    }
+}
+
+void DSubsurfFlow(int j, const elem_struct *elem_ptr, const elem_struct *nabr,
+    double dflux[])
+{
+    /*
+     * Derivatives of SubsurfFlow with respect to groundwater storage of the
+     * element (dflux[0]) and of the neighbor (dflux[1])
+     */
+    double          diff_h;
+    double          avg_h;
+    double          grad_h;
+    double          avg_ksat;
+    double          dist;
+    double          edge;
+
+    dist = elem_ptr->topo.dist_nabr[j];
+    edge = elem_ptr->topo.edge[j];
+
+    diff_h = (elem_ptr->ws.gw + elem_ptr->topo.zmin) -
+        (nabr->ws.gw + nabr->topo.zmin);
+    avg_h = AvgH(diff_h, elem_ptr->ws.gw, nabr->ws.gw);
+    grad_h = diff_h / dist;
+    avg_ksat = 0.5 * (EffKh(elem_ptr->ws.gw, &elem_ptr->soil) +
+        EffKh(nabr->ws.gw, &nabr->soil));
+
+    dflux[0] = edge * (0.5 * DEffKh(elem_ptr->ws.gw, &elem_ptr->soil) *
+        grad_h * avg_h + avg_ksat * avg_h / dist +
+        ((diff_h > 0.0 && elem_ptr->ws.gw > 0.0) ?
+        avg_ksat * grad_h : 0.0));
+
+    dflux[1] = edge * (0.5 * DEffKh(nabr->ws.gw, &nabr->soil) *
+        grad_h * avg_h - avg_ksat * avg_h / dist +
+        ((diff_h <= 0.0 && nabr->ws.gw > 0.0) ? avg_ksat * grad_h : 0.0));
+}
+
+void DOvlFlowElemToElem(int j, double avg_sf, const elem_struct *elem_ptr,
+    const elem_struct *nabr, double dflux[])
+{
+    /*
+     * Derivatives of OvlFlowElemToElem with respect to equivalent surface water
+     * of the element (dflux[0]) and of the neighbor (dflux[1]). The friction
+     * slope is treated as constant
+     */
+    double          diff_h;
+    double          avg_h;
+    double          grad_h;
+    double          avg_rough;
+    double          coeff;
+    double          dq_dh;
+    double          dq_dgrad;
+
+    diff_h = (elem_ptr->ws.surfh + elem_ptr->topo.zmax) -
+        (nabr->ws.surfh + nabr->topo.zmax);
+    avg_h = AvgHsurf(diff_h, elem_ptr->ws.surfh, nabr->ws.surfh);
+    grad_h = MAX(diff_h / elem_ptr->topo.dist_nabr[j], GRADMIN);
+    avg_sf = MAX(avg_sf, GRADMIN);
+    avg_rough = 0.5 * (elem_ptr->lc.rough + nabr->lc.rough);
+
+    dflux[0] = 0.0;
+    dflux[1] = 0.0;
+
+    if (avg_h <= 0.0)
+    {
+        return;
+    }
+
+    /* Flux = coeff * avg_h ^ (5 / 3) * grad_h */
+    coeff = elem_ptr->topo.edge[j] / (sqrt(avg_sf) * avg_rough);
+    dq_dh = coeff * 5.0 / 3.0 * pow(avg_h, 2.0 / 3.0) * grad_h;
+    dq_dgrad = (diff_h / elem_ptr->topo.dist_nabr[j] > GRADMIN) ?
+        coeff * avg_h * pow(avg_h, 2.0 / 3.0) / elem_ptr->topo.dist_nabr[j] :
+        0.0;
+
+    dflux[0] = ((diff_h > 0.0) ? dq_dh : 0.0) + dq_dgrad;
+    dflux[1] = ((diff_h > 0.0) ? 0.0 : dq_dh) - dq_dgrad;
+
+    dflux[0] *= DSurfH(elem_ptr->ws.surf);
+    dflux[1] *= DSurfH(nabr->ws.surf);
+}
+
 void BoundFluxElem(int bc_type, int j, const topo_struct *topo,
     const soil_struct *soil, const bc_struct *bc, const wstate_struct *ws,
     wflux_struct *wf)
@@ -279,6 +436,33 @@ void BoundFluxElem(int bc_type, int j, const topo_struct *topo,
     }
 }
 
+double DBoundFluxElem(int bc_type, int j, const topo_struct *topo,
+    const soil_struct *soil, const bc_struct *bc, const wstate_struct *ws)
+{
+    /* Derivative of boundary subsurface flux with respect to groundwater
+     * storage */
+    double          diff_h;
+    double          avg_h;
+    double          grad_h;
+    double          effk;
+
+    if (bc_type > 0)
+    {
+        diff_h = ws->gw + topo->zmin - bc->head[j];
+        avg_h = AvgH(diff_h, ws->gw, bc->head[j] - topo->zmin);
+        effk = EffKh(ws->gw, soil);
+        grad_h = diff_h / topo->dist_nabr[j];
+
+        return topo->edge[j] * (DEffKh(ws->gw, soil) * grad_h * avg_h +
+            effk * avg_h / topo->dist_nabr[j] +
+            ((diff_h > 0.0 && ws->gw > 0.0) ? effk * grad_h : 0.0));
+    }
+    else
+    {
+        return 0.0;
+    }
+}
+
 #if defined(_DGW_)
 double DeepFlowElemToElem(double distance, double edge,
     const elem_struct *elem_ptr, const elem_struct *nabr)
@@ -334,4 +518,58 @@ double DeepBoundFluxElem(int bc_type, int j, const topo_struct *topo,
 
     return flux;
 }
+
+void DDeepFlowElemToElem(double distance, double edge,
+    const elem_struct *elem_ptr, const elem_struct *nabr, double dflux[])
+{
+    /*
+     * Derivatives of DeepFlowElemToElem with respect to deep groundwater
+     * storage of the element (dflux[0]) and of the neighbor (dflux[1])
+     */
+    double          diff_h;
+    double          avg_h;
+    double          grad_h;
+    double          avg_ksat;
+
+    diff_h = (elem_ptr->ws.gw_geol + elem_ptr->topo.zbed) -
+        (nabr->ws.gw_geol + nabr->topo.zbed);
+    avg_h = AvgH(diff_h, elem_ptr->ws.gw_geol, nabr->ws.gw_geol);
+    grad_h = diff_h / distance;
+    avg_ksat = 0.5 * (EffKh(elem_ptr->ws.gw_geol, &elem_ptr->geol) +
+        EffKh(nabr->ws.gw_geol, &nabr->geol));
+
+    dflux[0] = edge * (0.5 * DEffKh(elem_ptr->ws.gw_geol, &elem_ptr->geol) *
+        grad_h * avg_h + avg_ksat * avg_h / distance +
+        ((diff_h > 0.0 && elem_ptr->ws.gw_geol > 0.0) ?
+        avg_ksat * grad_h : 0.0));
+
+    dflux[1] = edge * (0.5 * DEffKh(nabr->ws.gw_geol, &nabr->geol) *
+        grad_h * avg_h - avg_ksat * avg_h / distance +
+        ((diff_h <= 0.0 && nabr->ws.gw_geol > 0.0) ?
+        avg_ksat * grad_h : 0.0));
+}
+
+double DDeepBoundFluxElem(int bc_type, int j, const topo_struct *topo,
+    const soil_struct *geol, const bc_struct *bc, const wstate_struct *ws)
+{
+    /* Derivative of deep boundary flux with respect to deep groundwater
+     * storage */
+    double          diff_h;
+    double          avg_h;
+    double          grad_h;
+
+    if (bc_type > 0)
+    {
+        diff_h = ws->gw_geol + topo->zbed - bc->head[j];
+        avg_h = AvgH(diff_h, ws->gw_geol, bc->head[j] - topo->zbed);
+        grad_h = diff_h / topo->dist_nabr[j];
+
+        return geol->ksath * topo->edge[j] * (avg_h / topo->dist_nabr[j] +
+            ((diff_h > 0.0 && ws->gw_geol > 0.0) ? grad_h : 0.0));
+    }
+    else
+    {
+        return 0.0;
+    }
+}
 #endif
@@ -0,0 +1,142 @@
+#include "pihm.h"
+
+void InitSched(sched_struct sched[])
+{
+    /*
+     * Element loops of which the cost per element is uneven (snow, frozen
+     * soil, glaciers, crops, chemistry) visit elements in decreasing order of
+     * measured cost, and hand them out to threads dynamically, so that the
+     * most expensive elements are not all given to one thread. Until costs
+     * are first measured, elements are visited in index order
+     */
+    int             k;
+    int             i;
+
+    for (k = 0; k < NUM_SCHED; k++)
+    {
+        sched[k].order = (int *)malloc(nelem * sizeof(int));
+        sched[k].cost = (double *)calloc(nelem, sizeof(double));
+        sched[k].busy = (double *)calloc(nthreads, sizeof(double));
+        sched[k].ncall = 0;
+
+        for (i = 0; i < nelem; i++)
+        {
+            sched[k].order[i] = i;
+        }
+    }
+}
+
+void FreeSched(sched_struct sched[])
+{
+    int             k;
+
+    for (k = 0; k < NUM_SCHED; k++)
+    {
+        free(sched[k].order);
+        free(sched[k].cost);
+        free(sched[k].busy);
+    }
+}
+
+void SchedRecord(int i, double start, sched_struct *sched)
+{
+    /* Charge the wall time since start to element i and to the calling
+     * thread */
+    double          cost;
+
+    cost = WallClock() - start;
+
+    sched->cost[i] += cost;
+#if defined(_OPENMP)
+    sched->busy[omp_get_thread_num()] += cost;
+#else
+    sched->busy[0] += cost;
+#endif
+}
+
+void UpdateSched(int t, int k, sched_struct sched[], FILE *fp)
+{
+    /*
+     * Count one call of loop k. Every SCHED_INTVL calls, re-sort the elements
+     * by the cost measured since the latest refresh. In debug mode, the thread
+     * imbalance (slowest thread over average thread) of the interval is
+     * logged, together with the imbalance the default static partition in
+     * index order would have had with the same costs
+     */
+    const char     *name[NUM_SCHED] = { "lsm", "react", "bgc", "cycles" };
+    sched_struct   *s = &sched[k];
+    unsigned long long *key;
+    int             i;
+    int             tid;
+
+    s->ncall++;
+    if (s->ncall < SCHED_INTVL)
+    {
+        return;
+    }
+
+    if (fp != NULL)
+    {
+        double          total = 0.0;
+        double          max_busy = 0.0;
+        double          max_static = 0.0;
+        int             start = 0;
+
+        for (tid = 0; tid < nthreads; tid++)
+        {
+            total += s->busy[tid];
+            max_busy = MAX(max_busy, s->busy[tid]);
+        }
+
+        for (tid = 0; tid < nthreads; tid++)
+        {
+            double          chunk = 0.0;
+            int             end;
+
+            end = start + nelem / nthreads +
+                ((tid < nelem % nthreads) ? 1 : 0);
+            for (i = start; i < end; i++)
+            {
+                chunk += s->cost[i];
+            }
+            max_static = MAX(max_static, chunk);
+            start = end;
+        }
+
+        fprintf(fp, "%-12d%-8s%-8d%-10d%-16.6f%-10.3f%.3f\n", t, name[k],
+            s->ncall, nthreads, total,
+            (total > 0.0) ? max_busy * nthreads / total : 1.0,
+            (total > 0.0) ? max_static * nthreads / total : 1.0);
+        fflush(fp);
+    }
+
+    /* Sort keys hold the complement of the cost in ns in the upper 32 bits,
+     * and the element index in the lower 32 bits, so that ties keep index
+     * order */
+    key = (unsigned long long *)malloc(nelem * sizeof(unsigned long long));
+
+    for (i = 0; i < nelem; i++)
+    {
+        double          ns;
+
+        ns = MIN(s->cost[i] * 1.0E9, (double)0xffffffffULL);
+        key[i] = ((0xffffffffULL - (unsigned long long)ns) << 32) |
+            (unsigned long long)i;
+    }
+
+    qsort(key, nelem, sizeof(unsigned long long), CompareKey);
+
+    for (i = 0; i < nelem; i++)
+    {
+        s->order[i] = (int)(key[i] & 0xffffffffULL);
+        s->cost[i] = 0.0;
+    }
+
+    for (tid = 0; tid < nthreads; tid++)
+    {
+        s->busy[tid] = 0.0;
+    }
+    s->ncall = 0;
+
+    free(key);
+}
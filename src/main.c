@@ -7,12 +7,15 @@ int             append_mode;
 int             corr_mode;
 int             spinup_mode;
 int             fixed_length;
+int             bench_rhs;
+int             check_mode;
+int             trace_mode;
+int             mem_report;
+int             convert_mode;
 char            project[MAXSTRING];
 int             nelem;
 int             nriver;
-#if defined(_OPENMP)
 int             nthreads = 1;               /* Default value */
-#endif
 #if defined(_BGC_)
 int             nsolute = 1;
 #elif defined(_CYCLES_)
@@ -32,6 +35,7 @@ int main(int argc, char *argv[])
     N_Vector        CV_Y;
     void           *cvode_mem;
     SUNLinearSolver sun_ls;
+    cvstats_struct  stats;
 #if defined(_OPENMP)
     double          start_omp;
 #else
@@ -56,12 +60,26 @@ int main(int argc, char *argv[])
     /* Print AscII art */
     StartupScreen();
 
+    /* Check flux kernels and quit without reading input files */
+    if (check_mode)
+    {
+        CheckFluxKernels();
+        pihm_exit(EXIT_SUCCESS);
+    }
+
     /* Allocate memory for model data structure */
     pihm = (pihm_struct)malloc(sizeof(*pihm));
 
     /* Read PIHM input files */
     ReadAlloc(pihm);
 
+    /* Write binary forcing files and quit without running the simulation */
+    if (convert_mode)
+    {
+        ConvertForcing(pihm);
+        pihm_exit(EXIT_SUCCESS);
+    }
+
     /* Initialize CVODE state variables */
     CV_Y = N_VNew(NumStateVar());
     if (CV_Y == NULL)
@@ -73,6 +91,19 @@ int main(int argc, char *argv[])
     /* Initialize PIHM structure */
     Initialize(pihm, CV_Y, &cvode_mem);
 
+    /* Print memory per element by module */
+    if (mem_report)
+    {
+        PrintMemReport(pihm);
+    }
+
+    /* Time RHS evaluations and quit without running the simulation */
+    if (bench_rhs > 0)
+    {
+        BenchRhs(bench_rhs, pihm, CV_Y);
+        pihm_exit(EXIT_SUCCESS);
+    }
+
     /* Create output directory */
     CreateOutputDir(outputdir);
 
@@ -87,6 +118,7 @@ int main(int argc, char *argv[])
     MapOutput(outputdir, pihm->ctrl.prtvrbl, pihm->elem, pihm->river,
         &pihm->print);
 #endif
+    MapOutputIds(pihm->elem, pihm->river, &pihm->print);
 
     /* Backup input files */
 #if !defined(_MSC_VER)
@@ -98,12 +130,18 @@ int main(int argc, char *argv[])
 
 #if defined(_LUMPED_) && defined(_RT_)
     InitOutputFiles(outputdir, pihm->ctrl.waterbal, pihm->ctrl.ascii,
-        pihm->chemtbl, &pihm->rttbl, &pihm->print);
+        pihm->ctrl.output_format, pihm->chemtbl, &pihm->rttbl, &pihm->print);
 #else
     InitOutputFiles(outputdir, pihm->ctrl.waterbal, pihm->ctrl.ascii,
-        &pihm->print);
+        pihm->ctrl.output_format, &pihm->print);
 #endif
 
+    /* Start the output writer */
+    InitOutputWriter(pihm->ctrl.ascii, &pihm->print);
+
+    /* Start the task runner of PIHM steps */
+    InitTaskGraph(outputdir, pihm, &pihm->taskgraph);
+
     pihm_printf(VL_VERBOSE, "\n\nSolving ODE system ... \n\n");
 
     /* Set solver parameters */
@@ -146,7 +184,8 @@ int main(int argc, char *argv[])
     }
     else
     {
-        for (ctrl->cstep = 0; ctrl->cstep < ctrl->nstep; ctrl->cstep++)
+        for (ctrl->cstep = 0; ctrl->cstep < ctrl->nstep;
+            ctrl->cstep = ctrl->nextstep)
         {
 #if defined(_OPENMP)
             RunTime(start_omp, &cputime, &cputime_dt);
@@ -154,24 +193,32 @@ int main(int argc, char *argv[])
             RunTime(start, &cputime, &cputime_dt);
 #endif
 
+            /* Find the model step to advance to */
+            ctrl->nextstep = NextStep(pihm);
+
             /* Run PIHM time step */
             PIHM(cputime, pihm, cvode_mem, CV_Y);
 
+            /* Cumulative solver statistics */
+            GetCVodeStats(cvode_mem, &pihm->nls, &pihm->event, &stats);
+
             /* Adjust CVODE max step to reduce oscillation */
-            AdjCVodeMaxStep(cvode_mem, &pihm->ctrl);
+            AdjCVodeMaxStep(cvode_mem, &stats, &pihm->nls, &pihm->ctrl);
 
             /* Print CVODE performance and statistics */
             if (debug_mode)
             {
-                PrintPerf(ctrl->tout[ctrl->cstep + 1], ctrl->starttime,
+                PrintPerf(ctrl->tout[ctrl->nextstep], ctrl->starttime,
                     cputime_dt, cputime, ctrl->maxstep,
-                    pihm->print.cvodeperf_file, cvode_mem);
+                    (ctrl->linsol == SPARSE_LS &&
+                    ctrl->sparse_jac == COLOR_FD_JAC) ? &pihm->colorjac : NULL,
+                    &stats, pihm->print.cvodeperf_file);
             }
 
             /* Write init files */
             if (ctrl->write_ic)
             {
-                PrintInit(outputdir, ctrl->tout[ctrl->cstep + 1],
+                PrintInit(outputdir, ctrl->tout[ctrl->nextstep],
                     ctrl->starttime, ctrl->endtime, ctrl->prtvrbl[IC_CTRL],
                     pihm->elem, pihm->river);
             }
@@ -202,7 +249,8 @@ int main(int argc, char *argv[])
 
     if (debug_mode)
     {
-        PrintCVodeFinalStats(cvode_mem);
+        GetCVodeStats(cvode_mem, &pihm->nls, &pihm->event, &stats);
+        PrintCVodeFinalStats(&stats, &pihm->nls);
     }
 
     /* Free memory */
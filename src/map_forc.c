@@ -0,0 +1,291 @@
+#include "pihm.h"
+
+/*
+ * A binary forcing file holds all time series of a text forcing file, e.g.,
+ * input/<project>/<project>.meteo.bin for <project>.meteo. The header and one
+ * entry per time series are followed by the data of each series: its forcing
+ * times, padded to eight bytes, then one contiguous column of values per
+ * variable. Binary files are written by "pihm -C <project>" and mapped into
+ * memory by the forcing readers, which then skip the text files
+ */
+
+void NewTs(int length, int nvrbl, tsdata_struct *ts)
+{
+    /* Allocate forcing times, and one block for the values of all variables */
+    int             k;
+
+    ts->length = length;
+    ts->nvrbl = nvrbl;
+    ts->mapped = 0;
+    ts->first = 0;
+    ts->stream = NULL;
+    ts->cursor = 0;
+    ts->axis = 0;
+    ts->ftime = (int *)malloc(length * sizeof(int));
+    ts->data = (double **)malloc(nvrbl * sizeof(double *));
+    ts->data[0] = (double *)malloc((size_t)nvrbl * length * sizeof(double));
+
+    for (k = 1; k < nvrbl; k++)
+    {
+        ts->data[k] = ts->data[0] + (size_t)k * length;
+    }
+}
+
+void FreeTs(tsdata_struct *ts)
+{
+    if (ts->stream != NULL)
+    {
+        free(ts->stream->buffer[0]);
+        free(ts->stream->scale);
+        free(ts->stream);
+    }
+
+    if (!ts->mapped)
+    {
+        free(ts->ftime);
+        free(ts->data[0]);
+    }
+    free(ts->data);
+    free(ts->value);
+}
+
+size_t BinTsSize(int length, int nvrbl)
+{
+    /* Bytes of the data of a time series in a binary forcing file */
+    return ((size_t)length * sizeof(int) + 7) / 8 * 8 +
+        (size_t)nvrbl * length * sizeof(double);
+}
+
+int MapForcing(const char fn[], int nvrbl, int *nts, tsdata_struct **ts,
+    forc_struct *forc)
+{
+    /*
+     * Map the binary file of text forcing file fn, and point the forcing times
+     * and values of the time series into the mapping. Returns 0 if there is no
+     * usable binary file, in which case the text file is read
+     */
+#if defined(_WIN32) || defined(_WIN64)
+    return 0;
+#else
+    char            bin_fn[MAXSTRING];
+    struct stat     txt_st, bin_st;
+    int             fd;
+    int             i, k;
+    char           *addr;
+    size_t          size;
+    const binhdr_struct *hdr;
+    const bints_struct *entry;
+
+    if (convert_mode)
+    {
+        return 0;
+    }
+
+    sprintf(bin_fn, "%s.bin", fn);
+
+    if (stat(bin_fn, &bin_st) != 0)
+    {
+        return 0;
+    }
+
+    if (stat(fn, &txt_st) == 0 && txt_st.st_mtime > bin_st.st_mtime)
+    {
+        pihm_printf(VL_NORMAL,
+            "Warning: %s is older than %s and is not used.\n", bin_fn, fn);
+        return 0;
+    }
+
+    if (forc->nbinforc >= MAXBINFORC)
+    {
+        pihm_printf(VL_ERROR,
+            "Error: Too many binary forcing files (max %d).\n", MAXBINFORC);
+        pihm_exit(EXIT_FAILURE);
+    }
+
+    size = (size_t)bin_st.st_size;
+
+    fd = open(bin_fn, O_RDONLY);
+    if (fd < 0)
+    {
+        pihm_printf(VL_ERROR, "Error opening %s.\n", bin_fn);
+        pihm_exit(EXIT_FAILURE);
+    }
+
+    /* Private mapping, so that calibration of forcing values does not write
+     * back to the file. The file stays open for streaming */
+    addr = (size > 0) ?
+        (char *)mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0) :
+        (char *)MAP_FAILED;
+
+    if (addr == (char *)MAP_FAILED)
+    {
+        pihm_printf(VL_ERROR, "Error mapping %s.\n", bin_fn);
+        pihm_exit(EXIT_FAILURE);
+    }
+
+    pihm_printf(VL_VERBOSE, " Mapping %s\n", bin_fn);
+
+    hdr = (const binhdr_struct *)addr;
+    entry = (const bints_struct *)(addr + sizeof(binhdr_struct));
+
+    if (size < sizeof(binhdr_struct) ||
+        memcmp(hdr->magic, BINFORC_MAGIC, sizeof(hdr->magic)) != 0 ||
+        hdr->version != BINFORC_VERSION || hdr->nts < 0 ||
+        size < sizeof(binhdr_struct) + hdr->nts * sizeof(bints_struct))
+    {
+        pihm_printf(VL_ERROR,
+            "Error: %s is not a binary forcing file of version %d.\n", bin_fn,
+            BINFORC_VERSION);
+        pihm_exit(EXIT_FAILURE);
+    }
+
+    *nts = hdr->nts;
+    *ts = (tsdata_struct *)malloc(*nts * sizeof(tsdata_struct));
+
+    for (i = 0; i < *nts; i++)
+    {
+        if (entry[i].nvrbl != nvrbl)
+        {
+            pihm_printf(VL_ERROR,
+                "Error: Time series %d of %s has %d variables (%d expected).\n"
+                "Please convert %s again.\n",
+                i + 1, bin_fn, entry[i].nvrbl, nvrbl, fn);
+            pihm_exit(EXIT_FAILURE);
+        }
+
+        if (entry[i].length < 0 || entry[i].offset < 0 ||
+            entry[i].offset % 8 != 0 || (size_t)entry[i].offset +
+            BinTsSize(entry[i].length, nvrbl) > size)
+        {
+            pihm_printf(VL_ERROR,
+                "Error: Time series %d of %s is truncated.\n", i + 1, bin_fn);
+            pihm_exit(EXIT_FAILURE);
+        }
+
+        (*ts)[i].length = entry[i].length;
+        (*ts)[i].nvrbl = nvrbl;
+        (*ts)[i].mapped = 1;
+        (*ts)[i].first = 0;
+        (*ts)[i].stream = NULL;
+        (*ts)[i].cursor = 0;
+        (*ts)[i].axis = i;
+        memcpy(&(*ts)[i].zlvl_wind, &entry[i].attrib,
+            sizeof((*ts)[i].zlvl_wind));
+
+        (*ts)[i].ftime = (int *)(addr + entry[i].offset);
+        (*ts)[i].data = (double **)malloc(nvrbl * sizeof(double *));
+        for (k = 0; k < nvrbl; k++)
+        {
+            (*ts)[i].data[k] = (double *)(addr + entry[i].offset +
+                BinTsSize(entry[i].length, 0)) + (size_t)k * entry[i].length;
+        }
+    }
+
+    forc->binforc[forc->nbinforc].addr = addr;
+    forc->binforc[forc->nbinforc].size = size;
+    forc->binforc[forc->nbinforc].fd = fd;
+    forc->nbinforc++;
+
+    return 1;
+#endif
+}
+
+void UnmapForcing(forc_struct *forc)
+{
+#if !defined(_WIN32) && !defined(_WIN64)
+    int             i;
+
+    for (i = 0; i < forc->nbinforc; i++)
+    {
+        munmap(forc->binforc[i].addr, forc->binforc[i].size);
+        close(forc->binforc[i].fd);
+    }
+#endif
+
+    forc->nbinforc = 0;
+}
+
+void WriteBinForcing(const char fn[], int nts, const tsdata_struct ts[])
+{
+    /* Write the time series read from text forcing file fn to its binary
+     * file */
+    char            bin_fn[MAXSTRING];
+    FILE           *fp;
+    binhdr_struct   hdr;
+    bints_struct    entry;
+    long long       offset;
+    const char      pad[8] = { 0 };
+    int             i, k;
+
+    sprintf(bin_fn, "%s.bin", fn);
+    fp = pihm_fopen(bin_fn, "wb");
+
+    memset(&hdr, 0, sizeof(binhdr_struct));
+    memcpy(hdr.magic, BINFORC_MAGIC, sizeof(hdr.magic));
+    hdr.version = BINFORC_VERSION;
+    hdr.nts = nts;
+    fwrite(&hdr, sizeof(binhdr_struct), 1, fp);
+
+    offset = sizeof(binhdr_struct) + nts * sizeof(bints_struct);
+    for (i = 0; i < nts; i++)
+    {
+        memset(&entry, 0, sizeof(bints_struct));
+        entry.length = ts[i].length;
+        entry.nvrbl = ts[i].nvrbl;
+        memcpy(&entry.attrib, &ts[i].zlvl_wind, sizeof(ts[i].zlvl_wind));
+        entry.offset = offset;
+        fwrite(&entry, sizeof(bints_struct), 1, fp);
+
+        offset += BinTsSize(ts[i].length, ts[i].nvrbl);
+    }
+
+    for (i = 0; i < nts; i++)
+    {
+        fwrite(ts[i].ftime, sizeof(int), ts[i].length, fp);
+        fwrite(pad, 1, BinTsSize(ts[i].length, 0) -
+            ts[i].length * sizeof(int), fp);
+
+        for (k = 0; k < ts[i].nvrbl; k++)
+        {
+            fwrite(ts[i].data[k], sizeof(double), ts[i].length, fp);
+        }
+    }
+
+    fclose(fp);
+
+    pihm_printf(VL_NORMAL, " Wrote %s\n", bin_fn);
+}
+
+void ConvertForcing(const pihm_struct pihm)
+{
+    /* Write binary files of the forcing files read from text */
+    const forc_struct *forc = &pihm->forc;
+
+    pihm_printf(VL_NORMAL, "\nConvert forcing files:\n");
+
+    WriteBinForcing(pihm->filename.meteo, forc->nmeteo, forc->meteo);
+
+    if (forc->nlai > 0)
+    {
+        WriteBinForcing(pihm->filename.lai, forc->nlai, forc->lai);
+    }
+
+    if (forc->nbc > 0)
+    {
+        WriteBinForcing(pihm->filename.bc, forc->nbc, forc->bc);
+    }
+
+#if defined(_NOAH_)
+    if (pihm->ctrl.rad_mode == TOPO_SOL)
+    {
+        WriteBinForcing(pihm->filename.rad, forc->nrad, forc->rad);
+    }
+#endif
+
+#if defined(_RT_)
+    if (forc->prcp_flag == 2)
+    {
+        WriteBinForcing(pihm->filename.prep, forc->nprcpc, forc->prcpc);
+    }
+#endif
+}
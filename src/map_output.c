@@ -30,7 +30,7 @@ void MapOutput(const char outputdir[], const int prtvrbl[],
             {
                 case SURF_CTRL:
                     InitPrintCtrl(outputdir, "surf", prtvrbl[i],
-                        HYDROL_STEP, nelem, &print->varctrl[n]);
+                        HYDROL_STEP, ELEM_VAR, nelem, &print->varctrl[n]);
                     for (j = 0; j < nelem; j++)
                     {
                         print->varctrl[n].var[j] = &elem[j].ws.surf;
@@ -39,7 +39,7 @@ void MapOutput(const char outputdir[], const int prtvrbl[],
                     break;
                 case UNSAT_CTRL:
                     InitPrintCtrl(outputdir, "unsat", prtvrbl[i],
-                        HYDROL_STEP, nelem, &print->varctrl[n]);
+                        HYDROL_STEP, ELEM_VAR, nelem, &print->varctrl[n]);
                     for (j = 0; j < nelem; j++)
                     {
                         print->varctrl[n].var[j] = &elem[j].ws.unsat;
@@ -48,7 +48,7 @@ void MapOutput(const char outputdir[], const int prtvrbl[],
                     break;
                 case GW_CTRL:
                     InitPrintCtrl(outputdir, "gw", prtvrbl[i],
-                        HYDROL_STEP, nelem, &print->varctrl[n]);
+                        HYDROL_STEP, ELEM_VAR, nelem, &print->varctrl[n]);
                     for (j = 0; j < nelem; j++)
                     {
                         print->varctrl[n].var[j] = &elem[j].ws.gw;
@@ -57,7 +57,7 @@ void MapOutput(const char outputdir[], const int prtvrbl[],
                     break;
                 case STAGE_CTRL:
                     InitPrintCtrl(outputdir, "river.stage", prtvrbl[i],
-                        HYDROL_STEP, nriver, &print->varctrl[n]);
+                        HYDROL_STEP, RIVER_VAR, nriver, &print->varctrl[n]);
                     for (j = 0; j < nriver; j++)
                     {
                         print->varctrl[n].var[j] = &river[j].ws.stage;
@@ -66,7 +66,7 @@ void MapOutput(const char outputdir[], const int prtvrbl[],
                     break;
                 case SNOW_CTRL:
                     InitPrintCtrl(outputdir, "snow", prtvrbl[i],
-                        LS_STEP, nelem, &print->varctrl[n]);
+                        LS_STEP, ELEM_VAR, nelem, &print->varctrl[n]);
                     for (j = 0; j < nelem; j++)
                     {
                         print->varctrl[n].var[j] = &elem[j].ws.sneqv;
@@ -76,7 +76,7 @@ void MapOutput(const char outputdir[], const int prtvrbl[],
                 case CMC_CTRL:
 #if defined(_CYCLES_OBSOLETE_)
                     InitPrintCtrl(outputdir, "stanresw", prtvrbl[i],
-                        LS_STEP, nelem, &print->varctrl[n]);
+                        LS_STEP, ELEM_VAR, nelem, &print->varctrl[n]);
                     for (j = 0; j < nelem; j++)
                     {
                         print->varctrl[n].var[j] = &elem[j].ws.stanResidueWater;
@@ -84,7 +84,7 @@ void MapOutput(const char outputdir[], const int prtvrbl[],
                     n++;
 
                     InitPrintCtrl(outputdir, "flatresw", prtvrbl[i],
-                        LS_STEP, nelem, &print->varctrl[n]);
+                        LS_STEP, ELEM_VAR, nelem, &print->varctrl[n]);
                     for (j = 0; j < nelem; j++)
                     {
                         print->varctrl[n].var[j] = &elem[j].ws.flatResidueWater;
@@ -92,7 +92,7 @@ void MapOutput(const char outputdir[], const int prtvrbl[],
                     n++;
 #else
                     InitPrintCtrl(outputdir, "is", prtvrbl[i],
-                        LS_STEP, nelem, &print->varctrl[n]);
+                        LS_STEP, ELEM_VAR, nelem, &print->varctrl[n]);
                     for (j = 0; j < nelem; j++)
                     {
                         print->varctrl[n].var[j] = &elem[j].ws.cmc;
@@ -102,7 +102,7 @@ void MapOutput(const char outputdir[], const int prtvrbl[],
                     break;
                 case INFIL_CTRL:
                     InitPrintCtrl(outputdir, "infil", prtvrbl[i],
-                        HYDROL_STEP, nelem, &print->varctrl[n]);
+                        HYDROL_STEP, ELEM_VAR, nelem, &print->varctrl[n]);
                     for (j = 0; j < nelem; j++)
                     {
                         print->varctrl[n].var[j] = &elem[j].wf.eqv_infil;
@@ -111,7 +111,7 @@ void MapOutput(const char outputdir[], const int prtvrbl[],
                     break;
                 case RECHARGE_CTRL:
                     InitPrintCtrl(outputdir, "recharge", prtvrbl[i],
-                        HYDROL_STEP, nelem, &print->varctrl[n]);
+                        HYDROL_STEP, ELEM_VAR, nelem, &print->varctrl[n]);
                     for (j = 0; j < nelem; j++)
                     {
                         print->varctrl[n].var[j] = &elem[j].wf.recharge;
@@ -121,10 +121,10 @@ void MapOutput(const char outputdir[], const int prtvrbl[],
                 case EC_CTRL:
 #if defined(_CYCLES_)
                     InitPrintCtrl(outputdir, "eres", prtvrbl[i],
-                        LS_STEP, nelem, &print->varctrl[n]);
+                        LS_STEP, ELEM_VAR, nelem, &print->varctrl[n]);
 #else
                     InitPrintCtrl(outputdir, "ec", prtvrbl[i],
-                        LS_STEP, nelem, &print->varctrl[n]);
+                        LS_STEP, ELEM_VAR, nelem, &print->varctrl[n]);
 #endif
                     for (j = 0; j < nelem; j++)
                     {
@@ -134,7 +134,7 @@ void MapOutput(const char outputdir[], const int prtvrbl[],
                     break;
                 case ETT_CTRL:
                     InitPrintCtrl(outputdir, "ett", prtvrbl[i],
-                        LS_STEP, nelem, &print->varctrl[n]);
+                        LS_STEP, ELEM_VAR, nelem, &print->varctrl[n]);
                     for (j = 0; j < nelem; j++)
                     {
                         print->varctrl[n].var[j] = &elem[j].wf.ett;
@@ -143,7 +143,7 @@ void MapOutput(const char outputdir[], const int prtvrbl[],
                     break;
                 case EDIR_CTRL:
                     InitPrintCtrl(outputdir, "edir", prtvrbl[i],
-                        LS_STEP, nelem, &print->varctrl[n]);
+                        LS_STEP, ELEM_VAR, nelem, &print->varctrl[n]);
                     for (j = 0; j < nelem; j++)
                     {
                         print->varctrl[n].var[j] = &elem[j].wf.edir;
@@ -152,7 +152,7 @@ void MapOutput(const char outputdir[], const int prtvrbl[],
                     break;
                 case RIVFLX0_CTRL:
                     InitPrintCtrl(outputdir, "river.flx0", prtvrbl[i],
-                        HYDROL_STEP, nriver, &print->varctrl[n]);
+                        HYDROL_STEP, RIVER_VAR, nriver, &print->varctrl[n]);
                     for (j = 0; j < nriver; j++)
                     {
                         print->varctrl[n].var[j] = &river[j].wf.rivflow[0];
@@ -161,7 +161,7 @@ void MapOutput(const char outputdir[], const int prtvrbl[],
                     break;
                 case RIVFLX1_CTRL:
                     InitPrintCtrl(outputdir, "river.flx1", prtvrbl[i],
-                        HYDROL_STEP, nriver, &print->varctrl[n]);
+                        HYDROL_STEP, RIVER_VAR, nriver, &print->varctrl[n]);
                     for (j = 0; j < nriver; j++)
                     {
                         print->varctrl[n].var[j] = &river[j].wf.rivflow[1];
@@ -170,7 +170,7 @@ void MapOutput(const char outputdir[], const int prtvrbl[],
                     break;
                 case RIVFLX2_CTRL:
                     InitPrintCtrl(outputdir, "river.flx2", prtvrbl[i],
-                        HYDROL_STEP, nriver, &print->varctrl[n]);
+                        HYDROL_STEP, RIVER_VAR, nriver, &print->varctrl[n]);
                     for (j = 0; j < nriver; j++)
                     {
                         print->varctrl[n].var[j] = &river[j].wf.rivflow[2];
@@ -179,7 +179,7 @@ void MapOutput(const char outputdir[], const int prtvrbl[],
                     break;
                 case RIVFLX3_CTRL:
                     InitPrintCtrl(outputdir, "river.flx3", prtvrbl[i],
-                        HYDROL_STEP, nriver, &print->varctrl[n]);
+                        HYDROL_STEP, RIVER_VAR, nriver, &print->varctrl[n]);
                     for (j = 0; j < nriver; j++)
                     {
                         print->varctrl[n].var[j] = &river[j].wf.rivflow[3];
@@ -188,7 +188,7 @@ void MapOutput(const char outputdir[], const int prtvrbl[],
                     break;
                 case RIVFLX4_CTRL:
                     InitPrintCtrl(outputdir, "river.flx4", prtvrbl[i],
-                        HYDROL_STEP, nriver, &print->varctrl[n]);
+                        HYDROL_STEP, RIVER_VAR, nriver, &print->varctrl[n]);
                     for (j = 0; j < nriver; j++)
                     {
                         print->varctrl[n].var[j] = &river[j].wf.rivflow[4];
@@ -197,7 +197,7 @@ void MapOutput(const char outputdir[], const int prtvrbl[],
                     break;
                 case RIVFLX5_CTRL:
                     InitPrintCtrl(outputdir, "river.flx5", prtvrbl[i],
-                        HYDROL_STEP, nriver, &print->varctrl[n]);
+                        HYDROL_STEP, RIVER_VAR, nriver, &print->varctrl[n]);
                     for (j = 0; j < nriver; j++)
                     {
                         print->varctrl[n].var[j] = &river[j].wf.rivflow[5];
@@ -209,7 +209,7 @@ void MapOutput(const char outputdir[], const int prtvrbl[],
                     {
                         sprintf(ext, "subflx%d", k);
                         InitPrintCtrl(outputdir, ext, prtvrbl[i],
-                            HYDROL_STEP, nelem, &print->varctrl[n]);
+                            HYDROL_STEP, ELEM_VAR, nelem, &print->varctrl[n]);
                         for (j = 0; j < nelem; j++)
                         {
                             print->varctrl[n].var[j] = &elem[j].wf.subsurf[k];
@@ -222,7 +222,7 @@ void MapOutput(const char outputdir[], const int prtvrbl[],
                     {
                         sprintf(ext, "surfflx%d", k);
                         InitPrintCtrl(outputdir, ext, prtvrbl[i],
-                            HYDROL_STEP, nelem, &print->varctrl[n]);
+                            HYDROL_STEP, ELEM_VAR, nelem, &print->varctrl[n]);
                         for (j = 0; j < nelem; j++)
                         {
                             print->varctrl[n].var[j] = &elem[j].wf.overland[k];
@@ -233,7 +233,7 @@ void MapOutput(const char outputdir[], const int prtvrbl[],
 #if defined(_NOAH_)
                 case T1_CTRL:
                     InitPrintCtrl(outputdir, "t1", prtvrbl[i],
-                        LS_STEP, nelem, &print->varctrl[n]);
+                        LS_STEP, ELEM_VAR, nelem, &print->varctrl[n]);
                     for (j = 0; j < nelem; j++)
                     {
                         print->varctrl[n].var[j] = &elem[j].es.t1;
@@ -245,7 +245,7 @@ void MapOutput(const char outputdir[], const int prtvrbl[],
                     {
                         sprintf(ext, "stc%d", k);
                         InitPrintCtrl(outputdir, ext, prtvrbl[i],
-                            LS_STEP, nelem, &print->varctrl[n]);
+                            LS_STEP, ELEM_VAR, nelem, &print->varctrl[n]);
                         for (j = 0; j < nelem; j++)
                         {
                             print->varctrl[n].var[j] = &elem[j].es.stc[k];
@@ -258,7 +258,7 @@ void MapOutput(const char outputdir[], const int prtvrbl[],
                     {
                         sprintf(ext, "smc%d", k);
                         InitPrintCtrl(outputdir, ext, prtvrbl[i],
-                            HYDROL_STEP, nelem, &print->varctrl[n]);
+                            HYDROL_STEP, ELEM_VAR, nelem, &print->varctrl[n]);
                         for (j = 0; j < nelem; j++)
                         {
                             print->varctrl[n].var[j] = &elem[j].ws.smc[k];
@@ -271,7 +271,7 @@ void MapOutput(const char outputdir[], const int prtvrbl[],
                     {
                         sprintf(ext, "swc%d", k);
                         InitPrintCtrl(outputdir, ext, prtvrbl[i],
-                            HYDROL_STEP, nelem, &print->varctrl[n]);
+                            HYDROL_STEP, ELEM_VAR, nelem, &print->varctrl[n]);
                         for (j = 0; j < nelem; j++)
                         {
                             print->varctrl[n].var[j] = &elem[j].ws.swc[k];
@@ -281,7 +281,7 @@ void MapOutput(const char outputdir[], const int prtvrbl[],
                     break;
                 case SNOWH_CTRL:
                     InitPrintCtrl(outputdir, "snowh", prtvrbl[i],
-                        LS_STEP, nelem, &print->varctrl[n]);
+                        LS_STEP, ELEM_VAR, nelem, &print->varctrl[n]);
                     for (j = 0; j < nelem; j++)
                     {
                         print->varctrl[n].var[j] = &elem[j].ps.snowh;
@@ -289,7 +289,7 @@ void MapOutput(const char outputdir[], const int prtvrbl[],
                     n++;
 
                     InitPrintCtrl(outputdir, "iceh", prtvrbl[i],
-                        LS_STEP, nelem, &print->varctrl[n]);
+                        LS_STEP, ELEM_VAR, nelem, &print->varctrl[n]);
                     for (j = 0; j < nelem; j++)
                     {
                         print->varctrl[n].var[j] = &elem[j].ps.iceh;
@@ -298,7 +298,7 @@ void MapOutput(const char outputdir[], const int prtvrbl[],
                     break;
                 case ALBEDO_CTRL:
                     InitPrintCtrl(outputdir, "albedo", prtvrbl[i],
-                        LS_STEP, nelem, &print->varctrl[n]);
+                        LS_STEP, ELEM_VAR, nelem, &print->varctrl[n]);
                     for (j = 0; j < nelem; j++)
                     {
                         print->varctrl[n].var[j] = &elem[j].ps.albedo;
@@ -307,7 +307,7 @@ void MapOutput(const char outputdir[], const int prtvrbl[],
                     break;
                 case LE_CTRL:
                     InitPrintCtrl(outputdir, "le", prtvrbl[i],
-                        LS_STEP, nelem, &print->varctrl[n]);
+                        LS_STEP, ELEM_VAR, nelem, &print->varctrl[n]);
                     for (j = 0; j < nelem; j++)
                     {
                         print->varctrl[n].var[j] = &elem[j].ef.eta;
@@ -316,7 +316,7 @@ void MapOutput(const char outputdir[], const int prtvrbl[],
                     break;
                 case SH_CTRL:
                     InitPrintCtrl(outputdir, "sh", prtvrbl[i],
-                        LS_STEP, nelem, &print->varctrl[n]);
+                        LS_STEP, ELEM_VAR, nelem, &print->varctrl[n]);
                     for (j = 0; j < nelem; j++)
                     {
                         print->varctrl[n].var[j] = &elem[j].ef.sheat;
@@ -325,7 +325,7 @@ void MapOutput(const char outputdir[], const int prtvrbl[],
                     break;
                 case G_CTRL:
                     InitPrintCtrl(outputdir, "g", prtvrbl[i],
-                        LS_STEP, nelem, &print->varctrl[n]);
+                        LS_STEP, ELEM_VAR, nelem, &print->varctrl[n]);
                     for (j = 0; j < nelem; j++)
                     {
                         print->varctrl[n].var[j] = &elem[j].ef.ssoil;
@@ -334,7 +334,7 @@ void MapOutput(const char outputdir[], const int prtvrbl[],
                     break;
                 case ETP_CTRL:
                     InitPrintCtrl(outputdir, "etp", prtvrbl[i],
-                        LS_STEP, nelem, &print->varctrl[n]);
+                        LS_STEP, ELEM_VAR, nelem, &print->varctrl[n]);
                     for (j = 0; j < nelem; j++)
                     {
                         print->varctrl[n].var[j] = &elem[j].ef.etp;
@@ -343,7 +343,7 @@ void MapOutput(const char outputdir[], const int prtvrbl[],
                     break;
                 case ESNOW_CTRL:
                     InitPrintCtrl(outputdir, "esnow", prtvrbl[i],
-                        LS_STEP, nelem, &print->varctrl[n]);
+                        LS_STEP, ELEM_VAR, nelem, &print->varctrl[n]);
                     for (j = 0; j < nelem; j++)
                     {
                         print->varctrl[n].var[j] = &elem[j].ef.esnow;
@@ -352,7 +352,7 @@ void MapOutput(const char outputdir[], const int prtvrbl[],
                     break;
                 case ROOTW_CTRL:
                     InitPrintCtrl(outputdir, "rootw", prtvrbl[i],
-                        LS_STEP, nelem, &print->varctrl[n]);
+                        LS_STEP, ELEM_VAR, nelem, &print->varctrl[n]);
                     for (j = 0; j < nelem; j++)
                     {
                         print->varctrl[n].var[j] = &elem[j].ps.soilw;
@@ -361,7 +361,7 @@ void MapOutput(const char outputdir[], const int prtvrbl[],
                     break;
                 case SOILM_CTRL:
                     InitPrintCtrl(outputdir, "soilm", prtvrbl[i],
-                        LS_STEP, nelem, &print->varctrl[n]);
+                        LS_STEP, ELEM_VAR, nelem, &print->varctrl[n]);
                     for (j = 0; j < nelem; j++)
                     {
                         print->varctrl[n].var[j] = &elem[j].ws.soilm;
@@ -370,7 +370,7 @@ void MapOutput(const char outputdir[], const int prtvrbl[],
                     break;
                 case SOLAR_CTRL:
                     InitPrintCtrl(outputdir, "solar", prtvrbl[i],
-                        LS_STEP, nelem, &print->varctrl[n]);
+                        LS_STEP, ELEM_VAR, nelem, &print->varctrl[n]);
                     for (j = 0; j < nelem; j++)
                     {
                         print->varctrl[n].var[j] = &elem[j].ef.soldn;
@@ -379,7 +379,7 @@ void MapOutput(const char outputdir[], const int prtvrbl[],
                     break;
                 case CH_CTRL:
                     InitPrintCtrl(outputdir, "ch", prtvrbl[i],
-                        LS_STEP, nelem, &print->varctrl[n]);
+                        LS_STEP, ELEM_VAR, nelem, &print->varctrl[n]);
                     for (j = 0; j < nelem; j++)
                     {
                         print->varctrl[n].var[j] = &elem[j].ps.ch;
@@ -391,113 +391,113 @@ void MapOutput(const char outputdir[], const int prtvrbl[],
 # if defined(_LUMPEDBGC_)
                 case LAI_CTRL:
                     InitPrintCtrl(outputdir, "lai", prtvrbl[i],
-                        CN_STEP, 1, &print->varctrl[n]);
+                        CN_STEP, MISC_VAR, 1, &print->varctrl[n]);
                     print->varctrl[n].var[0] = &elem[LUMPEDBGC].ps.proj_lai;
                     n++;
                     break;
                 case NPP_CTRL:
                     InitPrintCtrl(outputdir, "npp", prtvrbl[i],
-                        CN_STEP, 1, &print->varctrl[n]);
+                        CN_STEP, MISC_VAR, 1, &print->varctrl[n]);
                     print->varctrl[n].var[0] =
                         &elem[LUMPEDBGC].summary.daily_npp;
                     n++;
                     break;
                 case NEP_CTRL:
                     InitPrintCtrl(outputdir, "nep", prtvrbl[i],
-                        CN_STEP, 1, &print->varctrl[n]);
+                        CN_STEP, MISC_VAR, 1, &print->varctrl[n]);
                     print->varctrl[n].var[0] =
                         &elem[LUMPEDBGC].summary.daily_nep;
                     n++;
                     break;
                 case NEE_CTRL:
                     InitPrintCtrl(outputdir, "nee", prtvrbl[i],
-                        CN_STEP, 1, &print->varctrl[n]);
+                        CN_STEP, MISC_VAR, 1, &print->varctrl[n]);
                     print->varctrl[n].var[0] =
                         &elem[LUMPEDBGC].summary.daily_nee;
                     n++;
                     break;
                 case GPP_CTRL:
                     InitPrintCtrl(outputdir, "gpp", prtvrbl[i],
-                        CN_STEP, 1, &print->varctrl[n]);
+                        CN_STEP, MISC_VAR, 1, &print->varctrl[n]);
                     print->varctrl[n].var[0] =
                         &elem[LUMPEDBGC].summary.daily_gpp;
                     n++;
                     break;
                 case MR_CTRL:
                     InitPrintCtrl(outputdir, "mr", prtvrbl[i],
-                        CN_STEP, 1, &print->varctrl[n]);
+                        CN_STEP, MISC_VAR, 1, &print->varctrl[n]);
                     print->varctrl[n].var[0] =
                         &elem[LUMPEDBGC].summary.daily_mr;
                     n++;
                     break;
                 case GR_CTRL:
                     InitPrintCtrl(outputdir, "gr", prtvrbl[i],
-                        CN_STEP, 1, &print->varctrl[n]);
+                        CN_STEP, MISC_VAR, 1, &print->varctrl[n]);
                     print->varctrl[n].var[0] =
                         &elem[LUMPEDBGC].summary.daily_gr;
                     n++;
                     break;
                 case HR_CTRL:
                     InitPrintCtrl(outputdir, "hr", prtvrbl[i],
-                        CN_STEP, 1, &print->varctrl[n]);
+                        CN_STEP, MISC_VAR, 1, &print->varctrl[n]);
                     print->varctrl[n].var[0] =
                         &elem[LUMPEDBGC].summary.daily_hr;
                     n++;
                     break;
                 case FIRE_CTRL:
                     InitPrintCtrl(outputdir, "fire", prtvrbl[i],
-                        CN_STEP, 1, &print->varctrl[n]);
+                        CN_STEP, MISC_VAR, 1, &print->varctrl[n]);
                     print->varctrl[n].var[0] =
                         &elem[LUMPEDBGC].summary.daily_fire;
                     n++;
                     break;
                 case LITFALLC_CTRL:
                     InitPrintCtrl(outputdir, "litfallc", prtvrbl[i],
-                        CN_STEP, 1, &print->varctrl[n]);
+                        CN_STEP, MISC_VAR, 1, &print->varctrl[n]);
                     print->varctrl[n].var[0] =
                         &elem[LUMPEDBGC].summary.daily_litfallc;
                     n++;
                     break;
                 case VEGC_CTRL:
                     InitPrintCtrl(outputdir, "vegc", prtvrbl[i],
-                        CN_STEP, 1, &print->varctrl[n]);
+                        CN_STEP, MISC_VAR, 1, &print->varctrl[n]);
                     print->varctrl[n].var[0] = &elem[LUMPEDBGC].summary.vegc;
                     n++;
                     break;
                 case AGC_CTRL:
                     InitPrintCtrl(outputdir, "agc", prtvrbl[i],
-                        CN_STEP, 1, &print->varctrl[n]);
+                        CN_STEP, MISC_VAR, 1, &print->varctrl[n]);
                     print->varctrl[n].var[0] = &elem[LUMPEDBGC].summary.agc;
                     n++;
                     break;
                 case LITRC_CTRL:
                     InitPrintCtrl(outputdir, "litrc", prtvrbl[i],
-                        CN_STEP, 1, &print->varctrl[n]);
+                        CN_STEP, MISC_VAR, 1, &print->varctrl[n]);
                     print->varctrl[n].var[0] = &elem[LUMPEDBGC].summary.litrc;
                     n++;
                     break;
                 case SOILC_CTRL:
                     InitPrintCtrl(outputdir, "soilc", prtvrbl[i],
-                        CN_STEP, 1, &print->varctrl[n]);
+                        CN_STEP, MISC_VAR, 1, &print->varctrl[n]);
                     print->varctrl[n].var[0] = &elem[LUMPEDBGC].summary.soilc;
                     n++;
                     break;
                 case TOTALC_CTRL:
                     InitPrintCtrl(outputdir, "totalc", prtvrbl[i],
-                        CN_STEP, 1, &print->varctrl[n]);
+                        CN_STEP, MISC_VAR, 1, &print->varctrl[n]);
                     print->varctrl[n].var[0] = &elem[LUMPEDBGC].summary.totalc;
                     n++;
                     break;
                 case SMINN_CTRL:
                     InitPrintCtrl(outputdir, "sminn", prtvrbl[i],
-                        CN_STEP, 1, &print->varctrl[n]);
+                        CN_STEP, MISC_VAR, 1, &print->varctrl[n]);
                     print->varctrl[n].var[0] = &elem[LUMPEDBGC].ns.sminn;
                     n++;
                     break;
 # else
                 case LAI_CTRL:
                     InitPrintCtrl(outputdir, "lai", prtvrbl[i],
-                        CN_STEP, nelem, &print->varctrl[n]);
+                        CN_STEP, ELEM_VAR, nelem, &print->varctrl[n]);
                     for (j = 0; j < nelem; j++)
                     {
                         print->varctrl[n].var[j] = &elem[j].ps.proj_lai;
@@ -506,7 +506,7 @@ void MapOutput(const char outputdir[], const int prtvrbl[],
                     break;
                 case NPP_CTRL:
                     InitPrintCtrl(outputdir, "npp", prtvrbl[i],
-                        CN_STEP, nelem, &print->varctrl[n]);
+                        CN_STEP, ELEM_VAR, nelem, &print->varctrl[n]);
                     for (j = 0; j < nelem; j++)
                     {
                         print->varctrl[n].var[j] = &elem[j].summary.daily_npp;
@@ -515,7 +515,7 @@ void MapOutput(const char outputdir[], const int prtvrbl[],
                     break;
                 case NEP_CTRL:
                     InitPrintCtrl(outputdir, "nep", prtvrbl[i],
-                        CN_STEP, nelem, &print->varctrl[n]);
+                        CN_STEP, ELEM_VAR, nelem, &print->varctrl[n]);
                     for (j = 0; j < nelem; j++)
                     {
                         print->varctrl[n].var[j] = &elem[j].summary.daily_nep;
@@ -524,7 +524,7 @@ void MapOutput(const char outputdir[], const int prtvrbl[],
                     break;
                 case NEE_CTRL:
                     InitPrintCtrl(outputdir, "nee", prtvrbl[i],
-                        CN_STEP, nelem, &print->varctrl[n]);
+                        CN_STEP, ELEM_VAR, nelem, &print->varctrl[n]);
                     for (j = 0; j < nelem; j++)
                     {
                         print->varctrl[n].var[j] = &elem[j].summary.daily_nee;
@@ -533,7 +533,7 @@ void MapOutput(const char outputdir[], const int prtvrbl[],
                     break;
                 case GPP_CTRL:
                     InitPrintCtrl(outputdir, "gpp", prtvrbl[i],
-                        CN_STEP, nelem, &print->varctrl[n]);
+                        CN_STEP, ELEM_VAR, nelem, &print->varctrl[n]);
                     for (j = 0; j < nelem; j++)
                     {
                         print->varctrl[n].var[j] = &elem[j].summary.daily_gpp;
@@ -542,7 +542,7 @@ void MapOutput(const char outputdir[], const int prtvrbl[],
                     break;
                 case MR_CTRL:
                     InitPrintCtrl(outputdir, "mr", prtvrbl[i],
-                        CN_STEP, nelem, &print->varctrl[n]);
+                        CN_STEP, ELEM_VAR, nelem, &print->varctrl[n]);
                     for (j = 0; j < nelem; j++)
                     {
                         print->varctrl[n].var[j] = &elem[j].summary.daily_mr;
@@ -551,7 +551,7 @@ void MapOutput(const char outputdir[], const int prtvrbl[],
                     break;
                 case GR_CTRL:
                     InitPrintCtrl(outputdir, "gr", prtvrbl[i],
-                        CN_STEP, nelem, &print->varctrl[n]);
+                        CN_STEP, ELEM_VAR, nelem, &print->varctrl[n]);
                     for (j = 0; j < nelem; j++)
                     {
                         print->varctrl[n].var[j] = &elem[j].summary.daily_gr;
@@ -560,7 +560,7 @@ void MapOutput(const char outputdir[], const int prtvrbl[],
                     break;
                 case HR_CTRL:
                     InitPrintCtrl(outputdir, "hr", prtvrbl[i],
-                        CN_STEP, nelem, &print->varctrl[n]);
+                        CN_STEP, ELEM_VAR, nelem, &print->varctrl[n]);
                     for (j = 0; j < nelem; j++)
                     {
                         print->varctrl[n].var[j] = &elem[j].summary.daily_hr;
@@ -569,7 +569,7 @@ void MapOutput(const char outputdir[], const int prtvrbl[],
                     break;
                 case FIRE_CTRL:
                     InitPrintCtrl(outputdir, "fire", prtvrbl[i],
-                        CN_STEP, nelem, &print->varctrl[n]);
+                        CN_STEP, ELEM_VAR, nelem, &print->varctrl[n]);
                     for (j = 0; j < nelem; j++)
                     {
                         print->varctrl[n].var[j] = &elem[j].summary.daily_fire;
@@ -578,7 +578,7 @@ void MapOutput(const char outputdir[], const int prtvrbl[],
                     break;
                 case LITFALLC_CTRL:
                     InitPrintCtrl(outputdir, "litfallc", prtvrbl[i],
-                        CN_STEP, nelem, &print->varctrl[n]);
+                        CN_STEP, ELEM_VAR, nelem, &print->varctrl[n]);
                     for (j = 0; j < nelem; j++)
                     {
                         print->varctrl[n].var[j] =
@@ -588,7 +588,7 @@ void MapOutput(const char outputdir[], const int prtvrbl[],
                     break;
                 case VEGC_CTRL:
                     InitPrintCtrl(outputdir, "vegc", prtvrbl[i],
-                        CN_STEP, nelem, &print->varctrl[n]);
+                        CN_STEP, ELEM_VAR, nelem, &print->varctrl[n]);
                     for (j = 0; j < nelem; j++)
                     {
                         print->varctrl[n].var[j] = &elem[j].summary.vegc;
@@ -597,7 +597,7 @@ void MapOutput(const char outputdir[], const int prtvrbl[],
                     break;
                 case AGC_CTRL:
                     InitPrintCtrl(outputdir, "agc", prtvrbl[i],
-                        CN_STEP, nelem, &print->varctrl[n]);
+                        CN_STEP, ELEM_VAR, nelem, &print->varctrl[n]);
                     for (j = 0; j < nelem; j++)
                     {
                         print->varctrl[n].var[j] = &elem[j].summary.agc;
@@ -606,7 +606,7 @@ void MapOutput(const char outputdir[], const int prtvrbl[],
                     break;
                 case LITRC_CTRL:
                     InitPrintCtrl(outputdir, "litrc", prtvrbl[i],
-                        CN_STEP, nelem, &print->varctrl[n]);
+                        CN_STEP, ELEM_VAR, nelem, &print->varctrl[n]);
                     for (j = 0; j < nelem; j++)
                     {
                         print->varctrl[n].var[j] = &elem[j].summary.litrc;
@@ -615,7 +615,7 @@ void MapOutput(const char outputdir[], const int prtvrbl[],
                     break;
                 case SOILC_CTRL:
                     InitPrintCtrl(outputdir, "soilc", prtvrbl[i],
-                        CN_STEP, nelem, &print->varctrl[n]);
+                        CN_STEP, ELEM_VAR, nelem, &print->varctrl[n]);
                     for (j = 0; j < nelem; j++)
                     {
                         print->varctrl[n].var[j] = &elem[j].summary.soilc;
@@ -624,7 +624,7 @@ void MapOutput(const char outputdir[], const int prtvrbl[],
                     break;
                 case TOTALC_CTRL:
                     InitPrintCtrl(outputdir, "totalc", prtvrbl[i],
-                        CN_STEP, nelem, &print->varctrl[n]);
+                        CN_STEP, ELEM_VAR, nelem, &print->varctrl[n]);
                     for (j = 0; j < nelem; j++)
                     {
                         print->varctrl[n].var[j] = &elem[j].summary.totalc;
@@ -633,7 +633,7 @@ void MapOutput(const char outputdir[], const int prtvrbl[],
                     break;
                 case SMINN_CTRL:
                     InitPrintCtrl(outputdir, "sminn", prtvrbl[i],
-                        CN_STEP, nelem, &print->varctrl[n]);
+                        CN_STEP, ELEM_VAR, nelem, &print->varctrl[n]);
                     for (j = 0; j < nelem; j++)
                     {
                         print->varctrl[n].var[j] = &elem[j].ns.sminn;
@@ -653,7 +653,7 @@ void MapOutput(const char outputdir[], const int prtvrbl[],
 
                         sprintf(ext, "grain_yield.%s", crop[k].epc.name);
                         InitPrintCtrl(outputdir, ext, prtvrbl[i],
-                            CN_STEP, nelem, &print->varctrl[n]);
+                            CN_STEP, ELEM_VAR, nelem, &print->varctrl[n]);
                         for (j = 0; j < nelem; j++)
                         {
                             print->varctrl[n].var[j] =
@@ -663,7 +663,7 @@ void MapOutput(const char outputdir[], const int prtvrbl[],
 
                         sprintf(ext, "forage_yield.%s", crop[k].epc.name);
                         InitPrintCtrl(outputdir, ext, prtvrbl[i],
-                            CN_STEP, nelem, &print->varctrl[n]);
+                            CN_STEP, ELEM_VAR, nelem, &print->varctrl[n]);
                         for (j = 0; j < nelem; j++)
                         {
                             print->varctrl[n].var[j] =
@@ -682,7 +682,7 @@ void MapOutput(const char outputdir[], const int prtvrbl[],
 
                         sprintf(ext, "shoot.%s", crop[k].epc.name);
                         InitPrintCtrl(outputdir, ext, prtvrbl[i],
-                            CN_STEP, nelem, &print->varctrl[n]);
+                            CN_STEP, ELEM_VAR, nelem, &print->varctrl[n]);
                         for (j = 0; j < nelem; j++)
                         {
                             print->varctrl[n].var[j] =
@@ -692,7 +692,7 @@ void MapOutput(const char outputdir[], const int prtvrbl[],
 
                         sprintf(ext, "root.%s", crop[k].epc.name);
                         InitPrintCtrl(outputdir, ext, prtvrbl[i],
-                            CN_STEP, nelem, &print->varctrl[n]);
+                            CN_STEP, ELEM_VAR, nelem, &print->varctrl[n]);
                         for (j = 0; j < nelem; j++)
                         {
                             print->varctrl[n].var[j] =
@@ -711,7 +711,7 @@ void MapOutput(const char outputdir[], const int prtvrbl[],
 
                         sprintf(ext, "radintcp.%s", crop[k].epc.name);
                         InitPrintCtrl(outputdir, ext, prtvrbl[i],
-                            CN_STEP, nelem, &print->varctrl[n]);
+                            CN_STEP, ELEM_VAR, nelem, &print->varctrl[n]);
                         for (j = 0; j < nelem; j++)
                         {
                             print->varctrl[n].var[j] =
@@ -730,7 +730,7 @@ void MapOutput(const char outputdir[], const int prtvrbl[],
 
                         sprintf(ext, "wstress.%s", crop[k].epc.name);
                         InitPrintCtrl(outputdir, ext, prtvrbl[i],
-                            CN_STEP, nelem, &print->varctrl[n]);
+                            CN_STEP, ELEM_VAR, nelem, &print->varctrl[n]);
                         for (j = 0; j < nelem; j++)
                         {
                             print->varctrl[n].var[j] =
@@ -749,7 +749,7 @@ void MapOutput(const char outputdir[], const int prtvrbl[],
 
                         sprintf(ext, "nstress.%s", crop[k].epc.name);
                         InitPrintCtrl(outputdir, ext, prtvrbl[i],
-                            CN_STEP, nelem, &print->varctrl[n]);
+                            CN_STEP, ELEM_VAR, nelem, &print->varctrl[n]);
                         for (j = 0; j < nelem; j++)
                         {
                             print->varctrl[n].var[j] =
@@ -768,7 +768,7 @@ void MapOutput(const char outputdir[], const int prtvrbl[],
 
                         sprintf(ext, "transp.%s", crop[k].epc.name);
                         InitPrintCtrl(outputdir, ext, prtvrbl[i],
-                            CN_STEP, nelem, &print->varctrl[n]);
+                            CN_STEP, ELEM_VAR, nelem, &print->varctrl[n]);
                         for (j = 0; j < nelem; j++)
                         {
                             print->varctrl[n].var[j] =
@@ -787,7 +787,7 @@ void MapOutput(const char outputdir[], const int prtvrbl[],
 
                         sprintf(ext, "pottransp.%s", crop[k].epc.name);
                         InitPrintCtrl(outputdir, ext, prtvrbl[i],
-                            CN_STEP, nelem, &print->varctrl[n]);
+                            CN_STEP, ELEM_VAR, nelem, &print->varctrl[n]);
                         for (j = 0; j < nelem; j++)
                         {
                             print->varctrl[n].var[j] =
@@ -798,7 +798,7 @@ void MapOutput(const char outputdir[], const int prtvrbl[],
                     break;
                 case N_PROFILE_CTRL:
                     InitPrintCtrl(outputdir, "NO3", prtvrbl[i],
-                        HYDROL_STEP, nelem, &print->varctrl[n]);
+                        HYDROL_STEP, ELEM_VAR, nelem, &print->varctrl[n]);
                     for (j = 0; j < nelem; j++)
                     {
                         print->varctrl[n].var[j] = &elem[j].ps.no3;
@@ -806,7 +806,7 @@ void MapOutput(const char outputdir[], const int prtvrbl[],
                     n++;
 
                     InitPrintCtrl(outputdir, "NH4", prtvrbl[i],
-                        HYDROL_STEP, nelem, &print->varctrl[n]);
+                        HYDROL_STEP, ELEM_VAR, nelem, &print->varctrl[n]);
                     for (j = 0; j < nelem; j++)
                     {
                         print->varctrl[n].var[j] = &elem[j].ps.nh4;
@@ -815,7 +815,7 @@ void MapOutput(const char outputdir[], const int prtvrbl[],
                     break;
                 case N_RIVER_CTRL:
                     InitPrintCtrl(outputdir, "river.NO3", prtvrbl[i],
-                        HYDROL_STEP, nriver, &print->varctrl[n]);
+                        HYDROL_STEP, RIVER_VAR, nriver, &print->varctrl[n]);
                     for (j = 0; j < nriver; j++)
                     {
                         print->varctrl[n].var[j] = &river[j].ns.no3;
@@ -823,7 +823,7 @@ void MapOutput(const char outputdir[], const int prtvrbl[],
                     n++;
 
                     InitPrintCtrl(outputdir, "river.NH4", prtvrbl[i],
-                        HYDROL_STEP, nriver, &print->varctrl[n]);
+                        HYDROL_STEP, RIVER_VAR, nriver, &print->varctrl[n]);
                     for (j = 0; j < nriver; j++)
                     {
                         print->varctrl[n].var[j] = &river[j].ns.nh4;
@@ -832,7 +832,7 @@ void MapOutput(const char outputdir[], const int prtvrbl[],
                     break;
                 case DENITRIF_CTRL:
                     InitPrintCtrl(outputdir, "denitrif", prtvrbl[i],
-                        CN_STEP, nelem, &print->varctrl[n]);
+                        CN_STEP, ELEM_VAR, nelem, &print->varctrl[n]);
                     for (j = 0; j < nelem; j++)
                     {
                         print->varctrl[n].var[j] = &elem[j].ps.denitrif;
@@ -841,7 +841,7 @@ void MapOutput(const char outputdir[], const int prtvrbl[],
                     break;
                 case LEACHING_CTRL:
                     InitPrintCtrl(outputdir, "river.NO3leaching", prtvrbl[i],
-                        HYDROL_STEP, nriver, &print->varctrl[n]);
+                        HYDROL_STEP, RIVER_VAR, nriver, &print->varctrl[n]);
                     for (j = 0; j < nriver; j++)
                     {
                         print->varctrl[n].var[j] =
@@ -850,7 +850,7 @@ void MapOutput(const char outputdir[], const int prtvrbl[],
                     n++;
 
                     InitPrintCtrl(outputdir, "river.NH4leaching", prtvrbl[i],
-                        HYDROL_STEP, nriver, &print->varctrl[n]);
+                        HYDROL_STEP, RIVER_VAR, nriver, &print->varctrl[n]);
                     for (j = 0; j < nriver; j++)
                     {
                         print->varctrl[n].var[j] =
@@ -860,7 +860,7 @@ void MapOutput(const char outputdir[], const int prtvrbl[],
                     break;
                 case SOC_CTRL:
                     InitPrintCtrl(outputdir, "soc", prtvrbl[i],
-                        CN_STEP, nelem, &print->varctrl[n]);
+                        CN_STEP, ELEM_VAR, nelem, &print->varctrl[n]);
                     for (j = 0; j < nelem; j++)
                     {
                         print->varctrl[n].var[j] = &elem[j].ps.soc;
@@ -869,7 +869,7 @@ void MapOutput(const char outputdir[], const int prtvrbl[],
                     break;
                 case LAI_CTRL:
                     InitPrintCtrl(outputdir, "lai", prtvrbl[i],
-                        CN_STEP, nelem, &print->varctrl[n]);
+                        CN_STEP, ELEM_VAR, nelem, &print->varctrl[n]);
                     for (j = 0; j < nelem; j++)
                     {
                         print->varctrl[n].var[j] = &elem[j].ps.proj_lai;
@@ -880,7 +880,7 @@ void MapOutput(const char outputdir[], const int prtvrbl[],
 #if defined(_DGW_)
                 case GEOLUNSAT_CTRL:
                     InitPrintCtrl(outputdir, "deep.unsat", prtvrbl[i],
-                        HYDROL_STEP, nelem, &print->varctrl[n]);
+                        HYDROL_STEP, ELEM_VAR, nelem, &print->varctrl[n]);
                     for (j = 0; j < nelem; j++)
                     {
                         print->varctrl[n].var[j] = &elem[j].ws.unsat_geol;
@@ -889,7 +889,7 @@ void MapOutput(const char outputdir[], const int prtvrbl[],
                     break;
                 case GEOLGW_CTRL:
                     InitPrintCtrl(outputdir, "deep.gw", prtvrbl[i],
-                        HYDROL_STEP, nelem, &print->varctrl[n]);
+                        HYDROL_STEP, ELEM_VAR, nelem, &print->varctrl[n]);
                     for (j = 0; j < nelem; j++)
                     {
                         print->varctrl[n].var[j] = &elem[j].ws.gw_geol;
@@ -898,7 +898,7 @@ void MapOutput(const char outputdir[], const int prtvrbl[],
                     break;
                 case GEOLINFIL_CTRL:
                     InitPrintCtrl(outputdir, "deep.infil", prtvrbl[i],
-                        HYDROL_STEP, nelem, &print->varctrl[n]);
+                        HYDROL_STEP, ELEM_VAR, nelem, &print->varctrl[n]);
                     for (j = 0; j < nelem; j++)
                     {
                         print->varctrl[n].var[j] = &elem[j].wf.infil_geol;
@@ -907,7 +907,7 @@ void MapOutput(const char outputdir[], const int prtvrbl[],
                     break;
                 case GEOLRECHG_CTRL:
                     InitPrintCtrl(outputdir, "deep.recharge", prtvrbl[i],
-                        HYDROL_STEP, nelem, &print->varctrl[n]);
+                        HYDROL_STEP, ELEM_VAR, nelem, &print->varctrl[n]);
                     for (j = 0; j < nelem; j++)
                     {
                         print->varctrl[n].var[j] = &elem[j].wf.rechg_geol;
@@ -919,7 +919,7 @@ void MapOutput(const char outputdir[], const int prtvrbl[],
                     {
                         sprintf(ext, "deep.flow%d", k);
                         InitPrintCtrl(outputdir, ext, prtvrbl[i],
-                            HYDROL_STEP, nelem, &print->varctrl[n]);
+                            HYDROL_STEP, ELEM_VAR, nelem, &print->varctrl[n]);
                         for (j = 0; j < nelem; j++)
                         {
                             print->varctrl[n].var[j] = &elem[j].wf.dgw[k];
@@ -939,7 +939,7 @@ void MapOutput(const char outputdir[], const int prtvrbl[],
                         /* Unsaturated zone concentration */
                         sprintf(ext, "conc.%s", chemn);
                         InitPrintCtrl(outputdir, ext, prtvrbl[i],
-                            RT_STEP, nelem, &print->varctrl[n]);
+                            RT_STEP, ELEM_VAR, nelem, &print->varctrl[n]);
                         for (j = 0; j < nelem; j++)
                         {
                             print->varctrl[n].var[j] =
@@ -950,7 +950,7 @@ void MapOutput(const char outputdir[], const int prtvrbl[],
                         /* Deep zone concentration */
                         sprintf(ext, "deep.conc.%s", chemn);
                         InitPrintCtrl(outputdir, ext, prtvrbl[i],
-                            RT_STEP, nelem, &print->varctrl[n]);
+                            RT_STEP, ELEM_VAR, nelem, &print->varctrl[n]);
                         for (j = 0; j < nelem; j++)
                         {
                             print->varctrl[n].var[j] =
@@ -962,7 +962,7 @@ void MapOutput(const char outputdir[], const int prtvrbl[],
                         /* River concentration */
                         sprintf(ext, "river.conc.%s", chemn);
                         InitPrintCtrl(outputdir, ext, prtvrbl[i],
-                            RT_STEP, nriver, &print->varctrl[n]);
+                            RT_STEP, RIVER_VAR, nriver, &print->varctrl[n]);
                         for (j = 0; j < nriver; j++)
                         {
                             print->varctrl[n].var[j] =
@@ -973,7 +973,7 @@ void MapOutput(const char outputdir[], const int prtvrbl[],
                         /* River fluxes */
                         sprintf(ext, "river.chflx.%s", chemn);
                         InitPrintCtrl(outputdir, ext, prtvrbl[i],
-                            RT_STEP, nriver, &print->varctrl[n]);
+                            RT_STEP, RIVER_VAR, nriver, &print->varctrl[n]);
                         for (j = 0; j < nriver; j++)
                         {
                             print->varctrl[n].var[j] =
@@ -990,7 +990,7 @@ void MapOutput(const char outputdir[], const int prtvrbl[],
 
                         sprintf(ext, "conc.%s", chemn);
                         InitPrintCtrl(outputdir, ext, prtvrbl[i],
-                            RT_STEP, nelem, &print->varctrl[n]);
+                            RT_STEP, ELEM_VAR, nelem, &print->varctrl[n]);
                         for (j = 0; j < nelem; j++)
                         {
                             print->varctrl[n].var[j] =
@@ -1001,7 +1001,7 @@ void MapOutput(const char outputdir[], const int prtvrbl[],
 # if defined(_DGW_)
                         sprintf(ext, "deep.conc.%s", chemn);
                         InitPrintCtrl(outputdir, ext, prtvrbl[i],
-                            RT_STEP, nelem, &print->varctrl[n]);
+                            RT_STEP, ELEM_VAR, nelem, &print->varctrl[n]);
                         for (j = 0; j < nelem; j++)
                         {
                             print->varctrl[n].var[j] =
@@ -1041,10 +1041,10 @@ void MapOutput(const char outputdir[], const int prtvrbl[],
     {
         sprintf(ext, "elem%d.wflux", i + 1);
 # if defined(_DGW_)
-        InitPrintCtrl(outputdir, ext, DAILY_OUTPUT, HYDROL_STEP, 16,
+        InitPrintCtrl(outputdir, ext, DAILY_OUTPUT, HYDROL_STEP, MISC_VAR, 16,
             &print->varctrl[n]);
 # else
-        InitPrintCtrl(outputdir, ext, DAILY_OUTPUT, HYDROL_STEP, 11,
+        InitPrintCtrl(outputdir, ext, DAILY_OUTPUT, HYDROL_STEP, MISC_VAR, 11,
             &print->varctrl[n]);
 # endif
         print->varctrl[n].var[0] = &elem[i].wf.infil;
@@ -1069,10 +1069,10 @@ void MapOutput(const char outputdir[], const int prtvrbl[],
 
         sprintf(ext, "elem%d.wstate", i + 1);
 # if defined(_DGW_)
-        InitPrintCtrl(outputdir, ext, DAILY_OUTPUT, HYDROL_STEP, 7,
+        InitPrintCtrl(outputdir, ext, DAILY_OUTPUT, HYDROL_STEP, MISC_VAR, 7,
             &print->varctrl[n]);
 # else
-        InitPrintCtrl(outputdir, ext, DAILY_OUTPUT, HYDROL_STEP, 5,
+        InitPrintCtrl(outputdir, ext, DAILY_OUTPUT, HYDROL_STEP, MISC_VAR, 5,
             &print->varctrl[n]);
 # endif
         print->varctrl[n].var[0] = &elem[i].ws.cmc;
@@ -1088,8 +1088,8 @@ void MapOutput(const char outputdir[], const int prtvrbl[],
 
 # if defined(_NOAH_)
         sprintf(ext, "elem%d.smc", i + 1);
-        InitPrintCtrl(outputdir, ext, DAILY_OUTPUT, HYDROL_STEP, MAXLYR,
-            &print->varctrl[n]);
+        InitPrintCtrl(outputdir, ext, DAILY_OUTPUT, HYDROL_STEP, MISC_VAR,
+            MAXLYR, &print->varctrl[n]);
         for (k = 0; k < MAXLYR; k++)
         {
             print->varctrl[n].var[k] = &elem[i].ws.smc[k];
@@ -1097,8 +1097,8 @@ void MapOutput(const char outputdir[], const int prtvrbl[],
         n++;
 
         sprintf(ext, "elem%d.swc", i + 1);
-        InitPrintCtrl(outputdir, ext, DAILY_OUTPUT, HYDROL_STEP, MAXLYR,
-            &print->varctrl[n]);
+        InitPrintCtrl(outputdir, ext, DAILY_OUTPUT, HYDROL_STEP, MISC_VAR,
+            MAXLYR, &print->varctrl[n]);
         for (k = 0; k < MAXLYR; k++)
         {
             print->varctrl[n].var[k] = &elem[i].ws.swc[k];
@@ -1106,8 +1106,8 @@ void MapOutput(const char outputdir[], const int prtvrbl[],
         n++;
 
         sprintf(ext, "elem%d.stc", i + 1);
-        InitPrintCtrl(outputdir, ext, DAILY_OUTPUT, HYDROL_STEP, MAXLYR,
-            &print->varctrl[n]);
+        InitPrintCtrl(outputdir, ext, DAILY_OUTPUT, HYDROL_STEP, MISC_VAR,
+            MAXLYR, &print->varctrl[n]);
         for (k = 0; k < MAXLYR; k++)
         {
             print->varctrl[n].var[k] = &elem[i].es.stc[k];
@@ -1115,7 +1115,7 @@ void MapOutput(const char outputdir[], const int prtvrbl[],
         n++;
 
         sprintf(ext, "elem%d.ls", i + 1);
-        InitPrintCtrl(outputdir, ext, DAILY_OUTPUT, LS_STEP, 12,
+        InitPrintCtrl(outputdir, ext, DAILY_OUTPUT, LS_STEP, MISC_VAR, 12,
             &print->varctrl[n]);
         print->varctrl[n].var[0] = &elem[i].es.t1;
         print->varctrl[n].var[1] = &elem[i].ps.snowh;
@@ -1135,7 +1135,7 @@ void MapOutput(const char outputdir[], const int prtvrbl[],
 # if defined(_RT_)
         sprintf(ext, "elem%d.conc", i + 1);
         InitPrintCtrl(outputdir, ext, DAILY_OUTPUT, RT_STEP,
-            rttbl->num_stc + rttbl->num_ssc, &print->varctrl[n]);
+            MISC_VAR, rttbl->num_stc + rttbl->num_ssc, &print->varctrl[n]);
         for (k = 0; k < rttbl->num_stc; k++)
         {
             print->varctrl[n].var[k] = &elem[i].chms.prim_conc[k];
@@ -1150,7 +1150,7 @@ void MapOutput(const char outputdir[], const int prtvrbl[],
 #  if defined(_DGW_)
         sprintf(ext, "elem%d.deep.conc", i + 1);
         InitPrintCtrl(outputdir, ext, DAILY_OUTPUT, RT_STEP,
-            rttbl->num_stc + rttbl->num_ssc, &print->varctrl[n]);
+            MISC_VAR, rttbl->num_stc + rttbl->num_ssc, &print->varctrl[n]);
         for (k = 0; k < rttbl->num_stc; k++)
         {
             print->varctrl[n].var[k] = &elem[i].chms_geol.prim_conc[k];
@@ -1166,29 +1166,29 @@ void MapOutput(const char outputdir[], const int prtvrbl[],
     }
 
     InitPrintCtrl(outputdir, "river.wflux", DAILY_OUTPUT, HYDROL_STEP,
-        NUM_RIVFLX, &print->varctrl[n]);
+        MISC_VAR, NUM_RIVFLX, &print->varctrl[n]);
     for (k = 0; k < NUM_RIVFLX; k++)
     {
         print->varctrl[n].var[k] = &river[0].wf.rivflow[k];
     }
     n++;
 
-    InitPrintCtrl(outputdir, "river.wstate", DAILY_OUTPUT, HYDROL_STEP, 1,
-        &print->varctrl[n]);
+    InitPrintCtrl(outputdir, "river.wstate", DAILY_OUTPUT, HYDROL_STEP,
+        MISC_VAR, 1, &print->varctrl[n]);
     print->varctrl[n].var[0] = &river[0].ws.stage;
     n++;
 
 # if defined(_RT_)
     InitPrintCtrl(outputdir, "river.conc", DAILY_OUTPUT, RT_STEP,
-        rttbl->num_stc, &print->varctrl[n]);
+        MISC_VAR, rttbl->num_stc, &print->varctrl[n]);
     for (k = 0; k < rttbl->num_stc; k++)
     {
         print->varctrl[n].var[k] = &river[0].chms.prim_conc[k];
     }
     n++;
 
-    InitPrintCtrl(outputdir, "leach", DAILY_OUTPUT, RT_STEP, rttbl->num_stc,
-        &print->varctrl[n]);
+    InitPrintCtrl(outputdir, "leach", DAILY_OUTPUT, RT_STEP, MISC_VAR,
+        rttbl->num_stc, &print->varctrl[n]);
     for (k = 0; k < rttbl->num_stc; k++)
     {
         print->varctrl[n].var[k] = &river[0].solute[k].flux[DOWNSTREAM];
@@ -1197,7 +1197,7 @@ void MapOutput(const char outputdir[], const int prtvrbl[],
 
 #  if defined(_DGW_)
     InitPrintCtrl(outputdir, "left_leach", DAILY_OUTPUT, RT_STEP,
-        rttbl->num_stc, &print->varctrl[n]);
+        MISC_VAR, rttbl->num_stc, &print->varctrl[n]);
     for (k = 0; k < rttbl->num_stc; k++)
     {
         print->varctrl[n].var[k] = &river[0].solute[k].flux[DGW_LEFT];
@@ -1205,7 +1205,7 @@ void MapOutput(const char outputdir[], const int prtvrbl[],
     n++;
 
     InitPrintCtrl(outputdir, "right_leach", DAILY_OUTPUT, RT_STEP,
-        rttbl->num_stc, &print->varctrl[n]);
+        MISC_VAR, rttbl->num_stc, &print->varctrl[n]);
     for (k = 0; k < rttbl->num_stc; k++)
     {
         print->varctrl[n].var[k] = &river[0].solute[k].flux[DGW_RIGHT];
@@ -1226,13 +1226,14 @@ void MapOutput(const char outputdir[], const int prtvrbl[],
 #endif
 
 void InitPrintCtrl(const char outputdir[], const char ext[], int intvl,
-    int upd_intvl, int nvar, varctrl_struct *varctrl)
+    int upd_intvl, int vartype, int nvar, varctrl_struct *varctrl)
 {
     sprintf(varctrl->name, "%s%s.%s", outputdir, project, ext);
 
     /* When spinning-up, print interval is set to monthly */
     varctrl->intvl     = (spinup_mode) ? MONTHLY_OUTPUT: intvl;
     varctrl->upd_intvl = upd_intvl;
+    varctrl->vartype   = vartype;
     varctrl->nvar      = nvar;
     varctrl->var       = (const double **)malloc(nvar * sizeof(double *));
     varctrl->buffer    = (double *)calloc(nvar, sizeof(double));
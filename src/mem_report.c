@@ -0,0 +1,138 @@
+#include "pihm.h"
+
+void PrintMemReport(const pihm_struct pihm)
+{
+    /*
+     * Print the bytes of model data per element and per river segment, by
+     * module. Species arrays of reactive transport are allocated outside of
+     * the element and river structures and are counted in their module.
+     * Initial conditions and restart inputs are freed after initialization
+     */
+    const elem_struct *elem = &pihm->elem[0];
+    size_t          mesh, hydrol, lsm, total, other;
+    size_t          heap = 0;
+    size_t          init;
+    size_t          river;
+#if defined(_BGC_) || defined(_CYCLES_) || defined(_RT_)
+    size_t          solute;
+#endif
+#if defined(_BGC_)
+    size_t          bgc;
+#endif
+#if defined(_CYCLES_)
+    size_t          cycles;
+#endif
+#if defined(_DAILY_)
+    size_t          daily;
+#endif
+#if defined(_RT_)
+    size_t          rt;
+#endif
+
+    mesh = sizeof(elem->node) + sizeof(elem->nabr) + sizeof(elem->nabr_river) +
+        sizeof(elem->ind) + sizeof(elem->id) + sizeof(elem->attrib) +
+        sizeof(elem->topo);
+    hydrol = sizeof(elem->soil) + sizeof(elem->bc) + sizeof(elem->ws) +
+        sizeof(elem->ws0) + sizeof(elem->wf);
+#if defined(_DGW_)
+    hydrol += sizeof(elem->geol) + sizeof(elem->bc_geol);
+#endif
+    lsm = sizeof(elem->lc) + sizeof(elem->es) + sizeof(elem->ef) +
+        sizeof(elem->ps) + sizeof(elem->epc);
+    total = mesh + hydrol + lsm;
+
+#if defined(_RT_)
+    heap += nsolute * sizeof(solute_struct);
+    solute = sizeof(elem->solute) + nsolute * sizeof(solute_struct);
+    total += solute;
+#elif defined(_BGC_) || defined(_CYCLES_)
+    solute = sizeof(elem->solute);
+    total += solute;
+#endif
+
+#if defined(_BGC_)
+    bgc = sizeof(elem->cs) + sizeof(elem->cf) + sizeof(elem->ns) +
+        sizeof(elem->nf) + sizeof(elem->psn_sun) + sizeof(elem->psn_shade) +
+        sizeof(elem->nt) + sizeof(elem->summary) + sizeof(elem->epv) +
+        sizeof(elem->spinup);
+    total += bgc;
+#endif
+
+#if defined(_CYCLES_)
+    cycles = sizeof(elem->crop) + sizeof(elem->mgmt) + sizeof(elem->weather) +
+        sizeof(elem->cs) + sizeof(elem->cf) + sizeof(elem->ns) +
+        sizeof(elem->nf);
+    total += cycles;
+#endif
+
+#if defined(_DAILY_)
+    daily = sizeof(elem->daily);
+    total += daily;
+#endif
+
+#if defined(_RT_)
+    heap += ElemChmSize(&pihm->rttbl) * sizeof(double);
+    rt = sizeof(elem->prcpchm) + sizeof(elem->chms) + sizeof(elem->chmf) +
+        ElemChmSize(&pihm->rttbl) * sizeof(double);
+# if defined(_DGW_)
+    rt += sizeof(elem->chms_geol);
+# endif
+    total += rt;
+#endif
+
+    /* Padding of the element structure is reported on its own */
+    other = sizeof(elem_struct) + heap - total;
+    total += other;
+
+    init = sizeof(ic_struct);
+#if defined(_BGC_)
+    init += sizeof(bgcic_struct);
+#endif
+#if defined(_CYCLES_)
+    init += sizeof(agic_struct);
+#endif
+#if defined(_RT_)
+    init += NCHMVOL * sizeof(rtic_struct);
+#endif
+
+    river = sizeof(river_struct);
+#if defined(_RT_)
+    river += nsolute * sizeof(river_solute_struct) +
+        ChmStateSize(&pihm->rttbl) * sizeof(double);
+#endif
+
+    pihm_printf(VL_NORMAL, "\nMemory per element (bytes):\n");
+    pihm_printf(VL_NORMAL, "  %-22s%lu\n", "mesh", (unsigned long)mesh);
+    pihm_printf(VL_NORMAL, "  %-22s%lu\n", "hydrology", (unsigned long)hydrol);
+    pihm_printf(VL_NORMAL, "  %-22s%lu\n", "land surface",
+        (unsigned long)lsm);
+#if defined(_BGC_) || defined(_CYCLES_) || defined(_RT_)
+    pihm_printf(VL_NORMAL, "  %-22s%lu\n", "solute transport",
+        (unsigned long)solute);
+#endif
+#if defined(_BGC_)
+    pihm_printf(VL_NORMAL, "  %-22s%lu\n", "biogeochemistry",
+        (unsigned long)bgc);
+#endif
+#if defined(_CYCLES_)
+    pihm_printf(VL_NORMAL, "  %-22s%lu\n", "Cycles", (unsigned long)cycles);
+#endif
+#if defined(_DAILY_)
+    pihm_printf(VL_NORMAL, "  %-22s%lu\n", "daily averages",
+        (unsigned long)daily);
+#endif
+#if defined(_RT_)
+    pihm_printf(VL_NORMAL, "  %-22s%lu\n", "reactive transport",
+        (unsigned long)rt);
+#endif
+    pihm_printf(VL_NORMAL, "  %-22s%lu\n", "padding", (unsigned long)other);
+    pihm_printf(VL_NORMAL, "  %-22s%lu\n", "total", (unsigned long)total);
+    pihm_printf(VL_NORMAL, "Memory per river segment (bytes): %lu\n",
+        (unsigned long)river);
+    pihm_printf(VL_NORMAL,
+        "Ecophysiological constants shared by %d land cover types (bytes): "
+        "%lu\n", pihm->lctbl.number,
+        (unsigned long)(pihm->lctbl.number * sizeof(epconst_struct)));
+    pihm_printf(VL_NORMAL, "Initial conditions and restart inputs freed after "
+        "initialization (bytes per element): %lu\n", (unsigned long)init);
+}
@@ -54,7 +54,7 @@ void InitLsm(const char ice_fn[], const ctrl_struct *ctrl,
 
         /* Set-up glacier ice parameters */
         elem[i].ps.iceh = (elem[i].lc.glacier == 1) ?
-            ((read_ice_flag == 1) ? iceh[i] : ICEH) : 0.0;
+            ((read_ice_flag == 1) ? iceh[elem[i].id - 1] : ICEH) : 0.0;
 
         /* Set-up soil parameters */
         elem[i].ps.nmacd = FindLayer(elem[i].ps.nlayers, elem[i].soil.dmac,
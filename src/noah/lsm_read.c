@@ -146,6 +146,19 @@ void ReadRad(const char fn[], forc_struct *forc)
     int             index;
     char            cmdstr[MAXSTRING];
     int             lno = 0;
+    double          row[2];
+
+    if (MapForcing(fn, 2, &forc->nrad, &forc->rad, forc))
+    {
+        if (forc->nrad != forc->nmeteo)
+        {
+            pihm_printf(VL_ERROR, "The number of radiation forcing time series "
+                "should be the same as the number of\nmeteorological forcing "
+                "time series.\nError in %s.bin.\n", fn);
+            pihm_exit(EXIT_FAILURE);
+        }
+        return;
+    }
 
     fp = pihm_fopen(fn, "r");
     pihm_printf(VL_VERBOSE, " Reading %s\n", fn);
@@ -193,18 +206,17 @@ void ReadRad(const char fn[], forc_struct *forc)
         NextLine(fp, cmdstr, &lno);
         NextLine(fp, cmdstr, &lno);
 
-        forc->rad[i].ftime = (int *)malloc(forc->rad[i].length * sizeof(int));
-        forc->rad[i].data =
-            (double **)malloc(forc->rad[i].length * sizeof(double *));
+        NewTs(forc->rad[i].length, 2, &forc->rad[i]);
         for (j = 0; j < forc->rad[i].length; j++)
         {
-            forc->rad[i].data[j] = (double *)malloc(2 * sizeof(double));
             NextLine(fp, cmdstr, &lno);
-            if (!ReadTs(cmdstr, 2, &forc->rad[i].ftime[j],
-                &forc->rad[i].data[j][0]))
+            if (!ReadTs(cmdstr, 2, &forc->rad[i].ftime[j], row))
             {
                 pihm_error(ERR_WRONG_FORMAT, fn, lno);
             }
+
+            forc->rad[i].data[0][j] = row[0];
+            forc->rad[i].data[1][j] = row[1];
         }
     }
 
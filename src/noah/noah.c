@@ -1,16 +1,28 @@
 #include "pihm.h"
 
-void Noah(double dt, const lctbl_struct *lctbl, const calib_struct *calib,
-    elem_struct elem[])
+int Noah(double dt, const lctbl_struct *lctbl, const calib_struct *calib,
+    sched_struct *sched, elem_struct elem[])
 {
-    int             i;
+    /*
+     * Returns the number of elements of which land cover has changed.
+     * Elements are visited in the order of the cost-aware schedule, because
+     * snow, frozen soil, and glaciers make some elements much more expensive
+     * than others
+     */
+    int             k;
+    int             nlc = 0;
 
 #if defined(_OPENMP)
-# pragma omp parallel for
+# pragma omp parallel for schedule(dynamic, 1) reduction(+:nlc)
 #endif
-    for (i = 0; i < nelem; i++)
+    for (k = 0; k < nelem; k++)
     {
+        int             i;
         int             kz;
+        double          start;
+
+        i = sched->order[k];
+        start = WallClock();
 
         /* When ice on a glacier grid is all melted, turn land use to barren */
         if (elem[i].lc.glacier == 1 && elem[i].ps.iceh <= 0.0)
@@ -19,6 +31,7 @@ void Noah(double dt, const lctbl_struct *lctbl, const calib_struct *calib,
             elem[i].attrib.lc = IGBP_BARREN;
 
             _InitLc(lctbl, calib, &elem[i]);
+            nlc++;
         }
 
         CalHum(&elem[i].ps, &elem[i].es);
@@ -56,7 +69,7 @@ void Noah(double dt, const lctbl_struct *lctbl, const calib_struct *calib,
                 elem[i].crop, &elem[i].ps, &elem[i].ws, &elem[i].wf,
                 &elem[i].es, &elem[i].ef);
 #else
-            SFlx(dt, &elem[i].soil, &elem[i].lc, &elem[i].epc, &elem[i].ps,
+            SFlx(dt, &elem[i].soil, &elem[i].lc, elem[i].epc, &elem[i].ps,
                 &elem[i].ws, &elem[i].wf, &elem[i].es, &elem[i].ef);
 #endif
         }
@@ -65,7 +78,11 @@ void Noah(double dt, const lctbl_struct *lctbl, const calib_struct *calib,
         elem[i].wf.ec   = elem[i].ef.ec / LVH2O / 1000.0;
         elem[i].wf.ett  = elem[i].ef.ett / LVH2O / 1000.0;
         elem[i].wf.edir = elem[i].ef.edir / LVH2O / 1000.0;
+
+        SchedRecord(i, start, sched);
     }
+
+    return nlc;
 }
 
 void NoahHydrol(double dt, elem_struct elem[])
@@ -156,9 +173,9 @@ void SFlx(double dt, const weather_struct *weather, const cstate_struct *cs,
     soil_struct *soil, lc_struct *lc, crop_struct crop[], phystate_struct *ps,
     wstate_struct *ws, wflux_struct *wf, estate_struct *es, eflux_struct *ef)
 #else
-void SFlx(double dt, soil_struct *soil, lc_struct *lc, epconst_struct *epc,
-    phystate_struct *ps, wstate_struct *ws, wflux_struct *wf, estate_struct *es,
-    eflux_struct *ef)
+void SFlx(double dt, soil_struct *soil, lc_struct *lc,
+    const epconst_struct *epc, phystate_struct *ps, wstate_struct *ws,
+    wflux_struct *wf, estate_struct *es, eflux_struct *ef)
 #endif
 {
     /*
@@ -205,10 +222,9 @@ void SFlx(double dt, soil_struct *soil, lc_struct *lc, epconst_struct *epc,
     /* Urban */
     if (lc->isurban)
     {
+        /* Urban minimum canopy resistance is set in the shared constants of
+         * the land cover type (see InitEpc) */
         lc->shdfac = 0.05;
-#if !defined(_CYCLES_)
-        epc->rsmin = 400.0;
-#endif
         /* In original Noah LSM, urban model changes urban soil porosity. In
          * Flux-PIHM, porosity should not be changed because it is also used in
          * PIHM hydrology calculation. In addition, field capacity and wilting
@@ -2,6 +2,14 @@
 
 int Ode(realtype t, N_Vector CV_Y, N_Vector CV_Ydot, void *pihm_data)
 {
+    /*
+     * All phases of a RHS evaluation run in one parallel region. Loops over
+     * elements and river segments are shared among the threads with static
+     * schedules, so that a thread works on the same elements in every phase
+     * and at every call, and phases only wait for each other where a loop
+     * reads results of other threads. Functions called in the region share
+     * their loops with orphaned worksharing constructs
+     */
     int             i;
     double         *y;
     double         *dy;
@@ -16,286 +24,307 @@ int Ode(realtype t, N_Vector CV_Y, N_Vector CV_Ydot, void *pihm_data)
     elem = &pihm->elem[0];
     river = &pihm->river[0];
 
-    /*
-     * Initialization of RHS of ODEs
-     */
 #if defined(_OPENMP)
-# pragma omp parallel for
+# pragma omp parallel
 #endif
-    for (i = 0; i < NumStateVar(); i++)
     {
-        dy[i] = 0.0;
-    }
+        /*
+         * Initialization of RHS of ODEs
+         */
+#if defined(_OPENMP)
+# pragma omp for schedule(static) nowait
+#endif
+        for (i = 0; i < NumStateVar(); i++)
+        {
+            dy[i] = 0.0;
+        }
 
 #if defined(_OPENMP)
-# pragma omp parallel for
+# pragma omp for schedule(static) nowait
 #endif
-    for (i = 0; i < nelem; i++)
-    {
-        elem[i].ws.surf  = MAX(y[SURF(i)], 0.0);
-        elem[i].ws.unsat = MAX(y[UNSAT(i)], 0.0);
-        elem[i].ws.gw    = MAX(y[GW(i)], 0.0);
+        for (i = 0; i < nelem; i++)
+        {
+            elem[i].ws.surf  = MAX(y[SURF(i)], 0.0);
+            elem[i].ws.unsat = MAX(y[UNSAT(i)], 0.0);
+            elem[i].ws.gw    = MAX(y[GW(i)], 0.0);
+
+            /* Mirror of states read by the lateral flux kernels */
+            pihm->hydro.gw[i] = elem[i].ws.gw;
 
 #if defined(_DGW_)
-        elem[i].ws.unsat_geol = MAX(y[UNSAT_GEOL(i)], 0.0);
-        elem[i].ws.gw_geol    = MAX(y[GW_GEOL(i)], 0.0);
+            elem[i].ws.unsat_geol = MAX(y[UNSAT_GEOL(i)], 0.0);
+            elem[i].ws.gw_geol    = MAX(y[GW_GEOL(i)], 0.0);
 #endif
 
 #if defined(_BGC_) && !defined(_LUMPEDBGC_)
-        elem[i].ns.sminn = MAX(y[SOLUTE_SOIL(i, 0)], 0.0);
+            elem[i].ns.sminn = MAX(y[SOLUTE_SOIL(i, 0)], 0.0);
 #endif
 
 #if defined(_CYCLES_)
-        elem[i].ps.no3 = MAX(y[SOLUTE_SOIL(i, NO3)], 0.0);
-        elem[i].ps.nh4 = MAX(y[SOLUTE_SOIL(i, NH4)], 0.0);
+            elem[i].ps.no3 = MAX(y[SOLUTE_SOIL(i, NO3)], 0.0);
+            elem[i].ps.nh4 = MAX(y[SOLUTE_SOIL(i, NH4)], 0.0);
 #endif
 
 #if defined(_RT_)
-        int             k;
+            int             k;
 
-        for (k = 0; k < nsolute; k++)
-        {
-            elem[i].chms.tot_mol[k] = MAX(y[SOLUTE_SOIL(i, k)], 0.0);
+            for (k = 0; k < nsolute; k++)
+            {
+                elem[i].chms.tot_mol[k] = MAX(y[SOLUTE_SOIL(i, k)], 0.0);
 # if defined(_DGW_)
-            elem[i].chms_geol.tot_mol[k] = MAX(y[SOLUTE_GEOL(i, k)], 0.0);
+                elem[i].chms_geol.tot_mol[k] =
+                    MAX(y[SOLUTE_GEOL(i, k)], 0.0);
 # endif
-        }
+            }
 #endif
-    }
+        }
 
 #if defined(_BGC_) && defined(_LUMPEDBGC_)
-    elem[LUMPEDBGC].ns.sminn = MAX(y[LUMPEDBGC_SMINN], 0.0);
+# if defined(_OPENMP)
+#  pragma omp single nowait
+# endif
+        elem[LUMPEDBGC].ns.sminn = MAX(y[LUMPEDBGC_SMINN], 0.0);
 #endif
 
 #if defined(_OPENMP)
-# pragma omp parallel for
+# pragma omp for schedule(static) nowait
 #endif
-    for (i = 0; i < nriver; i++)
-    {
-        river[i].ws.stage = MAX(y[RIVER(i)], 0.0);
+        for (i = 0; i < nriver; i++)
+        {
+            river[i].ws.stage = MAX(y[RIVER(i)], 0.0);
 
 #if defined(_BGC_) && !defined(_LUMPEDBGC_) && !defined(_LEACHING_)
-        river[i].ns.streamn = MAX(y[SOLUTE_RIVER(i, 0)], 0.0);
+            river[i].ns.streamn = MAX(y[SOLUTE_RIVER(i, 0)], 0.0);
 #endif
 
 #if defined(_CYCLES_)
-        river[i].ns.no3 = MAX(y[SOLUTE_RIVER(i, NO3)], 0.0);
-        river[i].ns.nh4 = MAX(y[SOLUTE_RIVER(i, NH4)], 0.0);
+            river[i].ns.no3 = MAX(y[SOLUTE_RIVER(i, NO3)], 0.0);
+            river[i].ns.nh4 = MAX(y[SOLUTE_RIVER(i, NH4)], 0.0);
 #endif
 
 #if defined(_RT_)
-        int             k;
+            int             k;
 
-        for (k = 0; k < nsolute; k++)
-        {
-            river[i].chms.tot_mol[k] = MAX(y[SOLUTE_RIVER(i, k)], 0.0);
-        }
+            for (k = 0; k < nsolute; k++)
+            {
+                river[i].chms.tot_mol[k] = MAX(y[SOLUTE_RIVER(i, k)], 0.0);
+            }
 #endif
-    }
+        }
 
-    /*
-     * PIHM Hydrology fluxes
-     */
-    Hydrol(&pihm->ctrl, pihm->elem, pihm->river);
+        /*
+         * PIHM Hydrology fluxes
+         */
+        Hydrol(&pihm->ctrl, pihm->scratch, &pihm->hydro, &pihm->rivnet,
+            pihm->elem, pihm->river);
 
 #if _OBSOLETE_
 #if defined(_BGC_)
-    /*
-     * Nitrogen transport fluxes
-     */
+        /*
+         * Nitrogen transport fluxes
+         */
 # if defined(_LUMPEDBGC_)
-    NLeachingLumped(pihm->elem, pihm->river);
+        NLeachingLumped(pihm->elem, pihm->river);
 # elif defined(_LEACHING_)
-    NLeaching(pihm->elem);
+        NLeaching(pihm->elem);
 # else
-    NTransport(pihm->elem, pihm->river);
+        NTransport(pihm->elem, pihm->river);
 # endif
 #endif
 #endif
 
-    /*
-     * Calculate solute concentrations
-     */
+        /*
+         * Calculate solute concentrations
+         */
 #if defined(_BGC_)
-    SoluteConc(pihm->elem, pihm->river);
+        SoluteConc(pihm->elem, pihm->river);
 #elif defined(_CYCLES_)
-    SoluteConc(t + (realtype)pihm->ctrl.tout[0] -
-        (realtype)pihm->ctrl.tout[pihm->ctrl.cstep], pihm->elem, pihm->river);
+        SoluteConc(t + (realtype)pihm->ctrl.tout[0] -
+            (realtype)pihm->ctrl.tout[pihm->ctrl.cstep], pihm->elem,
+            pihm->river);
 #elif defined(_RT_)
-    SoluteConc(pihm->chemtbl, &pihm->rttbl, pihm->elem, pihm->river);
+        SoluteConc(pihm->chemtbl, &pihm->rttbl, pihm->elem, pihm->river);
 #endif
 
 
 #if defined(_BGC_) || defined(_CYCLES_)
-    SoluteTranspt(0.0, 0.0, 0.0, pihm->elem, pihm->river);
+        SoluteTranspt(0.0, 0.0, 0.0, &pihm->hydro, &pihm->rivnet, pihm->elem,
+            pihm->river);
 #elif defined(_RT_)
-    SoluteTranspt(pihm->rttbl.diff_coef, pihm->rttbl.disp_coef,
-        pihm->rttbl.cementation, pihm->elem, pihm->river);
-#endif
-
-    /*
-     * Build RHS of ODEs
-     */
-#if defined(_OPENMP)
-# pragma omp parallel for
+        SoluteTranspt(pihm->rttbl.diff_coef, pihm->rttbl.disp_coef,
+            pihm->rttbl.cementation, &pihm->hydro, &pihm->rivnet, pihm->elem,
+            pihm->river);
 #endif
-    for (i = 0; i < nelem; i++)
-    {
-        int             j;
 
         /*
-         * Vertical water fluxes for surface and subsurface
+         * Build RHS of ODEs. All fluxes are complete after the barrier at the
+         * end of the river segment accumulation
          */
-        dy[SURF(i)] += elem[i].wf.pcpdrp - elem[i].wf.infil -
-            elem[i].wf.edir_surf;
-        dy[UNSAT(i)] += elem[i].wf.infil - elem[i].wf.recharge -
-            elem[i].wf.edir_unsat - elem[i].wf.ett_unsat;
-        dy[GW(i)] += elem[i].wf.recharge - elem[i].wf.edir_gw -
-            elem[i].wf.ett_gw;
+#if defined(_OPENMP)
+# pragma omp for schedule(static) nowait
+#endif
+        for (i = 0; i < nelem; i++)
+        {
+            int             j;
+
+            /*
+             * Vertical water fluxes for surface and subsurface
+             */
+            dy[SURF(i)] += elem[i].wf.pcpdrp - elem[i].wf.infil -
+                elem[i].wf.edir_surf;
+            dy[UNSAT(i)] += elem[i].wf.infil - elem[i].wf.recharge -
+                elem[i].wf.edir_unsat - elem[i].wf.ett_unsat;
+            dy[GW(i)] += elem[i].wf.recharge - elem[i].wf.edir_gw -
+                elem[i].wf.ett_gw;
 
 #if defined(_DGW_)
-        /*
-         * Vertical water fluxes for deep zone
-         */
-        dy[GW(i)] -= elem[i].wf.infil_geol;
+            /*
+             * Vertical water fluxes for deep zone
+             */
+            dy[GW(i)] -= elem[i].wf.infil_geol;
 
-        dy[UNSAT_GEOL(i)] += elem[i].wf.infil_geol - elem[i].wf.rechg_geol;
-        dy[GW_GEOL(i)]    += elem[i].wf.rechg_geol;
+            dy[UNSAT_GEOL(i)] += elem[i].wf.infil_geol - elem[i].wf.rechg_geol;
+            dy[GW_GEOL(i)]    += elem[i].wf.rechg_geol;
 # if defined(_LUMPED_)
-        dy[GW_GEOL(i)] -= elem[i].wf.dgw_runoff;
+            dy[GW_GEOL(i)] -= elem[i].wf.dgw_runoff;
 # endif
 #endif
 
-        /*
-         * Horizontal water fluxes
-         */
-        for (j = 0; j < NUM_EDGE; j++)
-        {
-            dy[SURF(i)]  -= elem[i].wf.overland[j] / elem[i].topo.area;
-            dy[GW(i)]    -= elem[i].wf.subsurf[j] / elem[i].topo.area;
+            /*
+             * Horizontal water fluxes
+             */
+            for (j = 0; j < NUM_EDGE; j++)
+            {
+                dy[SURF(i)]  -= elem[i].wf.overland[j] / elem[i].topo.area;
+                dy[GW(i)]    -= elem[i].wf.subsurf[j] / elem[i].topo.area;
 #if defined(_DGW_)
-            dy[GW_GEOL(i)] -= elem[i].wf.dgw[j] / elem[i].topo.area;
+                dy[GW_GEOL(i)] -= elem[i].wf.dgw[j] / elem[i].topo.area;
 #endif
-        }
+            }
 
-        dy[UNSAT(i)] /= elem[i].soil.porosity;
-        dy[GW(i)]    /= elem[i].soil.porosity;
+            dy[UNSAT(i)] /= elem[i].soil.porosity;
+            dy[GW(i)]    /= elem[i].soil.porosity;
 #if defined(_DGW_)
-        dy[UNSAT_GEOL(i)] /= elem[i].geol.porosity;
-        dy[GW_GEOL(i)]    /= elem[i].geol.porosity;
+            dy[UNSAT_GEOL(i)] /= elem[i].geol.porosity;
+            dy[GW_GEOL(i)]    /= elem[i].geol.porosity;
 #endif
 
 #if _OBSOLETE_
 #if defined(_BGC_) && !defined(_LUMPEDBGC_)
 # if !defined(_LEACHING_)
-        /*
-         * BGC N transport fluxes
-         */
-        dy[SURFN(i)] +=
-            (elem[i].nf.ndep_to_sminn + elem[i].nf.nfix_to_sminn) / DAYINSEC -
-            elem[i].nsol.infilflux;
-        dy[SMINN(i)] += elem[i].nsol.infilflux + elem[i].nsol.snksrc;
+            /*
+             * BGC N transport fluxes
+             */
+            dy[SURFN(i)] += (elem[i].nf.ndep_to_sminn +
+                elem[i].nf.nfix_to_sminn) / DAYINSEC - elem[i].nsol.infilflux;
+            dy[SMINN(i)] += elem[i].nsol.infilflux + elem[i].nsol.snksrc;
 # else
-        dy[SMINN(i)] +=
-            (elem[i].nf.ndep_to_sminn + elem[i].nf.nfix_to_sminn) / DAYINSEC +
-            elem[i].nsol.snksrc;
+            dy[SMINN(i)] += (elem[i].nf.ndep_to_sminn +
+                elem[i].nf.nfix_to_sminn) / DAYINSEC + elem[i].nsol.snksrc;
 # endif
 
-        for (j = 0; j < NUM_EDGE; j++)
-        {
+            for (j = 0; j < NUM_EDGE; j++)
+            {
 # if !defined(_LEACHING_)
-            dy[SURFN(i)] -= elem[i].nsol.ovlflux[j] / elem[i].topo.area;
+                dy[SURFN(i)] -= elem[i].nsol.ovlflux[j] / elem[i].topo.area;
 # endif
-            dy[SMINN(i)] -= elem[i].nsol.subflux[j] / elem[i].topo.area;
-        }
+                dy[SMINN(i)] -= elem[i].nsol.subflux[j] / elem[i].topo.area;
+            }
 #endif
 #endif
 
 #if defined(_CYCLES_) || defined(_BGC_) || defined(_RT_)
-        int             k;
+            int             k;
 
-        for (k = 0; k < nsolute; k++)
-        {
+            for (k = 0; k < nsolute; k++)
+            {
 # if defined(_CYCLES_)
-            dy[SOLUTE_SOIL(i, k)] += elem[i].solute[k].infil +
-                Profile(elem[i].ps.nlayers, elem[i].solute[k].snksrc);
+                dy[SOLUTE_SOIL(i, k)] += elem[i].solute[k].infil +
+                    Profile(elem[i].ps.nlayers, elem[i].solute[k].snksrc);
 # else
-            dy[SOLUTE_SOIL(i, k)] += elem[i].solute[k].infil +
-                elem[i].solute[k].snksrc;
+                dy[SOLUTE_SOIL(i, k)] += elem[i].solute[k].infil +
+                    elem[i].solute[k].snksrc;
 # endif
 
 # if defined(_DGW_)
-            dy[SOLUTE_SOIL(i, k)] -= elem[i].solute[k].infil_geol;
+                dy[SOLUTE_SOIL(i, k)] -= elem[i].solute[k].infil_geol;
 
-            dy[SOLUTE_GEOL(i, k)] += elem[i].solute[k].infil_geol +
-                elem[i].solute[k].snksrc_geol;
+                dy[SOLUTE_GEOL(i, k)] += elem[i].solute[k].infil_geol +
+                    elem[i].solute[k].snksrc_geol;
 #  if defined(_LUMPED_)
-            dy[SOLUTE_GEOL(i, k)] -= elem[i].solute[k].dgw_leach;
+                dy[SOLUTE_GEOL(i, k)] -= elem[i].solute[k].dgw_leach;
 #  endif
 # endif
 
-            for (j = 0; j < NUM_EDGE; j++)
-            {
-                dy[SOLUTE_SOIL(i, k)] -= elem[i].solute[k].subflux[j] /
-                    elem[i].topo.area;
+                for (j = 0; j < NUM_EDGE; j++)
+                {
+                    dy[SOLUTE_SOIL(i, k)] -= elem[i].solute[k].subflux[j] /
+                        elem[i].topo.area;
 # if defined(_DGW_)
-                dy[SOLUTE_GEOL(i, k)] -= elem[i].solute[k].dgwflux[j] /
-                    elem[i].topo.area;
+                    dy[SOLUTE_GEOL(i, k)] -= elem[i].solute[k].dgwflux[j] /
+                        elem[i].topo.area;
 # endif
+                }
             }
-        }
 #endif
-    }
+        }
 
 #if defined(_BGC_) && defined(_LUMPEDBGC_)
-    elem_struct    *elem;
+# if defined(_OPENMP)
+#  pragma omp single nowait
+# endif
+        {
+            elem_struct    *elem;
 
-    elem = &pihm->elem[LUMPEDBGC];
+            elem = &pihm->elem[LUMPEDBGC];
 
-    dy[LUMPEDBGC_SMINN] +=
-        (elem->nf.ndep_to_sminn + elem->nf.nfix_to_sminn) / DAYINSEC +
-        elem->nsol.snksrc;
+            dy[LUMPEDBGC_SMINN] +=
+                (elem->nf.ndep_to_sminn + elem->nf.nfix_to_sminn) / DAYINSEC +
+                elem->nsol.snksrc;
+        }
 #endif
 
-    /*
-     * ODEs for river segments
-     */
+        /*
+         * ODEs for river segments
+         */
 #if defined(_OPENMP)
-# pragma omp parallel for
+# pragma omp for schedule(static) nowait
 #endif
-    for (i = 0; i < nriver; i++)
-    {
-        int             j;
-
-        for (j = 0; j < NUM_RIVFLX; j++)
+        for (i = 0; i < nriver; i++)
         {
-            /* Note the limitation due to
-             * d(v) / dt = a * dy / dt + y * da / dt
-             * for cs other than rectangle */
-            dy[RIVER(i)] -= river[i].wf.rivflow[j] / river[i].topo.area;
-        }
+            int             j;
+
+            for (j = 0; j < NUM_RIVFLX; j++)
+            {
+                /* Note the limitation due to
+                 * d(v) / dt = a * dy / dt + y * da / dt
+                 * for cs other than rectangle */
+                dy[RIVER(i)] -= river[i].wf.rivflow[j] / river[i].topo.area;
+            }
 
 #if _OBSOLETE_
 #if defined(_BGC_) && !defined(_LUMPEDBGC_) && !defined(_LEACHING_)
-        for (j = 0; j <= 6; j++)
-        {
-            dy[STREAMN(i)] -= river[i].nsol.flux[j] / river[i].topo.area;
-        }
+            for (j = 0; j <= 6; j++)
+            {
+                dy[STREAMN(i)] -= river[i].nsol.flux[j] /
+                    river[i].topo.area;
+            }
 #endif
 #endif
 
 #if defined(_CYCLES_) || defined(_BGC_) || defined(_RT_)
-        int             k;
+            int             k;
 
-        for (k = 0; k < nsolute; k++)
-        {
-            for (j = 0; j < NUM_RIVFLX; j++)
+            for (k = 0; k < nsolute; k++)
             {
-                dy[SOLUTE_RIVER(i, k)] -= river[i].solute[k].flux[j] /
-                    river[i].topo.area;
+                for (j = 0; j < NUM_RIVFLX; j++)
+                {
+                    dy[SOLUTE_RIVER(i, k)] -= river[i].solute[k].flux[j] /
+                        river[i].topo.area;
+                }
             }
-        }
 #endif
+        }
     }
 
     return 0;
@@ -348,12 +377,19 @@ void SetCVodeParam(pihm_struct pihm, void *cvode_mem, SUNLinearSolver *sun_ls,
 
     pihm->ctrl.maxstep = pihm->ctrl.stepsize;
 
+    /* Start a new integration segment at the first model step */
+    pihm->ctrl.tstop = pihm->ctrl.starttime;
+
     if (reset)
     {
         /* When model spins-up and recycles forcing, use CVodeReInit to reset
          * solver time, which does not allocates memory */
         cv_flag = CVodeReInit(cvode_mem, 0.0, CV_Y);
         CheckCVodeFlag(cv_flag);
+
+        /* Solver time restarts from zero, so all root functions are re-armed
+         */
+        ArmEvents(&pihm->event);
     }
     else
     {
@@ -361,10 +397,90 @@ void SetCVodeParam(pihm_struct pihm, void *cvode_mem, SUNLinearSolver *sun_ls,
         CheckCVodeFlag(cv_flag);
         reset = 1;
 
-        *sun_ls = SUNLinSol_SPGMR(CV_Y, PREC_NONE, 0);
+        /* Specifies PIHM data block and attaches it to the main cvode memory
+         * block. User data must be attached before the linear solver,
+         * which passes it on to the preconditioner */
+        cv_flag = CVodeSetUserData(cvode_mem, pihm);
+        CheckCVodeFlag(cv_flag);
+
+        if (pihm->ctrl.linsol == SPARSE_LS)
+        {
+            /* Direct solver on the sparse Jacobian built from mesh adjacency
+             */
+            pihm->jac_pattern = SparseJacPattern(pihm->ctrl.sparse_jac,
+                pihm->elem, pihm->river, &pihm->rivnet);
+            pihm->jac = SUNMatClone(pihm->jac_pattern);
+            SUNMatCopy(pihm->jac_pattern, pihm->jac);
+
+            *sun_ls = NewSparseLu(NumStateVar());
+
+            cv_flag = CVodeSetLinearSolver(cvode_mem, *sun_ls, pihm->jac);
+            CheckCVodeFlag(cv_flag);
+
+            if (pihm->ctrl.sparse_jac == COLOR_FD_JAC)
+            {
+                /* Finite difference Jacobian with one RHS evaluation per
+                 * column color */
+                InitColorJac(pihm->jac_pattern, &pihm->colorjac);
+
+                cv_flag = CVodeSetJacFn(cvode_mem, ColorJac);
+                CheckCVodeFlag(cv_flag);
+            }
+            else
+            {
+                InitJacTimes(&pihm->jtimes);
+
+                cv_flag = CVodeSetJacFn(cvode_mem, SparseJac);
+                CheckCVodeFlag(cv_flag);
+            }
+        }
+        else
+        {
+            *sun_ls = NewKrylov(CV_Y, &pihm->ctrl);
+
+            /* Attach the linear solver */
+            CVodeSetLinearSolver(cvode_mem, *sun_ls, NULL);
+
+            /* Specifies the factor by which the Krylov linear solver's
+             * convergence test constant is reduced from the nonlinear
+             * solver test constant */
+            cv_flag = CVodeSetEpsLin(cvode_mem, (realtype)pihm->ctrl.epslin);
+            CheckCVodeFlag(cv_flag);
+
+            if (pihm->ctrl.precond != PREC_NONE)
+            {
+                /* Block-Jacobi preconditioner built from the vertical coupling
+                 * of each element and the storage of each river segment */
+                InitPrecond(&pihm->prec);
+
+                cv_flag = CVodeSetPreconditioner(cvode_mem, PrecSetup,
+                    PrecSolve);
+                CheckCVodeFlag(cv_flag);
+            }
+
+            if (pihm->ctrl.jtimes)
+            {
+                /* Analytic Jacobian-times-vector product from flux
+                 * derivatives */
+                InitJacTimes(&pihm->jtimes);
+
+                cv_flag = CVodeSetJacTimes(cvode_mem, JacTimesSetup,
+                    JacTimesVec);
+                CheckCVodeFlag(cv_flag);
+            }
+        }
+
+        /* Newton iteration is the CVODE default. The fixed-point solver
+         * avoids Jacobian and linear solver work in non-stiff periods */
+        InitNonlinSolver(CV_Y, cvode_mem, &pihm->ctrl, &pihm->nls);
 
-        /* Attach the linear solver */
-        CVodeSetLinearSolver(cvode_mem, *sun_ls, NULL);
+        /* Specifies the maximum number of steps between Jacobian or
+         * preconditioner setups */
+        cv_flag = CVodeSetMaxStepsBetweenJac(cvode_mem, pihm->ctrl.msbj);
+        CheckCVodeFlag(cv_flag);
+
+        /* Root functions at flux regime thresholds */
+        InitEvent(cvode_mem, &pihm->ctrl, &pihm->event);
 
         /* When BGC, Cycles, or RT module is turned on, both water storage and
          * transport variables are in the CVODE vector. A vector of absolute
@@ -383,27 +499,28 @@ void SetCVodeParam(pihm_struct pihm, void *cvode_mem, SUNLinearSolver *sun_ls,
 
         N_VDestroy(abstol);
 
-        /* Specifies PIHM data block and attaches it to the main cvode memory
-         * block */
-        cv_flag = CVodeSetUserData(cvode_mem, pihm);
-        CheckCVodeFlag(cv_flag);
-
         /* Specifies the initial step size */
         cv_flag = CVodeSetInitStep(cvode_mem, (realtype)pihm->ctrl.initstep);
         CheckCVodeFlag(cv_flag);
 
         /* Indicates if the BDF stability limit detection algorithm should be
          * used */
-        cv_flag = CVodeSetStabLimDet(cvode_mem, SUNTRUE);
-        CheckCVodeFlag(cv_flag);
+        if (pihm->ctrl.nls != ADAMS_FIXEDPT)
+        {
+            cv_flag = CVodeSetStabLimDet(cvode_mem, SUNTRUE);
+            CheckCVodeFlag(cv_flag);
+        }
 
         /* Specifies an upper bound on the magnitude of the step size */
         cv_flag = CVodeSetMaxStep(cvode_mem, (realtype)pihm->ctrl.maxstep);
         CheckCVodeFlag(cv_flag);
 
         /* Specifies the maximum number of steps to be taken by the solver in
-         * its attempt to reach the next output time */
-        cv_flag = CVodeSetMaxNumSteps(cvode_mem, pihm->ctrl.stepsize * 10);
+         * its attempt to reach the next output time. The event scheduler and
+         * dense output mode advance up to a land surface step at a time */
+        cv_flag = CVodeSetMaxNumSteps(cvode_mem, 10 *
+            ((pihm->ctrl.schedule || pihm->ctrl.dense) ?
+            MAX(pihm->ctrl.etstep, pihm->ctrl.stepsize) : pihm->ctrl.stepsize));
         CheckCVodeFlag(cv_flag);
     }
 }
@@ -444,8 +561,53 @@ void SetAbsTolArray(double hydrol_tol, N_Vector abstol)
 #endif
 }
 
-void SolveCVode(double cputime, const ctrl_struct *ctrl, int *t,
-    void *cvode_mem, N_Vector CV_Y)
+SUNLinearSolver NewKrylov(N_Vector CV_Y, const ctrl_struct *ctrl)
+{
+    /*
+     * Create the Krylov linear solver selected in the .para file. SPFGMR only
+     * supports right preconditioning, and PCG assumes a symmetric system
+     */
+    SUNLinearSolver sun_ls;
+    const char     *name;
+
+    switch (ctrl->krylov)
+    {
+        case KRYLOV_SPFGMR:
+            sun_ls = SUNLinSol_SPFGMR(CV_Y, ctrl->precond, ctrl->maxl);
+            SUNLinSol_SPFGMRSetGSType(sun_ls, ctrl->gstype);
+            name = "SPFGMR";
+            break;
+        case KRYLOV_SPBCGS:
+            sun_ls = SUNLinSol_SPBCGS(CV_Y, ctrl->precond, ctrl->maxl);
+            name = "SPBCGS";
+            break;
+        case KRYLOV_SPTFQMR:
+            sun_ls = SUNLinSol_SPTFQMR(CV_Y, ctrl->precond, ctrl->maxl);
+            name = "SPTFQMR";
+            break;
+        case KRYLOV_PCG:
+            sun_ls = SUNLinSol_PCG(CV_Y, ctrl->precond, ctrl->maxl);
+            name = "PCG";
+            break;
+        default:
+            sun_ls = SUNLinSol_SPGMR(CV_Y, ctrl->precond, ctrl->maxl);
+            SUNLinSol_SPGMRSetGSType(sun_ls, ctrl->gstype);
+            name = "SPGMR";
+    }
+
+    if (sun_ls == NULL)
+    {
+        pihm_printf(VL_ERROR, "Error creating %s linear solver.\n", name);
+        pihm_exit(EXIT_FAILURE);
+    }
+
+    pihm_printf(VL_VERBOSE, "Krylov linear solver: %s.\n", name);
+
+    return sun_ls;
+}
+
+void SolveCVode(double cputime, const ctrl_struct *ctrl, event_struct *event,
+    int *t, void *cvode_mem, N_Vector CV_Y)
 {
     realtype        solvert;
     realtype        tout;
@@ -456,23 +618,76 @@ void SolveCVode(double cputime, const ctrl_struct *ctrl, int *t,
     double          progress;
 
     starttime = ctrl->starttime;
-    nextptr = ctrl->tout[ctrl->cstep + 1];
+    nextptr = ctrl->tout[ctrl->nextstep];
 
     tout = (realtype)(nextptr - starttime);
 
-    /* Specifies the value of the independent variable t past which the solution
-     * is not to proceed */
-    cv_flag = CVodeSetStopTime(cvode_mem, tout);
-    CheckCVodeFlag(cv_flag);
+    /* Root functions whose hold-off has expired are re-armed at model steps,
+     * unless CVODE has already stepped past the model step in dense output
+     * mode */
+    if (event->nroot > 0)
+    {
+        realtype        tn;
+
+        cv_flag = CVodeGetCurrentTime(cvode_mem, &tn);
+        CheckCVodeFlag(cv_flag);
+
+        if (tn <= (realtype)(ctrl->tout[ctrl->cstep] - starttime))
+        {
+            RearmEvents(tn, CV_Y, cvode_mem, event);
+        }
+    }
+
+    if (ctrl->dense)
+    {
+        realtype        tn;
+
+        /* Only stop at the next forcing breakpoint. Solutions at model steps
+         * that CVODE has already stepped over are interpolated */
+        cv_flag = CVodeSetStopTime(cvode_mem,
+            (realtype)(ctrl->tstop - starttime));
+        CheckCVodeFlag(cv_flag);
+
+        cv_flag = CVodeGetCurrentTime(cvode_mem, &tn);
+        CheckCVodeFlag(cv_flag);
+
+        if (tn >= tout)
+        {
+            cv_flag = CVodeGetDky(cvode_mem, tout, 0, CV_Y);
+            CheckCVodeFlag(cv_flag);
+
+            solvert = tout;
+        }
+        else
+        {
+            cv_flag = CVode(cvode_mem, tout, CV_Y, &solvert, CV_NORMAL);
+        }
+    }
+    else
+    {
+        /* Specifies the value of the independent variable t past which the
+         * solution is not to proceed */
+        cv_flag = CVodeSetStopTime(cvode_mem, tout);
+        CheckCVodeFlag(cv_flag);
+
+        cv_flag = CVode(cvode_mem, tout, CV_Y, &solvert, CV_NORMAL);
+    }
+
+    /* Restart at each threshold crossing located before the output time */
+    while (cv_flag == CV_ROOT_RETURN)
+    {
+        RestartAtEvent(solvert, ctrl->event_hold, CV_Y, cvode_mem, event);
 
-    cv_flag = CVode(cvode_mem, tout, CV_Y, &solvert, CV_NORMAL);
+        cv_flag = (solvert < tout) ?
+            CVode(cvode_mem, tout, CV_Y, &solvert, CV_NORMAL) : CV_SUCCESS;
+    }
     CheckCVodeFlag(cv_flag);
 
     *t = roundi(solvert) + starttime;
 
     pihm_time = PIHMTime(*t);
 
-    progress = ((double)ctrl->cstep + 1.0) / (double)ctrl->nstep;
+    progress = (double)ctrl->nextstep / (double)ctrl->nstep;
 
     if (ctrl->cstep == 0)
     {
@@ -501,12 +716,10 @@ void SolveCVode(double cputime, const ctrl_struct *ctrl, int *t,
     }
 }
 
-void AdjCVodeMaxStep(void *cvode_mem, ctrl_struct *ctrl)
+void AdjCVodeMaxStep(void *cvode_mem, const cvstats_struct *stats,
+    nls_struct *nls, ctrl_struct *ctrl)
 {
     /* Variable CVODE max step (to reduce oscillations) */
-    long int        nst;
-    long int        ncfn;
-    long int        nni;
     static long int nst0;
     static long int ncfn0;
     static long int nni0;
@@ -515,37 +728,241 @@ void AdjCVodeMaxStep(void *cvode_mem, ctrl_struct *ctrl)
     double          nfails;
     double          niters;
 
-    /* Gets the cumulative number of internal steps taken by the solver (total
-     * so far) */
-    cv_flag = CVodeGetNumSteps(cvode_mem, &nst);
+    nsteps = (double)(stats->nst - nst0);
+
+    if (nsteps == 0.0)
+    {
+        /* Model step interpolated in dense output mode. Statistics accumulate
+         * until CVODE takes new steps */
+        return;
+    }
+
+    nfails = (double)(stats->ncfn - ncfn0) / nsteps;
+    niters = (double)(stats->nni - nni0) / nsteps;
+
+    nls->nsteps[nls->active] += stats->nst - nst0;
+
+    if (ctrl->nls == AUTO_NLS)
+    {
+        SwitchNonlinSolver(cvode_mem, nfails, niters, ctrl, nls);
+    }
+
+    /* The adjustment factors are tuned for statistics over one model step.
+     * With the event scheduler, the max step stays at the model step size and
+     * CVODE error control alone limits internal steps */
+    if (!ctrl->schedule)
+    {
+        ctrl->maxstep /= (nfails > ctrl->nncfn || niters >= ctrl->nnimax) ?
+             ctrl->decr : 1.0;
+
+        ctrl->maxstep *= (nfails == 0.0 && niters <= ctrl->nnimin) ?
+            ctrl->incr : 1.0;
+
+        /* In dense output mode, internal steps are only bounded by the
+         * forcing breakpoints */
+        ctrl->maxstep = MIN(ctrl->maxstep,
+            (ctrl->dense) ? ctrl->etstep : ctrl->stepsize);
+        ctrl->maxstep = MAX(ctrl->maxstep, ctrl->stmin);
+
+        /* Updates the upper bound on the magnitude of the step size */
+        cv_flag = CVodeSetMaxStep(cvode_mem, (realtype)ctrl->maxstep);
+        CheckCVodeFlag(cv_flag);
+    }
+
+    nst0  = stats->nst;
+    ncfn0 = stats->ncfn;
+    nni0  = stats->nni;
+}
+
+void InitNonlinSolver(N_Vector CV_Y, void *cvode_mem, const ctrl_struct *ctrl,
+    nls_struct *nls)
+{
+    /*
+     * Create the nonlinear solvers of the selected mode. CVODE owns and uses
+     * its default Newton solver in BDF and Newton mode. In automatic mode,
+     * integration starts with Newton iterations
+     */
+    int             k;
+
+    nls->newton = NULL;
+    nls->fixedpt = NULL;
+    nls->fixedpt_init = 0;
+    nls->nsmooth = 0;
+    for (k = 0; k < 2; k++)
+    {
+        nls->nsteps[k] = 0;
+    }
+
+    if (ctrl->nls == BDF_NEWTON)
+    {
+        nls->active = NEWTON_NLS;
+        return;
+    }
+
+    nls->fixedpt = SUNNonlinSol_FixedPoint(CV_Y, ctrl->anderson);
+
+    if (ctrl->nls == AUTO_NLS)
+    {
+        nls->newton = SUNNonlinSol_Newton(CV_Y);
+    }
+
+    /* Solvers attached before the first call to CVode are initialized by
+     * CVODE */
+    AttachNonlinSolver(cvode_mem,
+        (ctrl->nls == AUTO_NLS) ? NEWTON_NLS : FIXEDPT_NLS, nls);
+    nls->fixedpt_init = (ctrl->nls == ADAMS_FIXEDPT);
+}
+
+void AttachNonlinSolver(void *cvode_mem, int type, nls_struct *nls)
+{
+    int             cv_flag;
+
+    cv_flag = CVodeSetNonlinearSolver(cvode_mem,
+        (type == FIXEDPT_NLS) ? nls->fixedpt : nls->newton);
+    CheckCVodeFlag(cv_flag);
+
+    nls->active = type;
+}
+
+void SwitchNonlinSolver(void *cvode_mem, double nfails, double niters,
+    const ctrl_struct *ctrl, nls_struct *nls)
+{
+    /*
+     * Switch to the fixed-point solver after NLS_SWITCH_STEPS consecutive
+     * model steps without convergence failures, with no more than the minimum
+     * number of nonlinear iterations per step, and at the full max step. The
+     * same stiffness signals that reduce the max step switch back to Newton
+     */
+    int             cv_flag;
+
+    if (nls->active == NEWTON_NLS)
+    {
+        nls->nsmooth = (nfails == 0.0 && niters <= ctrl->nnimin &&
+            ctrl->maxstep >= ctrl->stepsize) ? nls->nsmooth + 1 : 0;
+
+        if (nls->nsmooth >= NLS_SWITCH_STEPS)
+        {
+            AttachNonlinSolver(cvode_mem, FIXEDPT_NLS, nls);
+
+            if (!nls->fixedpt_init)
+            {
+                /* CVODE only initializes the nonlinear solver at the first
+                 * step */
+                cv_flag = SUNNonlinSolInitialize(nls->fixedpt);
+                CheckCVodeFlag(cv_flag);
+                nls->fixedpt_init = 1;
+            }
+
+            nls->nsmooth = 0;
+
+            pihm_printf(VL_VERBOSE, " Switched to fixed-point iteration.\n");
+        }
+    }
+    else if (nfails > ctrl->nncfn || niters >= ctrl->nnimax)
+    {
+        AttachNonlinSolver(cvode_mem, NEWTON_NLS, nls);
+
+        pihm_printf(VL_VERBOSE, " Switched to Newton iteration.\n");
+    }
+}
+
+long int NumNonlinIters(void *cvode_mem, const nls_struct *nls)
+{
+    /*
+     * Cumulative number of nonlinear iterations. With automatic switching,
+     * each solver counts its own iterations
+     */
+    long int        nni;
+    long int        nni_fp;
+    int             cv_flag;
+
+    if (nls->newton != NULL && nls->fixedpt != NULL)
+    {
+        cv_flag = SUNNonlinSolGetNumIters(nls->newton, &nni);
+        CheckCVodeFlag(cv_flag);
+
+        cv_flag = SUNNonlinSolGetNumIters(nls->fixedpt, &nni_fp);
+        CheckCVodeFlag(cv_flag);
+
+        nni += nni_fp;
+    }
+    else
+    {
+        cv_flag = CVodeGetNumNonlinSolvIters(cvode_mem, &nni);
+        CheckCVodeFlag(cv_flag);
+    }
+
+    return nni;
+}
+
+void GetCVodeStats(void *cvode_mem, const nls_struct *nls,
+    const event_struct *event, cvstats_struct *stats)
+{
+    /*
+     * Cumulative solver statistics. Without the nonlinear solver structure,
+     * only iterations of the attached nonlinear solver are counted. Without
+     * the event structure, statistics are counted from the latest restart
+     */
+    int             cv_flag;
+
+    /* Cumulative number of internal steps taken by the solver */
+    cv_flag = CVodeGetNumSteps(cvode_mem, &stats->nst);
     CheckCVodeFlag(cv_flag);
 
-    /* Gets the number of nonlinear convergence failures that have occurred */
-    cv_flag = CVodeGetNumNonlinSolvConvFails(cvode_mem, &ncfn);
+    /* Number of calls to the user's right-hand side function */
+    cv_flag = CVodeGetNumRhsEvals(cvode_mem, &stats->nfe);
+    CheckCVodeFlag(cv_flag);
+
+    /* Number of nonlinear iterations performed */
+    if (nls != NULL)
+    {
+        stats->nni = NumNonlinIters(cvode_mem, nls);
+    }
+    else
+    {
+        cv_flag = CVodeGetNumNonlinSolvIters(cvode_mem, &stats->nni);
+        CheckCVodeFlag(cv_flag);
+    }
+
+    /* Number of nonlinear convergence failures and local error test
+     * failures */
+    cv_flag = CVodeGetNumNonlinSolvConvFails(cvode_mem, &stats->ncfn);
     CheckCVodeFlag(cv_flag);
 
-    /* Gets the number of nonlinear iterations performed */
-    cv_flag = CVodeGetNumNonlinSolvIters(cvode_mem, &nni);
+    cv_flag = CVodeGetNumErrTestFails(cvode_mem, &stats->netf);
     CheckCVodeFlag(cv_flag);
 
-    nsteps = (double)(nst - nst0);
-    nfails = (double)(ncfn - ncfn0) / nsteps;
-    niters = (double)(nni - nni0) / nsteps;
+    /* Number of Krylov iterations and preconditioner calls */
+    cv_flag = CVodeGetNumLinIters(cvode_mem, &stats->nli);
+    CheckCVodeFlag(cv_flag);
 
-    ctrl->maxstep /= (nfails > ctrl->nncfn || niters >= ctrl->nnimax) ?
-         ctrl->decr : 1.0;
+    cv_flag = CVodeGetNumPrecEvals(cvode_mem, &stats->npe);
+    CheckCVodeFlag(cv_flag);
 
-    ctrl->maxstep *= (nfails == 0.0 && niters <= ctrl->nnimin) ?
-        ctrl->incr : 1.0;
+    cv_flag = CVodeGetNumPrecSolves(cvode_mem, &stats->nps);
+    CheckCVodeFlag(cv_flag);
 
-    ctrl->maxstep = MIN(ctrl->maxstep, ctrl->stepsize);
-    ctrl->maxstep = MAX(ctrl->maxstep, ctrl->stmin);
+    /* Number of linear convergence failures and Jacobian evaluations */
+    cv_flag = CVodeGetNumLinConvFails(cvode_mem, &stats->nlcf);
+    CheckCVodeFlag(cv_flag);
 
-    /* Updates the upper bound on the magnitude of the step size */
-    cv_flag = CVodeSetMaxStep(cvode_mem, (realtype)ctrl->maxstep);
+    cv_flag = CVodeGetNumJacEvals(cvode_mem, &stats->nje);
     CheckCVodeFlag(cv_flag);
 
-    nst0  = nst;
-    ncfn0 = ncfn;
-    nni0  = nni;
+    stats->nevents = 0;
+
+    if (event != NULL)
+    {
+        stats->nst += event->stats0.nst;
+        stats->nfe += event->stats0.nfe;
+        stats->nni += event->stats0.nni;
+        stats->ncfn += event->stats0.ncfn;
+        stats->netf += event->stats0.netf;
+        stats->nli += event->stats0.nli;
+        stats->npe += event->stats0.npe;
+        stats->nps += event->stats0.nps;
+        stats->nlcf += event->stats0.nlcf;
+        stats->nje += event->stats0.nje;
+        stats->nevents = event->stats0.nevents;
+    }
 }
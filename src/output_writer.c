@@ -0,0 +1,402 @@
+#include "pihm.h"
+
+/*
+ * Model variable output is copied into blocks of OUTBLOCK_SIZE bytes, one
+ * block being filled per output file, or per variable with the output
+ * container. Full blocks, and partly filled blocks at the times set by the
+ * OUTPUT_FLUSH parameter, are queued to a writer thread, which writes each
+ * block to its file with one system call. Blocks come from a pool of two
+ * blocks per output file. When the writer falls behind, new blocks are
+ * allocated, so the model never waits for the disk
+ */
+
+void InitOutputWriter(int ascii, print_struct *print)
+{
+    outwriter_struct *writer = &print->writer;
+    int             i;
+
+    writer->free = NULL;
+    writer->head = NULL;
+    writer->tail = NULL;
+    writer->nblock = 0;
+    writer->size = OUTBLOCK_SIZE;
+
+    if (print->outfile != NULL)
+    {
+        fflush(print->outfile);
+    }
+
+    for (i = 0; i < print->nprint; i++)
+    {
+        /* Headers are written through stdio, and records through the
+         * descriptors of the files */
+        if (print->outfile == NULL)
+        {
+            fflush(print->varctrl[i].datfile);
+        }
+        else
+        {
+            /* A chunk of the output container holds at least one record */
+            writer->size = MAX(writer->size, sizeof(outchunk_struct) +
+                (print->varctrl[i].nvar + 1) * sizeof(double));
+        }
+        print->varctrl[i].datblock = NULL;
+        print->varctrl[i].txtblock = NULL;
+
+        if (ascii)
+        {
+            fflush(print->varctrl[i].txtfile);
+        }
+    }
+
+    for (i = 0; i < 2 * print->nprint * (ascii ? 2 : 1); i++)
+    {
+        ReleaseBlock(NewBlock(writer), writer);
+    }
+
+#if defined(_OPENMP)
+    writer->quit = 0;
+    pthread_mutex_init(&writer->mutex, NULL);
+    pthread_cond_init(&writer->cond, NULL);
+
+    if (pthread_create(&writer->thread, NULL, OutputWriter, writer) != 0)
+    {
+        pihm_printf(VL_ERROR, "Error creating the output writer thread.\n");
+        pihm_exit(EXIT_FAILURE);
+    }
+#endif
+}
+
+void FreeOutputWriter(int ascii, print_struct *print)
+{
+    /* Write all output, and stop the writer thread */
+    outwriter_struct *writer = &print->writer;
+    int             i;
+
+    for (i = 0; i < print->nprint; i++)
+    {
+        FlushBlock(&print->varctrl[i].datblock, writer);
+
+        if (ascii)
+        {
+            FlushBlock(&print->varctrl[i].txtblock, writer);
+        }
+    }
+
+#if defined(_OPENMP)
+    pthread_mutex_lock(&writer->mutex);
+    writer->quit = 1;
+    pthread_cond_broadcast(&writer->cond);
+    pthread_mutex_unlock(&writer->mutex);
+
+    pthread_join(writer->thread, NULL);
+    pthread_mutex_destroy(&writer->mutex);
+    pthread_cond_destroy(&writer->cond);
+#endif
+
+    pihm_printf(VL_VERBOSE, " Output was written through %d blocks of %lu "
+        "bytes\n", writer->nblock, (unsigned long)writer->size);
+
+    while (writer->free != NULL)
+    {
+        outblock_struct *block = writer->free;
+
+        writer->free = block->next;
+        free(block->data);
+        free(block);
+    }
+}
+
+void InitOutputContainer(const char outputdir[], print_struct *print)
+{
+    /* Open the output container, and write its header and index. In append
+     * mode, records are appended to a container with the same index */
+    char            fn[MAXSTRING];
+    outhdr_struct   hdr;
+    outidx_struct  *idx;
+    struct stat     st;
+    size_t          prefix;
+    int             i;
+
+    sprintf(fn, "%s%s.pihmout", outputdir, project);
+
+    memset(&hdr, 0, sizeof(outhdr_struct));
+    memcpy(hdr.magic, OUTFILE_MAGIC, sizeof(OUTFILE_MAGIC));
+    hdr.version = OUTFILE_VERSION;
+    hdr.nprint = print->nprint;
+    hdr.nelem = nelem;
+    hdr.nriver = nriver;
+
+    /* Variables are named by the extensions of their .dat files */
+    idx = (outidx_struct *)calloc(print->nprint, sizeof(outidx_struct));
+    prefix = strlen(outputdir) + strlen(project) + 1;
+    for (i = 0; i < print->nprint; i++)
+    {
+        if (strlen(print->varctrl[i].name + prefix) >= MAXOUTNAME)
+        {
+            pihm_printf(VL_ERROR, "Error: Output variable name %s is too long "
+                "for the output container.\n", print->varctrl[i].name + prefix);
+            pihm_exit(EXIT_FAILURE);
+        }
+        strcpy(idx[i].name, print->varctrl[i].name + prefix);
+        idx[i].intvl = print->varctrl[i].intvl;
+        idx[i].nvar = print->varctrl[i].nvar;
+    }
+
+    if (append_mode && stat(fn, &st) == 0 && st.st_size > 0)
+    {
+        FILE           *fp;
+        outhdr_struct   old_hdr;
+        outidx_struct   old_idx;
+        int             match;
+
+        fp = pihm_fopen(fn, "rb");
+        match = (fread(&old_hdr, sizeof(outhdr_struct), 1, fp) == 1 &&
+            memcmp(&old_hdr, &hdr, sizeof(outhdr_struct)) == 0) ? 1 : 0;
+        for (i = 0; match && i < print->nprint; i++)
+        {
+            match = (fread(&old_idx, sizeof(outidx_struct), 1, fp) == 1 &&
+                memcmp(&old_idx, &idx[i], sizeof(outidx_struct)) == 0) ? 1 : 0;
+        }
+        fclose(fp);
+
+        if (!match)
+        {
+            pihm_printf(VL_ERROR, "Error: %s holds different output variables "
+                "and cannot be appended.\n", fn);
+            pihm_exit(EXIT_FAILURE);
+        }
+
+        print->outfile = pihm_fopen(fn, "ab");
+    }
+    else
+    {
+        print->outfile = pihm_fopen(fn, append_mode ? "ab" : "wb");
+        fwrite(&hdr, sizeof(outhdr_struct), 1, print->outfile);
+        fwrite(idx, sizeof(outidx_struct), print->nprint, print->outfile);
+    }
+
+    free(idx);
+}
+
+outblock_struct *NewBlock(outwriter_struct *writer)
+{
+    outblock_struct *block;
+
+    block = (outblock_struct *)malloc(sizeof(outblock_struct));
+    block->data = (char *)malloc(writer->size);
+    block->len = 0;
+    block->next = NULL;
+
+    writer->nblock++;
+
+    return block;
+}
+
+outblock_struct *GetBlock(int fd, outwriter_struct *writer)
+{
+    /* Take a block from the pool, or allocate one if all blocks are in use */
+    outblock_struct *block;
+
+#if defined(_OPENMP)
+    pthread_mutex_lock(&writer->mutex);
+#endif
+
+    if (writer->free != NULL)
+    {
+        block = writer->free;
+        writer->free = block->next;
+    }
+    else
+    {
+        block = NewBlock(writer);
+    }
+
+#if defined(_OPENMP)
+    pthread_mutex_unlock(&writer->mutex);
+#endif
+
+    block->fd = fd;
+    block->len = 0;
+    block->next = NULL;
+
+    return block;
+}
+
+void ReleaseBlock(outblock_struct *block, outwriter_struct *writer)
+{
+    /* Return a block to the pool. With the writer thread, must be called with
+     * the lock held */
+    block->next = writer->free;
+    writer->free = block;
+}
+
+void AppendOutput(const void *buf, size_t len, int fd, outblock_struct **block,
+    outwriter_struct *writer)
+{
+    /* Copy len bytes of output of file fd into its block. Full blocks are
+     * queued, so records may continue in the next block of the file */
+    const char     *ptr = (const char *)buf;
+
+    while (len > 0)
+    {
+        size_t          n;
+
+        if (*block == NULL)
+        {
+            *block = GetBlock(fd, writer);
+        }
+
+        n = MIN(len, writer->size - (*block)->len);
+        memcpy((*block)->data + (*block)->len, ptr, n);
+        (*block)->len += n;
+        ptr += n;
+        len -= n;
+
+        if ((*block)->len == writer->size)
+        {
+            QueueBlock(*block, writer);
+            *block = NULL;
+        }
+    }
+}
+
+double *ChunkRecord(int ivar, int t, int nvar, int fd,
+    outblock_struct **block, outwriter_struct *writer)
+{
+    /* Reserve a record of variable ivar at time t in its chunk of the output
+     * container. Records are never split between chunks */
+    size_t          rec_bytes = (nvar + 1) * sizeof(double);
+    outchunk_struct *chunk;
+    double         *record;
+
+    if (*block != NULL && (*block)->len + rec_bytes > writer->size)
+    {
+        QueueBlock(*block, writer);
+        *block = NULL;
+    }
+
+    if (*block == NULL)
+    {
+        *block = GetBlock(fd, writer);
+
+        chunk = (outchunk_struct *)(*block)->data;
+        chunk->ivar = ivar;
+        chunk->nrec = 0;
+        chunk->first = t;
+        (*block)->len = sizeof(outchunk_struct);
+    }
+
+    chunk = (outchunk_struct *)(*block)->data;
+    chunk->nrec++;
+    chunk->last = t;
+
+    record = (double *)((*block)->data + (*block)->len);
+    (*block)->len += rec_bytes;
+
+    return record;
+}
+
+void FlushBlock(outblock_struct **block, outwriter_struct *writer)
+{
+    /* Queue the block being filled, if any */
+    if (*block != NULL)
+    {
+        QueueBlock(*block, writer);
+        *block = NULL;
+    }
+}
+
+void QueueBlock(outblock_struct *block, outwriter_struct *writer)
+{
+    /* Queue a block to the writer thread. Blocks of each file are written in
+     * order of queueing. Without OpenMP, the block is written right away */
+#if defined(_OPENMP)
+    pthread_mutex_lock(&writer->mutex);
+
+    block->next = NULL;
+    if (writer->tail != NULL)
+    {
+        writer->tail->next = block;
+    }
+    else
+    {
+        writer->head = block;
+    }
+    writer->tail = block;
+
+    pthread_cond_broadcast(&writer->cond);
+    pthread_mutex_unlock(&writer->mutex);
+#else
+    WriteBlock(block);
+    ReleaseBlock(block, writer);
+#endif
+}
+
+void WriteBlock(const outblock_struct *block)
+{
+    size_t          written = 0;
+
+    while (written < block->len)
+    {
+        ssize_t         n;
+
+        n = write(block->fd, block->data + written, block->len - written);
+
+        if (n < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        else if (n <= 0)
+        {
+            pihm_printf(VL_ERROR, "Error writing model output: %s.\n",
+                strerror(errno));
+            pihm_exit(EXIT_FAILURE);
+        }
+
+        written += (size_t)n;
+    }
+}
+
+#if defined(_OPENMP)
+void *OutputWriter(void *arg)
+{
+    /* Main function of the writer thread, which writes queued blocks in order
+     * of queueing */
+    outwriter_struct *writer = (outwriter_struct *)arg;
+
+    pthread_mutex_lock(&writer->mutex);
+
+    while (1)
+    {
+        outblock_struct *block;
+
+        while (writer->head == NULL && !writer->quit)
+        {
+            pthread_cond_wait(&writer->cond, &writer->mutex);
+        }
+
+        if (writer->head == NULL)
+        {
+            break;
+        }
+
+        block = writer->head;
+        writer->head = block->next;
+        if (writer->head == NULL)
+        {
+            writer->tail = NULL;
+        }
+
+        pthread_mutex_unlock(&writer->mutex);
+        WriteBlock(block);
+        pthread_mutex_lock(&writer->mutex);
+
+        ReleaseBlock(block, writer);
+    }
+
+    pthread_mutex_unlock(&writer->mutex);
+
+    return NULL;
+}
+#endif
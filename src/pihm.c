@@ -2,19 +2,35 @@
 
 void PIHM(double cputime, pihm_struct pihm, void *cvode_mem, N_Vector CV_Y)
 {
+    /*
+     * Tasks of the step are issued through the task runner, so that boundary
+     * conditions and outputs run on the helper thread when they do not depend
+     * on the tasks in between (see task_graph.c)
+     */
     int             t;
-#if defined(_RT_)
-    const int       SPECIATION_STEP = 3600;
-#endif
+    int             dt;
+    int             nsteps;
+    taskgraph_struct *graph;
+
+    graph = &pihm->taskgraph;
 
     t = pihm->ctrl.tout[pihm->ctrl.cstep];
 
-    /* Apply boundary conditions */
-#if defined(_RT_)
-    ApplyBc(t, &pihm->rttbl, &pihm->forc, pihm->elem, pihm->river);
-#else
-    ApplyBc(t, &pihm->forc, pihm->elem, pihm->river);
-#endif
+    /* Length of the PIHM step, and number of model steps it covers */
+    dt = pihm->ctrl.tout[pihm->ctrl.nextstep] - t;
+    nsteps = pihm->ctrl.nextstep - pihm->ctrl.cstep;
+
+    /*
+     * In dense output mode, CVODE may integrate past model steps, so boundary
+     * conditions are only updated at the start of each integration segment.
+     * Segments are one model step long while boundary conditions change (see
+     * NextBreakpoint)
+     */
+    if (!pihm->ctrl.dense || t >= pihm->ctrl.tstop)
+    {
+        /* Apply boundary conditions */
+        IssueTask(BC_TASK, t, dt, graph);
+    }
 
     /*
      * Apply forcing and simulate land surface processes
@@ -22,6 +38,7 @@ void PIHM(double cputime, pihm_struct pihm, void *cvode_mem, N_Vector CV_Y)
     if ((t - pihm->ctrl.starttime) % pihm->ctrl.etstep == 0)
     {
         /* Apply forcing */
+        BeginTask(FORC_TASK, t, graph);
 #if defined(_RT_)
         ApplyForcing(t, pihm->ctrl.rad_mode, &pihm->siteinfo, &pihm->rttbl,
             &pihm->forc, pihm->elem);
@@ -31,17 +48,26 @@ void PIHM(double cputime, pihm_struct pihm, void *cvode_mem, N_Vector CV_Y)
 #else
         ApplyForcing(t, &pihm->forc, pihm->elem);
 #endif
+        EndTask(FORC_TASK, graph);
 
+        BeginTask(LSM_TASK, t, graph);
 #if defined(_NOAH_)
-        /* Calculate surface energy balance */
-        Noah((double)pihm->ctrl.etstep, &pihm->lctbl, &pihm->calib, pihm->elem);
+        /* Calculate surface energy balance. Melted glaciers are turned to
+         * barren land, which changes the coefficients of overland flow */
+        if (Noah((double)pihm->ctrl.etstep, &pihm->lctbl, &pihm->calib,
+            &pihm->sched[LSM_SCHED], pihm->elem) > 0)
+        {
+            UpdateHydroLc(pihm->elem, &pihm->hydro);
+        }
+        UpdateSched(t, LSM_SCHED, pihm->sched, pihm->print.schedperf_file);
 #else
         /* Calculate Interception storage and ET */
-        IntcpSnowEt(t, (double)pihm->ctrl.etstep, &pihm->calib, pihm->elem);
+        IntcpSnowEt(t, (double)pihm->ctrl.etstep, pihm->elem);
 #endif
 
         /* Update print variables for land surface step variables */
-        UpdatePrintVar(pihm->print.nprint, LS_STEP, pihm->print.varctrl);
+        UpdatePrintVar(pihm->print.nprint, LS_STEP, 1, pihm->print.varctrl);
+        EndTask(LSM_TASK, graph);
     }
 
 #if defined(_RT_)
@@ -53,8 +79,13 @@ void PIHM(double cputime, pihm_struct pihm, void *cvode_mem, N_Vector CV_Y)
         if (t - pihm->ctrl.starttime >= pihm->ctrl.RT_delay &&
             (t - pihm->ctrl.starttime) % pihm->ctrl.AvgScl == 0)
         {
+            BeginTask(REACT_TASK, t, graph);
             Reaction((double)pihm->ctrl.AvgScl, pihm->chemtbl, pihm->kintbl,
-                &pihm->rttbl, pihm->elem);
+                &pihm->rttbl, pihm->scratch, &pihm->sched[REACT_SCHED],
+                pihm->elem);
+            UpdateSched(t, REACT_SCHED, pihm->sched,
+                pihm->print.schedperf_file);
+            EndTask(REACT_TASK, graph);
         }
     }
 #endif
@@ -62,27 +93,34 @@ void PIHM(double cputime, pihm_struct pihm, void *cvode_mem, N_Vector CV_Y)
 #if defined(_CYCLES_)
     if ((t - pihm->ctrl.starttime) % DAYINSEC == 0)
     {
-        Cycles(t, pihm->elem);
+        BeginTask(CYCLES_TASK, t, graph);
+        Cycles(t, &pihm->sched[CYCLES_SCHED], pihm->elem);
+        UpdateSched(t, CYCLES_SCHED, pihm->sched, pihm->print.schedperf_file);
 
         /* Update print variables for CN (daily) step variables */
-        UpdatePrintVar(pihm->print.nprint, CN_STEP, pihm->print.varctrl);
+        UpdatePrintVar(pihm->print.nprint, CN_STEP, 1, pihm->print.varctrl);
+        EndTask(CYCLES_TASK, graph);
     }
 #endif
 
     /*
      * Solve PIHM hydrology ODE using CVode
      */
-    SolveCVode(cputime, &pihm->ctrl, &t, cvode_mem, CV_Y);
+    BeginTask(ODE_TASK, t, graph);
+    SolveCVode(cputime, &pihm->ctrl, &pihm->event, &t, cvode_mem, CV_Y);
 
     /* Use mass balance to calculate model fluxes or variables */
-    UpdateVar((double)pihm->ctrl.stepsize, pihm->elem, pihm->river, CV_Y);
+    UpdateVar((double)dt, pihm->elem, pihm->river, CV_Y);
+    EndTask(ODE_TASK, graph);
 
+    BeginTask(HYDROL_TASK, t, graph);
 #if defined(_NOAH_)
-    NoahHydrol((double)pihm->ctrl.stepsize, pihm->elem);
+    NoahHydrol((double)dt, pihm->elem);
 #endif
 
     /* Update print variables for hydrology step variables */
-    UpdatePrintVar(pihm->print.nprint, HYDROL_STEP, pihm->print.varctrl);
+    UpdatePrintVar(pihm->print.nprint, HYDROL_STEP, nsteps,
+        pihm->print.varctrl);
 
 #if defined(_RT_)
     /*
@@ -93,7 +131,8 @@ void PIHM(double cputime, pihm_struct pihm, void *cvode_mem, N_Vector CV_Y)
         if ((t - pihm->ctrl.starttime) % SPECIATION_STEP == 0)
         {
             /* Speciation */
-            Speciation(pihm->chemtbl, &pihm->rttbl, pihm->river);
+            Speciation(pihm->chemtbl, &pihm->rttbl, pihm->scratch,
+                pihm->river);
         }
     }
     else
@@ -101,10 +140,12 @@ void PIHM(double cputime, pihm_struct pihm, void *cvode_mem, N_Vector CV_Y)
         UpdatePConc(&pihm->rttbl, pihm->elem, pihm->river);
     }
 
-    UpdatePrintVar(pihm->print.nprint, RT_STEP, pihm->print.varctrl);
+    UpdatePrintVar(pihm->print.nprint, RT_STEP, nsteps, pihm->print.varctrl);
 #endif
+    EndTask(HYDROL_TASK, graph);
 
 #if defined(_DAILY_)
+    BeginTask(DAILY_TASK, t, graph);
     DailyVar(t, pihm->ctrl.starttime, pihm->elem);
 
     /*
@@ -115,14 +156,18 @@ void PIHM(double cputime, pihm_struct pihm, void *cvode_mem, N_Vector CV_Y)
 # if defined(_BGC_)
         /* Daily BGC processes */
         DailyBgc(t - DAYINSEC, pihm);
+#  if !defined(_LUMPEDBGC_)
+        UpdateSched(t, BGC_SCHED, pihm->sched, pihm->print.schedperf_file);
+#  endif
 
         /* Update print variables for CN (daily) step variables */
-        UpdatePrintVar(pihm->print.nprint, CN_STEP, pihm->print.varctrl);
+        UpdatePrintVar(pihm->print.nprint, CN_STEP, 1, pihm->print.varctrl);
 # endif
 
         /* Initialize daily structures */
         InitDailyStruct(pihm->elem);
     }
+    EndTask(DAILY_TASK, graph);
 #endif
 
     /*
@@ -131,11 +176,9 @@ void PIHM(double cputime, pihm_struct pihm, void *cvode_mem, N_Vector CV_Y)
     /* Print water balance */
     if (pihm->ctrl.waterbal)
     {
-        PrintWaterBalance(t, pihm->ctrl.starttime, pihm->ctrl.stepsize,
-            pihm->elem, pihm->river, pihm->print.watbal_file);
+        IssueTask(WATBAL_TASK, t, dt, graph);
     }
 
     /* Print binary and txt output files */
-    PrintData(pihm->print.nprint, t, t - pihm->ctrl.starttime, pihm->ctrl.ascii,
-        pihm->print.varctrl);
+    IssueTask(OUTPUT_TASK, t, dt, graph);
 }
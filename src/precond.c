@@ -0,0 +1,356 @@
+#include "pihm.h"
+
+void InitPrecond(prec_struct *prec)
+{
+    int             i;
+
+    prec->jac_elem = (realtype ***)malloc(nelem * sizeof(realtype **));
+    prec->p_elem = (realtype ***)malloc(nelem * sizeof(realtype **));
+    prec->pivot = (sunindextype **)malloc(nelem * sizeof(sunindextype *));
+
+    for (i = 0; i < nelem; i++)
+    {
+        prec->jac_elem[i] = newDenseMat(NUM_ELEM_HYDROL, NUM_ELEM_HYDROL);
+        prec->p_elem[i] = newDenseMat(NUM_ELEM_HYDROL, NUM_ELEM_HYDROL);
+        prec->pivot[i] = newIndexArray(NUM_ELEM_HYDROL);
+    }
+
+    prec->jac_river = (double *)malloc(nriver * sizeof(double));
+    prec->p_river = (double *)malloc(nriver * sizeof(double));
+}
+
+void FreePrecond(prec_struct *prec)
+{
+    int             i;
+
+    for (i = 0; i < nelem; i++)
+    {
+        destroyMat(prec->jac_elem[i]);
+        destroyMat(prec->p_elem[i]);
+        destroyArray(prec->pivot[i]);
+    }
+
+    free(prec->jac_elem);
+    free(prec->p_elem);
+    free(prec->pivot);
+    free(prec->jac_river);
+    free(prec->p_river);
+}
+
+int PrecSetup(realtype t, N_Vector CV_Y, N_Vector fy, booleantype jok,
+    booleantype *jcur, realtype gamma, void *pihm_data)
+{
+    /*
+     * Block-Jacobi preconditioner P = I - gamma * J, where J only keeps the
+     * vertical coupling among the storages of each element and the storage
+     * dependence of each river segment. The blocks are approximated by finite
+     * differences of the local flux laws, which are much cheaper than Ode
+     * evaluations
+     */
+    int             i;
+    int             singular = 0;
+    double         *y;
+    pihm_struct     pihm;
+    elem_struct    *elem;
+    river_struct   *river;
+    prec_struct    *prec;
+
+    y = NV_DATA(CV_Y);
+    pihm = (pihm_struct)pihm_data;
+
+    elem = &pihm->elem[0];
+    river = &pihm->river[0];
+    prec = &pihm->prec;
+
+    if (!jok)
+    {
+        const double    SRUR = sqrt(UNIT_ROUNDOFF);
+
+#if defined(_OPENMP)
+# pragma omp parallel for
+#endif
+        for (i = 0; i < nelem; i++)
+        {
+            double          jac[NUM_ELEM_HYDROL][NUM_ELEM_HYDROL];
+            int             j, k;
+
+            ElemVertJac((double)pihm->ctrl.stepsize, pihm->ctrl.abstol,
+                &elem[i], jac);
+
+            for (j = 0; j < NUM_ELEM_HYDROL; j++)
+            {
+                for (k = 0; k < NUM_ELEM_HYDROL; k++)
+                {
+                    prec->jac_elem[i][j][k] = jac[j][k];
+                }
+            }
+        }
+
+#if defined(_OPENMP)
+# pragma omp parallel for
+#endif
+        for (i = 0; i < nriver; i++)
+        {
+            double          stage;
+            double          inc;
+            double          f0, f1;
+
+            stage = MAX(y[RIVER(i)], 0.0);
+            inc = SRUR * MAX(stage, pihm->ctrl.abstol);
+
+            f0 = RiverStrgRhs(stage, &river[i], elem, river);
+            f1 = RiverStrgRhs(stage + inc, &river[i], elem, river);
+
+            prec->jac_river[i] = (f1 - f0) / inc;
+        }
+
+        *jcur = SUNTRUE;
+    }
+    else
+    {
+        *jcur = SUNFALSE;
+    }
+
+    /* Form and factor P = I - gamma * J */
+#if defined(_OPENMP)
+# pragma omp parallel for reduction(+:singular)
+#endif
+    for (i = 0; i < nelem; i++)
+    {
+        denseCopy(prec->jac_elem[i], prec->p_elem[i], NUM_ELEM_HYDROL,
+            NUM_ELEM_HYDROL);
+        denseScale(-gamma, prec->p_elem[i], NUM_ELEM_HYDROL, NUM_ELEM_HYDROL);
+        denseAddIdentity(prec->p_elem[i], NUM_ELEM_HYDROL);
+
+        singular += (denseGETRF(prec->p_elem[i], NUM_ELEM_HYDROL,
+            NUM_ELEM_HYDROL, prec->pivot[i]) != 0) ? 1 : 0;
+    }
+
+#if defined(_OPENMP)
+# pragma omp parallel for reduction(+:singular)
+#endif
+    for (i = 0; i < nriver; i++)
+    {
+        prec->p_river[i] = 1.0 - gamma * prec->jac_river[i];
+
+        singular += (prec->p_river[i] == 0.0) ? 1 : 0;
+    }
+
+    /* A positive return value asks CVODE to retry with a smaller step */
+    return (singular > 0) ? 1 : 0;
+}
+
+int PrecSolve(realtype t, N_Vector CV_Y, N_Vector fy, N_Vector r, N_Vector z,
+    realtype gamma, realtype delta, int lr, void *pihm_data)
+{
+    int             i;
+    double         *rv;
+    double         *zv;
+    pihm_struct     pihm;
+    prec_struct    *prec;
+
+    rv = NV_DATA(r);
+    zv = NV_DATA(z);
+    pihm = (pihm_struct)pihm_data;
+    prec = &pihm->prec;
+
+    /* Rows that are not preconditioned (e.g., solutes) are passed through */
+    N_VScale(1.0, r, z);
+
+#if defined(_OPENMP)
+# pragma omp parallel for
+#endif
+    for (i = 0; i < nelem; i++)
+    {
+        double          b[NUM_ELEM_HYDROL];
+
+        b[0] = rv[SURF(i)];
+        b[1] = rv[UNSAT(i)];
+        b[2] = rv[GW(i)];
+#if defined(_DGW_)
+        b[3] = rv[UNSAT_GEOL(i)];
+        b[4] = rv[GW_GEOL(i)];
+#endif
+
+        denseGETRS(prec->p_elem[i], NUM_ELEM_HYDROL, prec->pivot[i], b);
+
+        zv[SURF(i)] = b[0];
+        zv[UNSAT(i)] = b[1];
+        zv[GW(i)] = b[2];
+#if defined(_DGW_)
+        zv[UNSAT_GEOL(i)] = b[3];
+        zv[GW_GEOL(i)] = b[4];
+#endif
+    }
+
+#if defined(_OPENMP)
+# pragma omp parallel for
+#endif
+    for (i = 0; i < nriver; i++)
+    {
+        zv[RIVER(i)] = rv[RIVER(i)] / prec->p_river[i];
+    }
+
+    return 0;
+}
+
+void ElemVertJac(double dt, double abstol, const elem_struct *elem,
+    double jac[][NUM_ELEM_HYDROL])
+{
+    /*
+     * Finite difference approximation of the vertical Jacobian block of an
+     * element at its current water states. jac[j][k] is the derivative of the
+     * k-th RHS with respect to the j-th state
+     */
+    const double    SRUR = sqrt(UNIT_ROUNDOFF);
+    double          ys[NUM_ELEM_HYDROL];
+    double          f0[NUM_ELEM_HYDROL];
+    double          f1[NUM_ELEM_HYDROL];
+    double          inc;
+    double          ysave;
+    int             j, k;
+
+    ys[0] = elem->ws.surf;
+    ys[1] = elem->ws.unsat;
+    ys[2] = elem->ws.gw;
+#if defined(_DGW_)
+    ys[3] = elem->ws.unsat_geol;
+    ys[4] = elem->ws.gw_geol;
+#endif
+
+    ElemVertRhs(dt, elem, ys, f0);
+
+    for (j = 0; j < NUM_ELEM_HYDROL; j++)
+    {
+        inc = SRUR * MAX(ys[j], abstol);
+
+        ysave = ys[j];
+        ys[j] += inc;
+
+        ElemVertRhs(dt, elem, ys, f1);
+
+        ys[j] = ysave;
+
+        for (k = 0; k < NUM_ELEM_HYDROL; k++)
+        {
+            jac[j][k] = (f1[k] - f0[k]) / inc;
+        }
+    }
+}
+
+void ElemVertRhs(double dt, const elem_struct *elem, const double ys[],
+    double f[])
+{
+    /*
+     * Vertical part of the element RHS in Ode, evaluated on local copies of
+     * the water states and fluxes so that elem is left untouched
+     */
+    wstate_struct   ws;
+    wflux_struct    wf;
+
+    ws = elem->ws;
+    wf = elem->wf;
+
+    ws.surf = ys[0];
+    ws.unsat = ys[1];
+    ws.gw = ys[2];
+#if defined(_DGW_)
+    ws.unsat_geol = ys[3];
+    ws.gw_geol = ys[4];
+#endif
+    ws.surfh = SurfH(ws.surf);
+
+    wf.infil = Infil(dt, &elem->topo, &elem->soil, &ws, &elem->ws0, &wf);
+#if defined(_NOAH_)
+    wf.infil *= elem->ps.fcr;
+#endif
+    wf.recharge = Recharge(&elem->soil, &ws, &wf);
+
+    f[0] = -wf.infil;
+    f[1] = (wf.infil - wf.recharge) / elem->soil.porosity;
+    f[2] = wf.recharge / elem->soil.porosity;
+
+#if defined(_DGW_)
+    wf.infil_geol = GeolInfil(&elem->topo, &elem->soil, &elem->geol, &ws);
+    wf.rechg_geol = GeolRecharge(&elem->geol, &ws, &wf);
+
+    f[2] -= wf.infil_geol / elem->soil.porosity;
+    f[3] = (wf.infil_geol - wf.rechg_geol) / elem->geol.porosity;
+    f[4] = wf.rechg_geol / elem->geol.porosity;
+#endif
+}
+
+double RiverStrgRhs(double stage, const river_struct *river_ptr,
+    elem_struct elem[], const river_struct river[])
+{
+    /*
+     * Part of the river RHS in Ode that depends on the storage of the segment
+     * itself. Upstream inflow from other segments is not included. Bank
+     * element fluxes written by the flux functions are restored on return
+     */
+    river_struct    rcopy;
+    double          flux = 0.0;
+
+    rcopy = *river_ptr;
+    rcopy.ws.stage = stage;
+
+    if (rcopy.down > 0)
+    {
+        if (rcopy.attrib.riverbc_type != 0)
+        {
+            flux += BoundFluxRiver(rcopy.attrib.riverbc_type, &rcopy.topo,
+                &rcopy.shp, &rcopy.matl, &rcopy.bc, &rcopy.ws);
+        }
+
+        flux += ChannelFlowRiverToRiver(&rcopy, &river[rcopy.down - 1]);
+    }
+    else
+    {
+        flux += OutletFlux(rcopy.down, &rcopy.topo, &rcopy.shp, &rcopy.matl,
+            &rcopy.bc, &rcopy.ws);
+    }
+
+    if (rcopy.left > 0)
+    {
+        flux += BankFlux(&rcopy, rcopy.topo.dist_left, &elem[rcopy.left - 1]);
+    }
+
+    if (rcopy.right > 0)
+    {
+        flux += BankFlux(&rcopy, rcopy.topo.dist_right,
+            &elem[rcopy.right - 1]);
+    }
+
+    return -flux / rcopy.topo.area;
+}
+
+double BankFlux(const river_struct *river_ptr, double distance,
+    elem_struct *bank)
+{
+    int             j;
+    double          overland = 0.0;
+    double          subsurf = 0.0;
+    double          flux;
+
+    for (j = 0; j < NUM_EDGE; j++)
+    {
+        if (bank->nabr_river[j] == river_ptr->ind)
+        {
+            overland = bank->wf.overland[j];
+            subsurf = bank->wf.subsurf[j];
+            break;
+        }
+    }
+
+    flux = OvlFlowElemToRiver(river_ptr, bank) +
+        ChannelFlowElemToRiver(EffKh(bank->ws.gw, &bank->soil), distance,
+        river_ptr, bank);
+
+    if (j < NUM_EDGE)
+    {
+        bank->wf.overland[j] = overland;
+        bank->wf.subsurf[j] = subsurf;
+    }
+
+    return flux;
+}
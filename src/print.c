@@ -63,11 +63,11 @@ void StartupScreen(void)
 }
 
 #if defined(_LUMPED_) && defined(_RT_)
-void InitOutputFiles(const char outputdir[], int watbal, int ascii,
+void InitOutputFiles(const char outputdir[], int watbal, int ascii, int format,
     const chemtbl_struct chemtbl[], const rttbl_struct *rttbl,
     print_struct *print)
 #else
-void InitOutputFiles(const char outputdir[], int watbal, int ascii,
+void InitOutputFiles(const char outputdir[], int watbal, int ascii, int format,
     print_struct *print)
 #endif
 {
@@ -104,18 +104,48 @@ void InitOutputFiles(const char outputdir[], int watbal, int ascii,
         print->cvodeperf_file = pihm_fopen(perf_fn, mode);
         /* Print header lines */
         fprintf(print->cvodeperf_file,
-            "%-8s%-8s%-16s%-8s%-8s%-8s%-8s%-8s%-8s\n",
+            "%-8s%-8s%-16s%-8s%-8s%-8s%-8s%-8s%-8s%-8s%-8s%-10s"
+            "%-9s%-8s%-8s%-9s%-8s\n",
             "step", "cpu_dt", "cputime", "maxstep",
-            "nsteps", "niters", "nevals", "nefails", "ncfails");
+            "nsteps", "niters", "nevals", "nefails", "ncfails",
+            "nliters", "npevals", "npsolves", "nlcfails", "njevals",
+            "ncolors", "jac_time", "nroots");
+
+        /* Thread imbalance of the element loops with cost-aware schedules */
+        sprintf(perf_fn, "%s%s.sched.log", outputdir, project);
+        print->schedperf_file = pihm_fopen(perf_fn, mode);
+        fprintf(print->schedperf_file, "%-12s%-8s%-8s%-10s%-16s%-10s%s\n",
+            "time", "loop", "ncalls", "nthreads", "busy_time", "imbal",
+            "static_imbal");
+    }
+    else
+    {
+        print->schedperf_file = NULL;
     }
 
     /*
      * Initialize model variable output files
      */
+    if (format == CONTAINER_FORMAT)
+    {
+        InitOutputContainer(outputdir, print);
+    }
+    else
+    {
+        print->outfile = NULL;
+    }
+
     for (i = 0; i < print->nprint; i++)
     {
-        sprintf(dat_fn, "%s.dat", print->varctrl[i].name);
-        print->varctrl[i].datfile = pihm_fopen(dat_fn, bin_mode);
+        if (format == CONTAINER_FORMAT)
+        {
+            print->varctrl[i].datfile = NULL;
+        }
+        else
+        {
+            sprintf(dat_fn, "%s.dat", print->varctrl[i].name);
+            print->varctrl[i].datfile = pihm_fopen(dat_fn, bin_mode);
+        }
 
         if (ascii)
         {
@@ -445,8 +475,14 @@ void InitOutputFiles(const char outputdir[], int watbal, int ascii,
 #endif
 }
 
-void UpdatePrintVar(int nprint, int module_step, varctrl_struct *varctrl)
+void UpdatePrintVar(int nprint, int module_step, int weight,
+    varctrl_struct *varctrl)
 {
+    /*
+     * Accumulate print variables. The weight is the number of model steps the
+     * values represent, which is more than one when the time loop skips model
+     * steps without events
+     */
     int             i;
 #if defined(_OPENMP)
 # pragma omp parallel for
@@ -459,16 +495,18 @@ void UpdatePrintVar(int nprint, int module_step, varctrl_struct *varctrl)
         {
             for (j = 0; j < varctrl[i].nvar; j++)
             {
-                varctrl[i].buffer[j] += *varctrl[i].var[j];
+                varctrl[i].buffer[j] += *varctrl[i].var[j] * (double)weight;
             }
 
-            varctrl[i].counter++;
+            varctrl[i].counter += weight;
         }
     }
 }
 
-void PrintData(int nprint, int t, int lapse, int ascii, varctrl_struct *varctrl)
+void PrintData(int t, int lapse, int ascii, int flush, print_struct *print)
 {
+    /* Copy the averaged variables due at time t into output blocks. Blocks are
+     * only written by the output writer */
     int             i;
     pihm_t_struct   pihm_time;
 
@@ -477,50 +515,111 @@ void PrintData(int nprint, int t, int lapse, int ascii, varctrl_struct *varctrl)
 #if defined(_OPENMP)
 # pragma omp parallel for
 #endif
-    for (i = 0; i < nprint; i++)
+    for (i = 0; i < print->nprint; i++)
     {
+        varctrl_struct *varctrl = &print->varctrl[i];
         int             j;
         double          outval;
         double          outtime;
+        double         *record = NULL;
 
-        if(PrintNow(varctrl[i].intvl, lapse, pihm_time))
+        if(PrintNow(varctrl->intvl, lapse, pihm_time))
         {
             if (ascii)
             {
-                fprintf(varctrl[i].txtfile, "\"%s\"", pihm_time.str);
-                for (j = 0; j < varctrl[i].nvar; j++)
+                int             txtfd = fileno(varctrl->txtfile);
+                char            str[MAXSTRING];
+
+                sprintf(str, "\"%s\"", pihm_time.str);
+                AppendOutput(str, strlen(str), txtfd, &varctrl->txtblock,
+                    &print->writer);
+                for (j = 0; j < varctrl->nvar; j++)
                 {
-                    outval = (varctrl[i].counter > 0) ?
-                        varctrl[i].buffer[j] / (double)varctrl[i].counter :
-                        varctrl[i].buffer[j];
+                    outval = (varctrl->counter > 0) ?
+                        varctrl->buffer[j] / (double)varctrl->counter :
+                        varctrl->buffer[j];
 
-                    fprintf(varctrl[i].txtfile,
+                    snprintf(str, MAXSTRING,
                         (roundi(outval) == BADVAL) ? "\t%-8.0lf" :
                         ((outval == 0.0 || fabs(outval) > 1.0E-3) ?
                         "\t%lf" : "\t%.2le"), outval);
+                    AppendOutput(str, strlen(str), txtfd, &varctrl->txtblock,
+                        &print->writer);
                 }
-                fprintf(varctrl[i].txtfile, "\n");
-                fflush(varctrl[i].txtfile);
+                AppendOutput("\n", 1, txtfd, &varctrl->txtblock,
+                    &print->writer);
             }
 
             outtime = (double)t;
-            fwrite(&outtime, sizeof(double), 1, varctrl[i].datfile);
-            for (j = 0; j < varctrl[i].nvar; j++)
+            if (print->outfile != NULL)
+            {
+                /* Records of the output container are kept whole in chunks */
+                record = ChunkRecord(i, t, varctrl->nvar,
+                    fileno(print->outfile), &varctrl->datblock,
+                    &print->writer);
+                record[0] = outtime;
+            }
+            else
             {
-                outval = (varctrl[i].counter > 0) ?
-                    varctrl[i].buffer[j] / (double)varctrl[i].counter :
-                    varctrl[i].buffer[j];
+                AppendOutput(&outtime, sizeof(double),
+                    fileno(varctrl->datfile), &varctrl->datblock,
+                    &print->writer);
+            }
+            for (j = 0; j < varctrl->nvar; j++)
+            {
+                outval = (varctrl->counter > 0) ?
+                    varctrl->buffer[j] / (double)varctrl->counter :
+                    varctrl->buffer[j];
 
-                fwrite(&outval, sizeof(double), 1, varctrl[i].datfile);
+                if (print->outfile != NULL)
+                {
+                    record[j + 1] = outval;
+                }
+                else
+                {
+                    AppendOutput(&outval, sizeof(double),
+                        fileno(varctrl->datfile), &varctrl->datblock,
+                        &print->writer);
+                }
+
+                varctrl->buffer[j] = 0.0;
+            }
+            varctrl->counter = 0;
+        }
 
-                varctrl[i].buffer[j] = 0.0;
+        if (flush)
+        {
+            FlushBlock(&varctrl->datblock, &print->writer);
+            if (ascii)
+            {
+                FlushBlock(&varctrl->txtblock, &print->writer);
             }
-            varctrl[i].counter = 0;
-            fflush(varctrl[i].datfile);
         }
     }
 }
 
+int FlushNow(int t, const ctrl_struct *ctrl)
+{
+    /* Whether partly filled output blocks are written at time t */
+    int             flush = 0;
+
+    switch (ctrl->output_flush)
+    {
+        case FLUSH_OUTPUT:
+            flush = 1;
+            break;
+        case FLUSH_CHECKPOINT:
+            flush = (ctrl->write_ic &&
+                PrintNow(ctrl->prtvrbl[IC_CTRL], t - ctrl->starttime,
+                PIHMTime(t))) ? 1 : 0;
+            break;
+        default:
+            flush = 0;
+    }
+
+    return flush;
+}
+
 void PrintInit(const char outputdir[], int t, int starttime, int endtime,
     int intvl, const elem_struct elem[], const river_struct river[])
 {
@@ -533,100 +632,98 @@ void PrintInit(const char outputdir[], int t, int starttime, int endtime,
         FILE           *init_file;
         char            fn[MAXSTRING];
         int             i;
+        ic_struct      *ic;
+        river_ic_struct *river_ic;
 
         sprintf(fn, "%s/restart/%s.%s.ic", outputdir, project,
             pihm_time.strshort);
 
-        init_file = pihm_fopen(fn, "wb");
+        /* Records are written in the order of element and river IDs (see
+         * ReadIc) */
+        ic = (ic_struct *)malloc(nelem * sizeof(ic_struct));
+        river_ic = (river_ic_struct *)malloc(nriver * sizeof(river_ic_struct));
 
         for (i = 0; i < nelem; i++)
         {
+            ic_struct      *ic_ptr;
+
+            ic_ptr = &ic[elem[i].id - 1];
+
 #if defined(_CYCLES_OBSOLETE_)
-            fwrite(&elem[i].ws.flatResidueWater, sizeof(double), 1, init_file);
+            ic_ptr->cmc = elem[i].ws.flatResidueWater;
 #else
-            fwrite(&elem[i].ws.cmc,       sizeof(double), 1, init_file);
+            ic_ptr->cmc = elem[i].ws.cmc;
 #endif
-            fwrite(&elem[i].ws.sneqv,     sizeof(double), 1, init_file);
-            fwrite(&elem[i].ws.surf,      sizeof(double), 1, init_file);
-            fwrite(&elem[i].ws.unsat,     sizeof(double), 1, init_file);
-            fwrite(&elem[i].ws.gw,        sizeof(double), 1, init_file);
+            ic_ptr->sneqv = elem[i].ws.sneqv;
+            ic_ptr->surf = elem[i].ws.surf;
+            ic_ptr->unsat = elem[i].ws.unsat;
+            ic_ptr->gw = elem[i].ws.gw;
 #if defined(_DGW_)
-            fwrite(&elem[i].ws.unsat_geol, sizeof(double), 1, init_file);
-            fwrite(&elem[i].ws.gw_geol,    sizeof(double), 1, init_file);
+            ic_ptr->unsat_geol = elem[i].ws.unsat_geol;
+            ic_ptr->gw_geol = elem[i].ws.gw_geol;
 #endif
 #if defined(_NOAH_)
-            fwrite(&elem[i].es.t1,        sizeof(double), 1, init_file);
-            fwrite(&elem[i].ps.snowh,     sizeof(double), 1, init_file);
+            ic_ptr->t1 = elem[i].es.t1;
+            ic_ptr->snowh = elem[i].ps.snowh;
 
             int             j;
 
             for (j = 0; j < MAXLYR; j++)
             {
-                fwrite(&elem[i].es.stc[j], sizeof(double), 1, init_file);
-            }
-            for (j = 0; j < MAXLYR; j++)
-            {
-                fwrite(&elem[i].ws.smc[j], sizeof(double), 1, init_file);
-            }
-            for (j = 0; j < MAXLYR; j++)
-            {
-                fwrite(&elem[i].ws.swc[j], sizeof(double), 1, init_file);
+                ic_ptr->stc[j] = elem[i].es.stc[j];
+                ic_ptr->smc[j] = elem[i].ws.smc[j];
+                ic_ptr->swc[j] = elem[i].ws.swc[j];
             }
 #endif
         }
 
         for (i = 0; i < nriver; i++)
         {
-            fwrite(&river[i].ws.stage, sizeof(double), 1, init_file);
+            river_ic[river[i].id - 1].stage = river[i].ws.stage;
         }
 
+        init_file = pihm_fopen(fn, "wb");
+
+        fwrite(ic, sizeof(ic_struct), nelem, init_file);
+        fwrite(river_ic, sizeof(river_ic_struct), nriver, init_file);
+
         fflush(init_file);
         fclose(init_file);
+
+        free(ic);
+        free(river_ic);
     }
 }
 
 void PrintPerf(int t, int starttime, double cputime_dt, double cputime,
-    double maxstep, FILE *perf_file, void *cvode_mem)
+    double maxstep, const colorjac_struct *colorjac,
+    const cvstats_struct *stats, FILE *perf_file)
 {
     static double   dt;
-    static long int nst0, nfe0, nni0, ncfn0, netf0;
-    long int        nst, nfe, nni, ncfn, netf;
-    int             cv_flag;
-
-    /* Get the cumulative number of internal steps taken by the solver (total
-     * so far) */
-    cv_flag = CVodeGetNumSteps(cvode_mem, &nst);
-    CheckCVodeFlag(cv_flag);
-
-    /* Get the number of calls to the user's right-hand side function */
-    cv_flag = CVodeGetNumRhsEvals(cvode_mem, &nfe);
-    CheckCVodeFlag(cv_flag);
-
-    /* Get the number of nonlinear iterations performed */
-    cv_flag = CVodeGetNumNonlinSolvIters(cvode_mem, &nni);
-    CheckCVodeFlag(cv_flag);
-
-    /* Get the number of nonlinear convergence failures that have occurred */
-    cv_flag = CVodeGetNumNonlinSolvConvFails(cvode_mem, &ncfn);
-    CheckCVodeFlag(cv_flag);
-
-    /* Get the number of local error test failures that have occurred */
-    cv_flag = CVodeGetNumErrTestFails(cvode_mem, &netf);
-    CheckCVodeFlag(cv_flag);
+    static double   jac_time0;
+    static cvstats_struct stats0;
 
+    /* Colors and Jacobian setup time are only available with the colored
+     * finite difference Jacobian */
     fprintf(perf_file, "%-8d%-8.3f%-16.3f%-8.2f",
         t - starttime, cputime_dt, cputime, maxstep);
-    fprintf(perf_file, "%-8ld%-8ld%-8ld%-8ld%-8ld\n",
-        nst - nst0, nni - nni0, nfe - nfe0, netf - netf0, ncfn - ncfn0);
+    fprintf(perf_file, "%-8ld%-8ld%-8ld%-8ld%-8ld",
+        stats->nst - stats0.nst, stats->nni - stats0.nni,
+        stats->nfe - stats0.nfe, stats->netf - stats0.netf,
+        stats->ncfn - stats0.ncfn);
+    fprintf(perf_file, "%-8ld%-8ld%-10ld%-9ld",
+        stats->nli - stats0.nli, stats->npe - stats0.npe,
+        stats->nps - stats0.nps, stats->nlcf - stats0.nlcf);
+    fprintf(perf_file, "%-8ld%-8d%-9.3f%-8ld\n", stats->nje - stats0.nje,
+        (colorjac == NULL) ? 0 : colorjac->ncolors,
+        (colorjac == NULL) ? 0.0 : colorjac->time - jac_time0,
+        stats->nevents - stats0.nevents);
     fflush(perf_file);
 
     dt = 0.0;
 
-    nst0 = nst;
-    nni0 = nni;
-    nfe0 = nfe;
-    netf0 = netf;
-    ncfn0 = ncfn;
+    stats0 = *stats;
+    jac_time0 = (colorjac == NULL) ? 0.0 : colorjac->time;
 
     dt += cputime_dt;
 }
@@ -693,38 +790,31 @@ void PrintWaterBalance(int t, int tstart, int dt, const elem_struct elem[],
     tot_strg_prev = tot_strg;
 }
 
-void PrintCVodeFinalStats(void *cvode_mem)
+void PrintCVodeFinalStats(const cvstats_struct *stats, const nls_struct *nls)
 {
-    int             cv_flag;
-    long int        nst;
-    long int        nfe;
-    long int        netf;
-    long int        nni;
-    long int        ncfn;
-
-    cv_flag = CVodeGetNumSteps(cvode_mem, &nst);
-    CheckCVodeFlag(cv_flag);
-
-    cv_flag = CVodeGetNumRhsEvals(cvode_mem, &nfe);
-    CheckCVodeFlag(cv_flag);
-
-    cv_flag = CVodeGetNumErrTestFails(cvode_mem, &netf);
-    CheckCVodeFlag(cv_flag);
-
-    cv_flag = CVodeGetNumNonlinSolvConvFails(cvode_mem, &ncfn);
-    CheckCVodeFlag(cv_flag);
-
-    cv_flag = CVodeGetNumNonlinSolvIters(cvode_mem, &nni);
-    CheckCVodeFlag(cv_flag);
-
     pihm_printf(VL_NORMAL, "\n");
     pihm_printf(VL_NORMAL,
-        "num of steps = %-6ld num of rhs evals = %-6ld\n", nst, nfe);
+        "num of steps = %-6ld num of rhs evals = %-6ld\n", stats->nst,
+        stats->nfe);
     pihm_printf(VL_NORMAL,
         "num of nonlin solv iters = %-6ld "
         "num of nonlin solv conv fails = %-6ld "
         "num of err test fails = %-6ld\n",
-        nni, ncfn, netf);
+        stats->nni, stats->ncfn, stats->netf);
+    pihm_printf(VL_NORMAL,
+        "num of lin solv iters = %-6ld "
+        "num of prec evals = %-6ld "
+        "num of prec solves = %-6ld\n",
+        stats->nli, stats->npe, stats->nps);
+    pihm_printf(VL_NORMAL,
+        "num of lin solv conv fails = %-6ld "
+        "num of jac evals = %-6ld\n",
+        stats->nlcf, stats->nje);
+    pihm_printf(VL_NORMAL,
+        "num of Newton steps = %-6ld "
+        "num of fixed-point steps = %-6ld "
+        "num of root events = %-6ld\n",
+        nls->nsteps[NEWTON_NLS], nls->nsteps[FIXEDPT_NLS], stats->nevents);
 }
 
 int PrintNow(int intvl, int lapse, pihm_t_struct pihm_time)
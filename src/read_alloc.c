@@ -57,6 +57,16 @@ void ReadAlloc(pihm_struct pihm)
     sprintf(pihm->filename.rtic,     "input/%s/%s.rtic",     proj, proj);
 #endif
 
+    /* Binary forcing files are mapped by the forcing readers */
+    pihm->forc.nbinforc = 0;
+    pihm->forc.nstream = 0;
+#if defined(_NOAH_)
+    pihm->forc.nrad = 0;
+#endif
+#if defined(_RT_)
+    pihm->forc.nprcpc = 0;
+#endif
+
     /* Read river input file */
     ReadRiver(pihm->filename.riv, &pihm->rivtbl, &pihm->shptbl, &pihm->matltbl,
         &pihm->forc);
@@ -180,4 +190,8 @@ void ReadAlloc(pihm_struct pihm)
         pihm->forc.nndep = 0;
     }
 #endif
+
+    /* Renumber elements and river segments for memory locality. Has to be
+     * done after all element and river tables have been read */
+    Renumber(pihm);
 }
@@ -53,7 +53,12 @@ void ReadBc(const char fn[], const atttbl_struct *atttbl,
 
     forc->nbc = 0;
 
-    if (read_bc)
+#if defined(_RT_)
+    if (read_bc &&
+        !MapForcing(fn, rttbl->num_stc + 1, &forc->nbc, &forc->bc, forc))
+#else
+    if (read_bc && !MapForcing(fn, 1, &forc->nbc, &forc->bc, forc))
+#endif
     {
         fp = pihm_fopen(fn, "r");
         pihm_printf(VL_VERBOSE, " Reading %s\n", fn);
@@ -150,25 +155,20 @@ void ReadBc(const char fn[], const atttbl_struct *atttbl,
                 NextLine(fp, cmdstr, &lno);
                 NextLine(fp, cmdstr, &lno);
 
-                forc->bc[i].ftime =
-                    (int *)malloc(forc->bc[i].length * sizeof(int));
-                forc->bc[i].data =
-                    (double **)malloc(forc->bc[i].length * sizeof(double *));
-                for (j = 0; j < forc->bc[i].length; j++)
-                {
 #if defined(_RT_)
-                    forc->bc[i].data[j] =
-                        (double *)malloc((rttbl->num_stc + 1) * sizeof(double));
+                NewTs(forc->bc[i].length, rttbl->num_stc + 1, &forc->bc[i]);
 #else
-                    forc->bc[i].data[j] = (double *)malloc(sizeof(double));
+                NewTs(forc->bc[i].length, 1, &forc->bc[i]);
 #endif
+                for (j = 0; j < forc->bc[i].length; j++)
+                {
                     NextLine(fp, cmdstr, &lno);
 #if defined(_RT_)
                     if (!ReadTs(cmdstr, rttbl->num_stc + 1,
                         &forc->bc[i].ftime[j], bcval))
 #else
                     if (!ReadTs(cmdstr, 1, &forc->bc[i].ftime[j],
-                        &forc->bc[i].data[j][0]))
+                        &forc->bc[i].data[0][j]))
 #endif
                     {
                         pihm_error(ERR_WRONG_FORMAT, fn, lno);
@@ -178,21 +178,21 @@ void ReadBc(const char fn[], const atttbl_struct *atttbl,
                     {
                         int             k;
 
-                        forc->bc[i].data[j][0] = bcval[0];
+                        forc->bc[i].data[0][j] = bcval[0];
 
                         for (k = 0; k < rttbl->num_stc; k++)
                         {
                             if (strcmp(chemtbl[k].name, "pH") == 0)
                             {
                                 /* Convert pH to H+ concentration */
-                                forc->bc[i].data[j][k + 1] =
+                                forc->bc[i].data[k + 1][j] =
                                     (bcval[1 + ind[k]] < 7.0) ?
                                     pow(10, -bcval[1 + ind[k]]) :
                                     -pow(10, -bcval[1 + ind[k]] - 14);
                             }
                             else
                             {
-                                forc->bc[i].data[j][k + 1] = bcval[1 + ind[k]];
+                                forc->bc[i].data[k + 1][j] = bcval[1 + ind[k]];
                             }
                         }
                     }
@@ -5,10 +5,16 @@ void ReadMeteo(const char fn[], forc_struct *forc)
     FILE           *fp;
     char            cmdstr[MAXSTRING];
     char            tempstr[2][MAXSTRING];
-    int             i, j;
+    int             i, j, k;
     int             match;
     int             index;
     int             lno = 0;
+    double          row[NUM_METEO_VAR];
+
+    if (MapForcing(fn, NUM_METEO_VAR, &forc->nmeteo, &forc->meteo, forc))
+    {
+        return;
+    }
 
     fp = pihm_fopen(fn, "r");
     pihm_printf(VL_VERBOSE, " Reading %s\n", fn);
@@ -52,20 +58,20 @@ void ReadMeteo(const char fn[], forc_struct *forc)
             NextLine(fp, cmdstr, &lno);
             NextLine(fp, cmdstr, &lno);
 
-            forc->meteo[i].ftime =
-                (int *)malloc(forc->meteo[i].length * sizeof(int));
-            forc->meteo[i].data =
-                (double **)malloc(forc->meteo[i].length * sizeof(double *));
+            NewTs(forc->meteo[i].length, NUM_METEO_VAR, &forc->meteo[i]);
             for (j = 0; j < forc->meteo[i].length; j++)
             {
-                forc->meteo[i].data[j] =
-                    (double *)malloc(NUM_METEO_VAR * sizeof(double));
                 NextLine(fp, cmdstr, &lno);
                 if (!ReadTs(cmdstr, NUM_METEO_VAR, &forc->meteo[i].ftime[j],
-                    &forc->meteo[i].data[j][0]))
+                    row))
                 {
                     pihm_error(ERR_WRONG_FORMAT, fn, lno);
                 }
+
+                for (k = 0; k < NUM_METEO_VAR; k++)
+                {
+                    forc->meteo[i].data[k][j] = row[k];
+                }
             }
         }
     }
@@ -1,10 +1,13 @@
 #include "pihm.h"
 
-void ReadIc(const char fn[], elem_struct elem[], river_struct river[])
+void ReadIc(const char fn[], const elem_struct elem[],
+    const river_struct river[], init_struct *init)
 {
     FILE           *fp;
     int             i;
     int             size;
+    ic_struct      *ic;
+    river_ic_struct *river_ic;
 
     fp = pihm_fopen(fn, "rb");
     pihm_printf(VL_VERBOSE, " Reading %s\n", fn);
@@ -24,15 +27,25 @@ void ReadIc(const char fn[], elem_struct elem[], river_struct river[])
 
     fseek(fp, 0L, SEEK_SET);
 
+    /* Records are stored in the order of element and river IDs */
+    ic = (ic_struct *)malloc(nelem * sizeof(ic_struct));
+    river_ic = (river_ic_struct *)malloc(nriver * sizeof(river_ic_struct));
+
+    fread(ic, sizeof(ic_struct), nelem, fp);
+    fread(river_ic, sizeof(river_ic_struct), nriver, fp);
+
+    fclose(fp);
+
     for (i = 0; i < nelem; i++)
     {
-        fread(&elem[i].ic, sizeof(ic_struct), 1, fp);
+        init->ic[i] = ic[elem[i].id - 1];
     }
 
     for (i = 0; i < nriver; i++)
     {
-        fread(&river[i].ic, sizeof(river_ic_struct), 1, fp);
+        init->river_ic[i] = river_ic[river[i].id - 1];
     }
 
-    fclose(fp);
+    free(ic);
+    free(river_ic);
 }
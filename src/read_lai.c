@@ -21,7 +21,7 @@ void ReadLai(const char fn[], const atttbl_struct *atttbl,
 
     forc->nlai = 0;
 
-    if (read_lai)
+    if (read_lai && !MapForcing(fn, 1, &forc->nlai, &forc->lai, forc))
     {
         fp = pihm_fopen(fn, "r");
         pihm_printf(VL_VERBOSE, " Reading %s\n", fn);
@@ -63,16 +63,12 @@ void ReadLai(const char fn[], const atttbl_struct *atttbl,
                 NextLine(fp, cmdstr, &lno);
                 NextLine(fp, cmdstr, &lno);
 
-                forc->lai[i].ftime =
-                    (int *)malloc(forc->lai[i].length * sizeof(int));
-                forc->lai[i].data =
-                    (double **)malloc(forc->lai[i].length * sizeof(double *));
+                NewTs(forc->lai[i].length, 1, &forc->lai[i]);
                 for (j = 0; j < forc->lai[i].length; j++)
                 {
-                    forc->lai[i].data[j] = (double *)malloc(sizeof(double));
                     NextLine(fp, cmdstr, &lno);
                     if (!ReadTs(cmdstr, 1, &forc->lai[i].ftime[j],
-                        &forc->lai[i].data[j][0]))
+                        &forc->lai[i].data[0][j]))
                     {
                         pihm_error(ERR_WRONG_FORMAT, fn, lno);
                     }
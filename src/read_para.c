@@ -101,7 +101,45 @@ void ReadPara(const char fn[], ctrl_struct *ctrl)
     NextLine(fp, cmdstr, &lno);
     ReadKeyword(cmdstr, "MIN_MAXSTEP", 'd', fn, lno, &ctrl->stmin);
 
+    /* Optional solver keywords, which may be omitted from .para files */
+    ctrl->precond = PREC_NONE;
+    ctrl->jtimes = 0;
+    ctrl->linsol = ITERATIVE_LS;
+    ctrl->krylov = KRYLOV_SPGMR;
+    ctrl->maxl = 0;
+    ctrl->gstype = MODIFIED_GS;
+    ctrl->epslin = 0.0;
+    ctrl->msbj = 0;
+    ctrl->nls = BDF_NEWTON;
+    ctrl->anderson = 3;
+    ctrl->dense = 0;
+    ctrl->schedule = 0;
+    ctrl->root_event = 0;
+    ctrl->event_hold = 900;
+    ctrl->renumber = NO_RENUMBER;
+    ctrl->forc_mem = 0.0;
+    ctrl->output_flush = FLUSH_OUTPUT;
+    ctrl->output_format = DAT_FORMAT;
+#if defined(_BGC_) || defined(_CYCLES_) || defined(_RT_)
+    ctrl->sparse_jac = COLOR_FD_JAC;
+#else
+    ctrl->sparse_jac = ANALYTIC_JAC;
+#endif
+
     NextLine(fp, cmdstr, &lno);
+    while (ReadSolverKeyword(cmdstr, fn, lno, ctrl))
+    {
+        NextLine(fp, cmdstr, &lno);
+    }
+
+    if (ctrl->linsol == SPARSE_LS)
+    {
+        /* Preconditioner and Jacobian-times-vector options only apply to the
+         * iterative solver */
+        ctrl->precond = PREC_NONE;
+        ctrl->jtimes = 0;
+    }
+
     ctrl->prtvrbl[SURF_CTRL] = ReadPrintCtrl(cmdstr, "SURF", fn, lno);
 
     NextLine(fp, cmdstr, &lno);
@@ -183,3 +221,273 @@ void ReadPara(const char fn[], ctrl_struct *ctrl)
         pihm_exit(EXIT_FAILURE);
     }
 }
+
+int ReadSolverKeyword(const char cmdstr[], const char fn[], int lno,
+    ctrl_struct *ctrl)
+{
+    char            optstr[MAXSTRING];
+    int             success = 1;
+
+    if (sscanf(cmdstr, "%s", optstr) != 1)
+    {
+        return 0;
+    }
+
+    if (strcasecmp(optstr, "PRECOND") == 0)
+    {
+        ReadKeyword(cmdstr, "PRECOND", 'i', fn, lno, &ctrl->precond);
+        if (ctrl->precond != PREC_NONE && ctrl->precond != PREC_LEFT &&
+            ctrl->precond != PREC_RIGHT)
+        {
+            pihm_printf(VL_ERROR,
+                "Error: Preconditioner type %d is not defined.\n",
+                ctrl->precond);
+            pihm_error(ERR_WRONG_FORMAT, fn, lno);
+        }
+    }
+    else if (strcasecmp(optstr, "JAC_TIMES") == 0)
+    {
+        ReadKeyword(cmdstr, "JAC_TIMES", 'i', fn, lno, &ctrl->jtimes);
+        if (ctrl->jtimes != 0 && ctrl->jtimes != 1)
+        {
+            pihm_printf(VL_ERROR,
+                "Error: Jacobian-times-vector option %d is not defined.\n",
+                ctrl->jtimes);
+            pihm_error(ERR_WRONG_FORMAT, fn, lno);
+        }
+#if defined(_BGC_) || defined(_CYCLES_) || defined(_RT_)
+        if (ctrl->jtimes == 1)
+        {
+            /* Analytic J*v only covers hydrology rows */
+            pihm_printf(VL_NORMAL, "Analytic Jacobian-times-vector is not "
+                "available with solute transport. Difference quotient is "
+                "used.\n");
+            ctrl->jtimes = 0;
+        }
+#endif
+    }
+    else if (strcasecmp(optstr, "LINEAR_SOLVER") == 0)
+    {
+        ReadKeyword(cmdstr, "LINEAR_SOLVER", 'i', fn, lno, &ctrl->linsol);
+        if (ctrl->linsol != ITERATIVE_LS && ctrl->linsol != SPARSE_LS)
+        {
+            pihm_printf(VL_ERROR,
+                "Error: Linear solver type %d is not defined.\n",
+                ctrl->linsol);
+            pihm_error(ERR_WRONG_FORMAT, fn, lno);
+        }
+    }
+    else if (strcasecmp(optstr, "KRYLOV_SOLVER") == 0)
+    {
+        ReadKeyword(cmdstr, "KRYLOV_SOLVER", 'i', fn, lno, &ctrl->krylov);
+        if (ctrl->krylov < KRYLOV_SPGMR || ctrl->krylov > KRYLOV_PCG)
+        {
+            pihm_printf(VL_ERROR,
+                "Error: Krylov solver type %d is not defined.\n",
+                ctrl->krylov);
+            pihm_error(ERR_WRONG_FORMAT, fn, lno);
+        }
+    }
+    else if (strcasecmp(optstr, "KRYLOV_DIM") == 0)
+    {
+        ReadKeyword(cmdstr, "KRYLOV_DIM", 'i', fn, lno, &ctrl->maxl);
+        if (ctrl->maxl < 0)
+        {
+            pihm_printf(VL_ERROR,
+                "Error: Krylov subspace dimension should be non-negative.\n");
+            pihm_error(ERR_WRONG_FORMAT, fn, lno);
+        }
+    }
+    else if (strcasecmp(optstr, "GRAM_SCHMIDT") == 0)
+    {
+        ReadKeyword(cmdstr, "GRAM_SCHMIDT", 'i', fn, lno, &ctrl->gstype);
+        if (ctrl->gstype != MODIFIED_GS && ctrl->gstype != CLASSICAL_GS)
+        {
+            pihm_printf(VL_ERROR,
+                "Error: Gram-Schmidt type %d is not defined.\n",
+                ctrl->gstype);
+            pihm_error(ERR_WRONG_FORMAT, fn, lno);
+        }
+    }
+    else if (strcasecmp(optstr, "EPS_LIN") == 0)
+    {
+        ReadKeyword(cmdstr, "EPS_LIN", 'd', fn, lno, &ctrl->epslin);
+        if (ctrl->epslin < 0.0)
+        {
+            pihm_printf(VL_ERROR,
+                "Error: Linear convergence factor should be non-negative.\n");
+            pihm_error(ERR_WRONG_FORMAT, fn, lno);
+        }
+    }
+    else if (strcasecmp(optstr, "JAC_SETUP_STEPS") == 0)
+    {
+        ReadKeyword(cmdstr, "JAC_SETUP_STEPS", 'i', fn, lno, &ctrl->msbj);
+        if (ctrl->msbj < 0)
+        {
+            pihm_printf(VL_ERROR, "Error: Maximum number of steps between "
+                "Jacobian setups should be non-negative.\n");
+            pihm_error(ERR_WRONG_FORMAT, fn, lno);
+        }
+    }
+    else if (strcasecmp(optstr, "NONLIN_SOLVER") == 0)
+    {
+        ReadKeyword(cmdstr, "NONLIN_SOLVER", 'i', fn, lno, &ctrl->nls);
+        if (ctrl->nls != BDF_NEWTON && ctrl->nls != ADAMS_FIXEDPT &&
+            ctrl->nls != AUTO_NLS)
+        {
+            pihm_printf(VL_ERROR,
+                "Error: Nonlinear solver type %d is not defined.\n",
+                ctrl->nls);
+            pihm_error(ERR_WRONG_FORMAT, fn, lno);
+        }
+    }
+    else if (strcasecmp(optstr, "ANDERSON_DEPTH") == 0)
+    {
+        ReadKeyword(cmdstr, "ANDERSON_DEPTH", 'i', fn, lno, &ctrl->anderson);
+        if (ctrl->anderson < 0)
+        {
+            pihm_printf(VL_ERROR,
+                "Error: Anderson acceleration depth should be "
+                "non-negative.\n");
+            pihm_error(ERR_WRONG_FORMAT, fn, lno);
+        }
+    }
+    else if (strcasecmp(optstr, "SPARSE_JAC") == 0)
+    {
+        ReadKeyword(cmdstr, "SPARSE_JAC", 'i', fn, lno, &ctrl->sparse_jac);
+        if (ctrl->sparse_jac != ANALYTIC_JAC &&
+            ctrl->sparse_jac != COLOR_FD_JAC)
+        {
+            pihm_printf(VL_ERROR,
+                "Error: Sparse Jacobian type %d is not defined.\n",
+                ctrl->sparse_jac);
+            pihm_error(ERR_WRONG_FORMAT, fn, lno);
+        }
+#if defined(_BGC_) || defined(_CYCLES_) || defined(_RT_)
+        if (ctrl->sparse_jac == ANALYTIC_JAC)
+        {
+            /* The analytic Jacobian only covers hydrology rows */
+            pihm_printf(VL_NORMAL, "Analytic sparse Jacobian is not "
+                "available with solute transport. Colored finite difference "
+                "is used.\n");
+            ctrl->sparse_jac = COLOR_FD_JAC;
+        }
+#endif
+    }
+    else if (strcasecmp(optstr, "DENSE_OUTPUT") == 0)
+    {
+        ReadKeyword(cmdstr, "DENSE_OUTPUT", 'i', fn, lno, &ctrl->dense);
+        if (ctrl->dense != 0 && ctrl->dense != 1)
+        {
+            pihm_printf(VL_ERROR,
+                "Error: Dense output option %d is not defined.\n",
+                ctrl->dense);
+            pihm_error(ERR_WRONG_FORMAT, fn, lno);
+        }
+#if defined(_BGC_) || defined(_CYCLES_) || defined(_RT_)
+        if (ctrl->dense == 1)
+        {
+            /* Solute modules update CVODE states between model steps */
+            pihm_printf(VL_NORMAL, "Dense output is not available with "
+                "solute transport. CVODE stops at every model step.\n");
+            ctrl->dense = 0;
+        }
+#endif
+    }
+    else if (strcasecmp(optstr, "EVENT_SCHEDULE") == 0)
+    {
+        ReadKeyword(cmdstr, "EVENT_SCHEDULE", 'i', fn, lno, &ctrl->schedule);
+        if (ctrl->schedule != 0 && ctrl->schedule != 1)
+        {
+            pihm_printf(VL_ERROR,
+                "Error: Event schedule option %d is not defined.\n",
+                ctrl->schedule);
+            pihm_error(ERR_WRONG_FORMAT, fn, lno);
+        }
+#if defined(_DAILY_)
+        if (ctrl->schedule == 1)
+        {
+            /* Daily averages are sampled at every model step */
+            pihm_printf(VL_NORMAL, "Event schedule is not available with "
+                "daily modules. Every model step is simulated.\n");
+            ctrl->schedule = 0;
+        }
+#endif
+    }
+    else if (strcasecmp(optstr, "ROOT_EVENTS") == 0)
+    {
+        ReadKeyword(cmdstr, "ROOT_EVENTS", 'i', fn, lno, &ctrl->root_event);
+        if (ctrl->root_event != 0 && ctrl->root_event != 1)
+        {
+            pihm_printf(VL_ERROR,
+                "Error: Root-finding event option %d is not defined.\n",
+                ctrl->root_event);
+            pihm_error(ERR_WRONG_FORMAT, fn, lno);
+        }
+    }
+    else if (strcasecmp(optstr, "EVENT_HOLDOFF") == 0)
+    {
+        ReadKeyword(cmdstr, "EVENT_HOLDOFF", 'i', fn, lno, &ctrl->event_hold);
+        if (ctrl->event_hold < 0)
+        {
+            pihm_printf(VL_ERROR,
+                "Error: Event hold-off time should be non-negative.\n");
+            pihm_error(ERR_WRONG_FORMAT, fn, lno);
+        }
+    }
+    else if (strcasecmp(optstr, "RENUMBER") == 0)
+    {
+        ReadKeyword(cmdstr, "RENUMBER", 'i', fn, lno, &ctrl->renumber);
+        if (ctrl->renumber != NO_RENUMBER && ctrl->renumber != RCM_RENUMBER &&
+            ctrl->renumber != HILBERT_RENUMBER)
+        {
+            pihm_printf(VL_ERROR,
+                "Error: Renumbering option %d is not defined.\n",
+                ctrl->renumber);
+            pihm_error(ERR_WRONG_FORMAT, fn, lno);
+        }
+    }
+    else if (strcasecmp(optstr, "FORC_MEMORY") == 0)
+    {
+        ReadKeyword(cmdstr, "FORC_MEMORY", 'd', fn, lno, &ctrl->forc_mem);
+        if (ctrl->forc_mem < 0.0)
+        {
+            pihm_printf(VL_ERROR,
+                "Error: Memory of streamed forcing should be non-negative.\n");
+            pihm_error(ERR_WRONG_FORMAT, fn, lno);
+        }
+    }
+    else if (strcasecmp(optstr, "OUTPUT_FLUSH") == 0)
+    {
+        ReadKeyword(cmdstr, "OUTPUT_FLUSH", 'i', fn, lno, &ctrl->output_flush);
+        if (ctrl->output_flush != FLUSH_OUTPUT &&
+            ctrl->output_flush != FLUSH_CHECKPOINT &&
+            ctrl->output_flush != FLUSH_FULL)
+        {
+            pihm_printf(VL_ERROR,
+                "Error: Output flush option %d is not defined.\n",
+                ctrl->output_flush);
+            pihm_error(ERR_WRONG_FORMAT, fn, lno);
+        }
+    }
+    else if (strcasecmp(optstr, "OUTPUT_FORMAT") == 0)
+    {
+        ReadKeyword(cmdstr, "OUTPUT_FORMAT", 'i', fn, lno,
+            &ctrl->output_format);
+        if (ctrl->output_format != DAT_FORMAT &&
+            ctrl->output_format != CONTAINER_FORMAT)
+        {
+            pihm_printf(VL_ERROR,
+                "Error: Output format %d is not defined.\n",
+                ctrl->output_format);
+            pihm_error(ERR_WRONG_FORMAT, fn, lno);
+        }
+    }
+    else
+    {
+        /* Not a solver keyword */
+        success = 0;
+    }
+
+    return success;
+}
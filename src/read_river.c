@@ -171,16 +171,12 @@ void ReadRiver(const char fn[], rivtbl_struct *rivtbl,
             NextLine(fp, cmdstr, &lno);
             NextLine(fp, cmdstr, &lno);
 
-            forc->riverbc[i].data =
-                (double **)malloc((forc->riverbc[i].length) * sizeof(double *));
-            forc->riverbc[i].ftime =
-                (int *)malloc((forc->riverbc[i].length) * sizeof(int));
+            NewTs(forc->riverbc[i].length, 1, &forc->riverbc[i]);
             for (j = 0; j < forc->riverbc[i].length; j++)
             {
-                forc->riverbc[i].data[j] = (double *)malloc(sizeof(double));
                 NextLine(fp, cmdstr, &lno);
                 if (!ReadTs(cmdstr, 1, &forc->riverbc[i].ftime[j],
-                    &forc->riverbc[i].data[j][0]))
+                    &forc->riverbc[i].data[0][j]))
                 {
                     pihm_error(ERR_WRONG_FORMAT, fn, lno);
                 }
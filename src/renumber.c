@@ -0,0 +1,409 @@
+#include "pihm.h"
+
+void Renumber(pihm_struct pihm)
+{
+    /*
+     * Renumber elements and river segments so that neighbors are stored close
+     * to each other in memory. Rows of the element and river input tables are
+     * permuted, and element and river indices in the tables are mapped to the
+     * new numbering. IDs used in input files are kept in the mesh and river
+     * tables, and are used to read and write files in the original order
+     */
+    int             i, j;
+    int            *order;
+    int            *new_ind;
+    int            *rorder;
+    int            *new_rind;
+    int             max0, max1;
+    double          avg0, avg1;
+    meshtbl_struct *meshtbl;
+    atttbl_struct  *atttbl;
+    rivtbl_struct  *rivtbl;
+
+    meshtbl = &pihm->meshtbl;
+    atttbl = &pihm->atttbl;
+    rivtbl = &pihm->rivtbl;
+
+    meshtbl->id = (int *)malloc(nelem * sizeof(int));
+    rivtbl->id = (int *)malloc(nriver * sizeof(int));
+
+    for (i = 0; i < nelem; i++)
+    {
+        meshtbl->id[i] = i + 1;
+    }
+    for (i = 0; i < nriver; i++)
+    {
+        rivtbl->id[i] = i + 1;
+    }
+
+    if (pihm->ctrl.renumber == NO_RENUMBER)
+    {
+        return;
+    }
+
+    /* order[i] is the old index of the element that becomes element i, and
+     * new_ind is its inverse */
+    order = (int *)malloc(nelem * sizeof(int));
+    new_ind = (int *)malloc(nelem * sizeof(int));
+    rorder = (int *)malloc(nriver * sizeof(int));
+    new_rind = (int *)malloc(nriver * sizeof(int));
+
+    NabrIndexDist(meshtbl, &max0, &avg0);
+
+    if (pihm->ctrl.renumber == RCM_RENUMBER)
+    {
+        ElemRcmOrder(meshtbl, order);
+    }
+    else
+    {
+        ElemHilbertOrder(meshtbl, order);
+    }
+
+    for (i = 0; i < nelem; i++)
+    {
+        new_ind[order[i]] = i;
+    }
+
+    /* River segments follow their bank elements */
+    RiverOrder(rivtbl, new_ind, rorder);
+
+    for (i = 0; i < nriver; i++)
+    {
+        new_rind[rorder[i]] = i;
+    }
+
+    /*
+     * Element tables
+     */
+    PermuteInt(nelem, order, meshtbl->id);
+    PermuteIntPtr(nelem, order, meshtbl->node);
+    PermuteIntPtr(nelem, order, meshtbl->nabr);
+    for (i = 0; i < nelem; i++)
+    {
+        for (j = 0; j < NUM_EDGE; j++)
+        {
+            meshtbl->nabr[i][j] = (meshtbl->nabr[i][j] > 0) ?
+                new_ind[meshtbl->nabr[i][j] - 1] + 1 : meshtbl->nabr[i][j];
+        }
+    }
+
+    PermuteInt(nelem, order, atttbl->soil);
+    PermuteInt(nelem, order, atttbl->geol);
+    PermuteInt(nelem, order, atttbl->lc);
+    PermuteInt(nelem, order, atttbl->meteo);
+    PermuteInt(nelem, order, atttbl->lai);
+    PermuteIntPtr(nelem, order, atttbl->bc);
+#if defined(_DGW_)
+    PermuteIntPtr(nelem, order, atttbl->bc_geol);
+#endif
+#if defined(_RT_)
+    PermuteInt(nelem, order, atttbl->prcpc);
+    PermuteIntPtr(nelem, order, atttbl->chem_ic);
+#endif
+#if defined(_CYCLES_)
+    PermuteInt(nelem, order, pihm->agtbl.oper);
+#endif
+
+    /*
+     * River tables
+     */
+    PermuteInt(nriver, rorder, rivtbl->id);
+    PermuteInt(nriver, rorder, rivtbl->from);
+    PermuteInt(nriver, rorder, rivtbl->to);
+    PermuteInt(nriver, rorder, rivtbl->down);
+    PermuteInt(nriver, rorder, rivtbl->left);
+    PermuteInt(nriver, rorder, rivtbl->right);
+    PermuteInt(nriver, rorder, rivtbl->shp);
+    PermuteInt(nriver, rorder, rivtbl->matl);
+    PermuteInt(nriver, rorder, rivtbl->bc);
+    PermuteInt(nriver, rorder, rivtbl->rsvr);
+    for (i = 0; i < nriver; i++)
+    {
+        /* Negative down segments are outlets */
+        rivtbl->down[i] = (rivtbl->down[i] > 0) ?
+            new_rind[rivtbl->down[i] - 1] + 1 : rivtbl->down[i];
+        rivtbl->left[i] = new_ind[rivtbl->left[i] - 1] + 1;
+        rivtbl->right[i] = new_ind[rivtbl->right[i] - 1] + 1;
+    }
+
+    NabrIndexDist(meshtbl, &max1, &avg1);
+
+    pihm_printf(VL_VERBOSE, "Renumbering (%s): index distance between "
+        "neighbors %.1lf -> %.1lf (average), %d -> %d (maximum).\n",
+        (pihm->ctrl.renumber == RCM_RENUMBER) ?
+        "reverse Cuthill-McKee" : "Hilbert curve", avg0, avg1, max0, max1);
+
+    free(order);
+    free(new_ind);
+    free(rorder);
+    free(new_rind);
+}
+
+void NabrIndexDist(const meshtbl_struct *meshtbl, int *max_dist,
+    double *avg_dist)
+{
+    /* Maximum (bandwidth) and average index distance between neighboring
+     * elements */
+    int             i, j;
+    int             count = 0;
+    double          sum = 0.0;
+
+    *max_dist = 0;
+
+    for (i = 0; i < nelem; i++)
+    {
+        for (j = 0; j < NUM_EDGE; j++)
+        {
+            if (meshtbl->nabr[i][j] > 0)
+            {
+                *max_dist = MAX(*max_dist, abs(meshtbl->nabr[i][j] - 1 - i));
+                sum += (double)abs(meshtbl->nabr[i][j] - 1 - i);
+                count++;
+            }
+        }
+    }
+
+    *avg_dist = (count > 0) ? sum / (double)count : 0.0;
+}
+
+void ElemRcmOrder(const meshtbl_struct *meshtbl, int order[])
+{
+    /* Reverse Cuthill-McKee ordering of the element adjacency graph, built
+     * in the CSR form used by the sparse LU ordering */
+    int             i, j;
+    sunindextype   *ptr;
+    sunindextype   *ind;
+    sunindextype   *perm;
+
+    ptr = (sunindextype *)malloc((nelem + 1) * sizeof(sunindextype));
+    ind = (sunindextype *)malloc(NUM_EDGE * nelem * sizeof(sunindextype));
+    perm = (sunindextype *)malloc(nelem * sizeof(sunindextype));
+
+    ptr[0] = 0;
+    for (i = 0; i < nelem; i++)
+    {
+        ptr[i + 1] = ptr[i];
+        for (j = 0; j < NUM_EDGE; j++)
+        {
+            if (meshtbl->nabr[i][j] > 0)
+            {
+                ind[ptr[i + 1]++] = meshtbl->nabr[i][j] - 1;
+            }
+        }
+    }
+
+    RcmOrder(nelem, ptr, ind, perm);
+
+    for (i = 0; i < nelem; i++)
+    {
+        order[perm[i]] = i;
+    }
+
+    free(ptr);
+    free(ind);
+    free(perm);
+}
+
+void ElemHilbertOrder(const meshtbl_struct *meshtbl, int order[])
+{
+    /*
+     * Order elements along a Hilbert curve through their centroids. Centroids
+     * are mapped to a 65536 x 65536 grid over the bounding box of the mesh.
+     * Keys hold the curve distance in the upper 32 bits and the element index
+     * in the lower 32 bits, so that sorting keys also breaks ties
+     */
+    int             i;
+    double          xmin = DBL_MAX, xmax = -DBL_MAX;
+    double          ymin = DBL_MAX, ymax = -DBL_MAX;
+    double         *x, *y;
+    unsigned long long *key;
+
+    x = (double *)malloc(nelem * sizeof(double));
+    y = (double *)malloc(nelem * sizeof(double));
+    key = (unsigned long long *)malloc(nelem * sizeof(unsigned long long));
+
+    for (i = 0; i < nelem; i++)
+    {
+        int             j;
+
+        x[i] = 0.0;
+        y[i] = 0.0;
+        for (j = 0; j < NUM_EDGE; j++)
+        {
+            x[i] += meshtbl->x[meshtbl->node[i][j] - 1] / NUM_EDGE;
+            y[i] += meshtbl->y[meshtbl->node[i][j] - 1] / NUM_EDGE;
+        }
+
+        xmin = MIN(xmin, x[i]);
+        xmax = MAX(xmax, x[i]);
+        ymin = MIN(ymin, y[i]);
+        ymax = MAX(ymax, y[i]);
+    }
+
+    for (i = 0; i < nelem; i++)
+    {
+        unsigned int    ix, iy;
+
+        ix = (unsigned int)(65535.0 * (x[i] - xmin) / MAX(xmax - xmin, 1.0));
+        iy = (unsigned int)(65535.0 * (y[i] - ymin) / MAX(ymax - ymin, 1.0));
+
+        key[i] = (HilbertDist(ix, iy) << 32) | (unsigned long long)i;
+    }
+
+    qsort(key, nelem, sizeof(unsigned long long), CompareKey);
+
+    for (i = 0; i < nelem; i++)
+    {
+        order[i] = (int)(key[i] & 0xffffffffULL);
+    }
+
+    free(x);
+    free(y);
+    free(key);
+}
+
+unsigned long long HilbertDist(unsigned int x, unsigned int y)
+{
+    /* Distance of grid cell (x, y) along the Hilbert curve through a
+     * 65536 x 65536 grid */
+    unsigned int    s;
+    unsigned long long d = 0;
+
+    for (s = 1U << 15; s > 0; s >>= 1)
+    {
+        unsigned int    rx, ry;
+
+        rx = ((x & s) > 0) ? 1 : 0;
+        ry = ((y & s) > 0) ? 1 : 0;
+        d += (unsigned long long)s * s * ((3 * rx) ^ ry);
+
+        /* Rotate the quadrant */
+        if (ry == 0)
+        {
+            unsigned int    temp;
+
+            if (rx == 1)
+            {
+                x = 65535 - x;
+                y = 65535 - y;
+            }
+
+            temp = x;
+            x = y;
+            y = temp;
+        }
+    }
+
+    return d;
+}
+
+void RiverOrder(const rivtbl_struct *rivtbl, const int new_ind[],
+    int rorder[])
+{
+    /* Order river segments by the new index of their first bank element */
+    int             i;
+    unsigned long long *key;
+
+    key = (unsigned long long *)malloc(nriver * sizeof(unsigned long long));
+
+    for (i = 0; i < nriver; i++)
+    {
+        int             bank;
+
+        bank = MIN(new_ind[rivtbl->left[i] - 1], new_ind[rivtbl->right[i] - 1]);
+
+        key[i] = ((unsigned long long)bank << 32) | (unsigned long long)i;
+    }
+
+    qsort(key, nriver, sizeof(unsigned long long), CompareKey);
+
+    for (i = 0; i < nriver; i++)
+    {
+        rorder[i] = (int)(key[i] & 0xffffffffULL);
+    }
+
+    free(key);
+}
+
+int CompareKey(const void *a, const void *b)
+{
+    unsigned long long ka = *(const unsigned long long *)a;
+    unsigned long long kb = *(const unsigned long long *)b;
+
+    return (ka > kb) - (ka < kb);
+}
+
+void PermuteInt(int n, const int order[], int a[])
+{
+    int             i;
+    int            *temp;
+
+    temp = (int *)malloc(n * sizeof(int));
+
+    for (i = 0; i < n; i++)
+    {
+        temp[i] = a[order[i]];
+    }
+    for (i = 0; i < n; i++)
+    {
+        a[i] = temp[i];
+    }
+
+    free(temp);
+}
+
+void PermuteIntPtr(int n, const int order[], int *a[])
+{
+    int             i;
+    int           **temp;
+
+    temp = (int **)malloc(n * sizeof(int *));
+
+    for (i = 0; i < n; i++)
+    {
+        temp[i] = a[order[i]];
+    }
+    for (i = 0; i < n; i++)
+    {
+        a[i] = temp[i];
+    }
+
+    free(temp);
+}
+
+void MapOutputIds(const elem_struct elem[], const river_struct river[],
+    print_struct *print)
+{
+    /*
+     * Output files list elements and river segments in the order of their
+     * IDs. Reorder the columns of output variables that hold one value per
+     * element or river segment
+     */
+    int             n;
+
+    for (n = 0; n < print->nprint; n++)
+    {
+        varctrl_struct *varctrl = &print->varctrl[n];
+        const double  **var;
+        int             j;
+
+        /* Column j of element and river outputs holds a variable of elem[j]
+         * or river[j], which may be stored outside of the element or river
+         * structures, e.g., in the reactive transport species pool */
+        if (varctrl->vartype != ELEM_VAR && varctrl->vartype != RIVER_VAR)
+        {
+            continue;
+        }
+
+        var = (const double **)malloc(varctrl->nvar * sizeof(double *));
+
+        for (j = 0; j < varctrl->nvar; j++)
+        {
+            var[((varctrl->vartype == ELEM_VAR) ?
+                elem[j].id : river[j].id) - 1] = varctrl->var[j];
+        }
+
+        free(varctrl->var);
+        varctrl->var = var;
+    }
+}
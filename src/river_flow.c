@@ -1,11 +1,12 @@
 #include "pihm.h"
 
-void RiverFlow(elem_struct elem[], river_struct river[])
+void RiverFlow(const rivnet_struct *rivnet, elem_struct elem[],
+    river_struct river[])
 {
     int             i;
 
 #if defined(_OPENMP)
-# pragma omp parallel for
+# pragma omp for schedule(static)
 #endif
     for (i = 0; i < nriver; i++)
     {
@@ -58,19 +59,20 @@ void RiverFlow(elem_struct elem[], river_struct river[])
 
     /*
      * Accumulate to get in-flow for down segments
-     * NOTE: Upstream flux summation must be calculated outside OMP to avoid
-     * different threads accessing the same variable at the same time
+     * NOTE: Each segment gathers the out-flows of its upstream segments, so
+     * that different threads do not write to the same variable
      */
+#if defined(_OPENMP)
+# pragma omp for schedule(static)
+#endif
     for (i = 0; i < nriver; i++)
     {
-        river_struct   *down;
+        int             k;
 
-        if (river[i].down > 0)
+        for (k = rivnet->up_ptr[i]; k < rivnet->up_ptr[i + 1]; k++)
         {
-            down = &river[river[i].down - 1];
-
-            down->wf.rivflow[UPSTREAM] -=
-                river[i].wf.rivflow[DOWNSTREAM];
+            river[i].wf.rivflow[UPSTREAM] -=
+                river[rivnet->up[k]].wf.rivflow[DOWNSTREAM];
         }
     }
 }
@@ -205,6 +207,67 @@ double OvlFlowElemToRiver(const river_struct *river_ptr, elem_struct *bank)
     return flux;
 }
 
+void DOvlFlowElemToRiver(const river_struct *river_ptr,
+    const elem_struct *bank, double dflux[])
+{
+    /*
+     * Derivatives of OvlFlowElemToRiver with respect to river stage
+     * (dflux[0]) and equivalent surface water of the bank element (dflux[1]).
+     * Head differences are limited to DEPRSTG when evaluating the square root
+     * terms, to avoid infinite derivatives when the weir starts to flow
+     */
+    double          z_bank;
+    double          bank_h;
+    double          river_h;
+    double          coeff;
+    double          dh;
+
+    z_bank = (river_ptr->topo.zmax > bank->topo.zmax) ?
+        river_ptr->topo.zmax : bank->topo.zmax;
+
+    bank_h = bank->topo.zmax + bank->ws.surfh;
+    river_h = river_ptr->topo.zbed + river_ptr->ws.stage;
+
+    coeff = river_ptr->matl.cwr * 2.0 * sqrt(2.0 * GRAV) *
+        river_ptr->shp.length / 3.0;
+
+    dflux[0] = 0.0;
+    dflux[1] = 0.0;
+
+    if (river_h > bank_h)
+    {
+        if (bank_h > z_bank)
+        {
+            /* Submerged weir */
+            dh = MAX(river_h - bank_h, DEPRSTG);
+            dflux[0] = coeff * (sqrt(dh) + 0.5 * (river_h - z_bank) / sqrt(dh));
+            dflux[1] = -coeff * 0.5 * (river_h - z_bank) / sqrt(dh);
+        }
+        else if (z_bank < river_h)
+        {
+            /* Free-flowing weir */
+            dflux[0] = 1.5 * coeff * sqrt(river_h - z_bank);
+        }
+    }
+    else if (bank->ws.surfh > DEPRSTG)
+    {
+        if (river_h > z_bank)
+        {
+            /* Submerged weir */
+            dh = MAX(bank_h - river_h, DEPRSTG);
+            dflux[0] = coeff * 0.5 * (bank_h - z_bank) / sqrt(dh);
+            dflux[1] = -coeff * (sqrt(dh) + 0.5 * (bank_h - z_bank) / sqrt(dh));
+        }
+        else if (z_bank < bank_h)
+        {
+            /* Free-flowing weir */
+            dflux[1] = -1.5 * coeff * sqrt(bank_h - z_bank);
+        }
+    }
+
+    dflux[1] *= DSurfH(bank->ws.surf);
+}
+
 double ChannelFlowRiverToRiver(const river_struct *river_ptr,
     const river_struct *down)
 {
@@ -232,8 +295,8 @@ double ChannelFlowRiverToRiver(const river_struct *river_ptr,
         down->shp.coeff);
 
     avg_perim = 0.5 * (perim + perim_down);
-    avg_rough = 0.5 * (river_ptr->matl.rough + down->matl.rough);
-    distance = 0.5 * (river_ptr->shp.length + down->shp.length);
+    avg_rough = river_ptr->matl.rough_down;
+    distance = river_ptr->topo.dist_down;
 
     diff_h = total_h - total_h_down;
     grad_h = diff_h / distance;
@@ -248,6 +311,87 @@ double ChannelFlowRiverToRiver(const river_struct *river_ptr,
     return OverLandFlow(avg_h, grad_h, avg_sf, crossa, avg_rough);
 }
 
+void DChannelFlowRiverToRiver(const river_struct *river_ptr,
+    const river_struct *down, double dflux[])
+{
+    /*
+     * Derivatives of ChannelFlowRiverToRiver with respect to the stage of the
+     * segment (dflux[0]) and of the downstream segment (dflux[1])
+     */
+    double          perim, perim_down;
+    double          crossa, crossa_down;
+    double          dperim, dperim_down;
+    double          dcrossa, dcrossa_down;
+    double          avg_perim;
+    double          avg_crossa;
+    double          avg_rough;
+    double          distance;
+    double          grad_h;
+    double          avg_h;
+    double          sgrad;
+    double          dsgrad;
+    double          dh_dstg, dh_dstg_down;
+
+    perim = RiverPerim(river_ptr->shp.intrpl_ord, river_ptr->ws.stage,
+        river_ptr->shp.coeff);
+    perim_down = RiverPerim(down->shp.intrpl_ord, down->ws.stage,
+        down->shp.coeff);
+    crossa = RiverCrossSectArea(river_ptr->shp.intrpl_ord, river_ptr->ws.stage,
+        river_ptr->shp.coeff);
+    crossa_down = RiverCrossSectArea(down->shp.intrpl_ord, down->ws.stage,
+        down->shp.coeff);
+    dperim = DRiverPerim(river_ptr->shp.intrpl_ord, river_ptr->ws.stage,
+        river_ptr->shp.coeff);
+    dperim_down = DRiverPerim(down->shp.intrpl_ord, down->ws.stage,
+        down->shp.coeff);
+    dcrossa = DRiverCrossSectArea(river_ptr->shp.intrpl_ord,
+        river_ptr->ws.stage, river_ptr->shp.coeff);
+    dcrossa_down = DRiverCrossSectArea(down->shp.intrpl_ord, down->ws.stage,
+        down->shp.coeff);
+
+    avg_perim = 0.5 * (perim + perim_down);
+    avg_crossa = 0.5 * (crossa + crossa_down);
+    avg_rough = river_ptr->matl.rough_down;
+    distance = river_ptr->topo.dist_down;
+
+    grad_h = ((river_ptr->ws.stage + river_ptr->topo.zbed) -
+        (down->ws.stage + down->topo.zbed)) / distance;
+
+    /* grad_h / sqrt(avg_sf) and its derivative with respect to grad_h */
+    if (grad_h > 0.0)
+    {
+        sgrad = sqrt(grad_h);
+        dsgrad = 0.5 / sqrt(MAX(grad_h, RIVGRADMIN));
+    }
+    else
+    {
+        sgrad = grad_h / sqrt(RIVGRADMIN);
+        dsgrad = 1.0 / sqrt(RIVGRADMIN);
+    }
+
+    dflux[0] = 0.0;
+    dflux[1] = 0.0;
+
+    if (avg_perim <= 0.0 || avg_crossa <= 0.0)
+    {
+        return;
+    }
+
+    avg_h = avg_crossa / avg_perim;
+    dh_dstg = 0.5 * (dcrossa * avg_perim - avg_crossa * dperim) /
+        (avg_perim * avg_perim);
+    dh_dstg_down = 0.5 * (dcrossa_down * avg_perim - avg_crossa * dperim_down) /
+        (avg_perim * avg_perim);
+
+    /* Flux = crossa * avg_h ^ (2 / 3) * sgrad / avg_rough */
+    dflux[0] = (dcrossa * pow(avg_h, 2.0 / 3.0) * sgrad +
+        crossa * 2.0 / 3.0 * pow(avg_h, -1.0 / 3.0) * dh_dstg * sgrad +
+        crossa * pow(avg_h, 2.0 / 3.0) * dsgrad / distance) / avg_rough;
+    dflux[1] = (crossa * 2.0 / 3.0 * pow(avg_h, -1.0 / 3.0) * dh_dstg_down *
+        sgrad - crossa * pow(avg_h, 2.0 / 3.0) * dsgrad / distance) /
+        avg_rough;
+}
+
 double OutletFlux(int down, const river_topo_struct *topo,
     const shp_struct *shp, const matl_struct *matl, const river_bc_struct *bc,
     const river_wstate_struct *ws)
@@ -389,6 +533,52 @@ double ChannelFlowElemToRiver(double effk, double distance,
     return flux;
 }
 
+void DChannelFlowElemToRiver(double effk, double deffk, double distance,
+    const river_struct *river_ptr, const elem_struct *bank, double dflux[])
+{
+    /*
+     * Derivatives of ChannelFlowElemToRiver with respect to river stage
+     * (dflux[0]) and groundwater storage of the bank element (dflux[1]). deffk
+     * is the derivative of effk with respect to groundwater storage
+     */
+    double          diff_h;
+    double          h_bank;
+    double          dh_bank;
+    double          avg_h;
+    double          grad_h;
+    double          avg_ksat;
+
+    diff_h = (river_ptr->ws.stage + river_ptr->topo.zbed) -
+        (bank->ws.gw + bank->topo.zmin);
+
+    if (bank->topo.zmin > river_ptr->topo.zbed)
+    {
+        h_bank = bank->ws.gw;
+        dh_bank = 1.0;
+    }
+    else if (bank->topo.zmin + bank->ws.gw > river_ptr->topo.zbed)
+    {
+        h_bank = bank->topo.zmin + bank->ws.gw - river_ptr->topo.zbed;
+        dh_bank = 1.0;
+    }
+    else
+    {
+        h_bank = 0.0;
+        dh_bank = 0.0;
+    }
+    avg_h = AvgH(diff_h, river_ptr->ws.stage, h_bank);
+
+    grad_h = diff_h / distance;
+
+    avg_ksat = 0.5 * (effk + river_ptr->matl.ksath);
+
+    dflux[0] = river_ptr->shp.length * avg_ksat * (avg_h / distance +
+        ((diff_h > 0.0 && river_ptr->ws.stage > 0.0) ? grad_h : 0.0));
+    dflux[1] = river_ptr->shp.length * (0.5 * deffk * grad_h * avg_h -
+        avg_ksat * avg_h / distance +
+        ((diff_h <= 0.0 && h_bank > 0.0) ? avg_ksat * grad_h * dh_bank : 0.0));
+}
+
 double RiverCrossSectArea(int order, double depth, double coeff)
 {
     double          cs_area = 0.0;
@@ -453,3 +643,71 @@ double RiverPerim(int order, double depth, double coeff)
 
     return perim;
 }
+
+double DRiverCrossSectArea(int order, double depth, double coeff)
+{
+    /* Derivative of cross section area with respect to river depth, i.e., the
+     * width of water surface */
+    double          dcs_area = 0.0;
+
+    if (depth <= 0.0)
+    {
+        return 0.0;
+    }
+
+    switch (order)
+    {
+        case RECTANGLE:
+            dcs_area = coeff;
+            break;
+        case TRIANGLE:
+            dcs_area = 2.0 * depth / coeff;
+            break;
+        case QUADRATIC:
+            dcs_area = 2.0 * sqrt(depth) / sqrt(coeff);
+            break;
+        case CUBIC:
+            dcs_area = 2.0 * pow(depth, 1.0 / 3.0) / pow(coeff, 1.0 / 3.0);
+            break;
+        default:
+            pihm_printf(VL_ERROR, "Error: River order %d is not defined.\n",
+                order);
+            pihm_exit(EXIT_FAILURE);
+    }
+
+    return dcs_area;
+}
+
+double DRiverPerim(int order, double depth, double coeff)
+{
+    /* Derivative of wetted perimeter with respect to river depth */
+    double          dperim = 0.0;
+
+    if (depth <= 0.0)
+    {
+        return 0.0;
+    }
+
+    switch (order)
+    {
+        case RECTANGLE:
+            dperim = 2.0;
+            break;
+        case TRIANGLE:
+            dperim = 2.0 * sqrt(1.0 + coeff * coeff) / coeff;
+            break;
+        case QUADRATIC:
+            dperim = sqrt((1.0 + 4.0 * coeff * depth) / (coeff * depth));
+            break;
+        case CUBIC:
+            dperim = 2.0 * sqrt(1.0 + 9.0 * pow(coeff, 2.0 / 3.0) * depth) /
+                (3.0 * sqrt(depth));
+            break;
+        default:
+            pihm_printf(VL_ERROR, "Error: River order %d is not defined.\n",
+                order);
+            pihm_exit(EXIT_FAILURE);
+    }
+
+    return dperim;
+}
@@ -9,7 +9,7 @@ void SoluteConc(const chemtbl_struct chemtbl[], const rttbl_struct *rttbl,
      * Calculate chemical concentrations
      */
 #if defined(_OPENMP)
-# pragma omp parallel for
+# pragma omp for schedule(static) nowait
 #endif
     for (i = 0; i < nelem; i++)
     {
@@ -75,7 +75,7 @@ void SoluteConc(const chemtbl_struct chemtbl[], const rttbl_struct *rttbl,
     }
 
 #if defined(_OPENMP)
-# pragma omp parallel for
+# pragma omp for schedule(static)
 #endif
     for (i = 0; i < nriver; i++)
     {
@@ -4,20 +4,31 @@
 #define SKIP_JACOB 1
 
 void Reaction(double stepsize, const chemtbl_struct chemtbl[],
-    const kintbl_struct kintbl[], const rttbl_struct *rttbl, elem_struct elem[])
+    const kintbl_struct kintbl[], const rttbl_struct *rttbl,
+    scratch_struct scratch[], sched_struct *sched, elem_struct elem[])
 {
-    int             i;
+    int             n;
 
+    /* Elements are visited in the order of the cost-aware schedule, because
+     * the number of Newton iterations varies much among elements */
 #if defined(_OPENMP)
-# pragma omp parallel for
+# pragma omp parallel for schedule(dynamic, 1)
 #endif
-    for (i = 0; i < nelem; i++)
+    for (n = 0; n < nelem; n++)
     {
         double          storage;
         double          satn;
         double          ftemp;
+        double          start;
+        realtype      **jcb;
+        int             i;
         int             k;
 
+        i = sched->order[n];
+        start = WallClock();
+
+        jcb = ThreadScratch(scratch)->jcb;
+
         storage = (elem[i].ws.unsat + elem[i].ws.gw) * elem[i].soil.porosity +
             elem[i].soil.depth * elem[i].soil.smcmin;
 
@@ -43,7 +54,7 @@ void Reaction(double stepsize, const chemtbl_struct chemtbl[],
 
             ftemp = SoilTempFactor(avg_stc);
 
-            ReactControl(chemtbl, kintbl, rttbl, stepsize, satn, ftemp,
+            ReactControl(chemtbl, kintbl, rttbl, stepsize, satn, ftemp, jcb,
                 &elem[i].chms, elem[i].chmf.react);
         }
 
@@ -71,7 +82,7 @@ void Reaction(double stepsize, const chemtbl_struct chemtbl[],
         if (satn > 1.0E-2)
         {
             ftemp = SoilTempFactor(elem[i].ps.tbot);
-            ReactControl(chemtbl, kintbl, rttbl, stepsize, satn, ftemp,
+            ReactControl(chemtbl, kintbl, rttbl, stepsize, satn, ftemp, jcb,
                 &elem[i].chms_geol, elem[i].chmf.react_geol);
         }
 
@@ -81,12 +92,14 @@ void Reaction(double stepsize, const chemtbl_struct chemtbl[],
                 storage;
         }
 #endif
+
+        SchedRecord(i, start, sched);
     }
 }
 
 int _React(double stepsize, const chemtbl_struct chemtbl[],
     const kintbl_struct kintbl[], const rttbl_struct *rttbl, double satn,
-    double ftemp, chmstate_struct *chms)
+    double ftemp, realtype **jcb, chmstate_struct *chms)
 {
     int             i, j, k;
     int             control;
@@ -122,7 +135,6 @@ int _React(double stepsize, const chemtbl_struct chemtbl[],
     double          surf_ratio;
     double          tot_cec;
     double          tmpprb_inv;
-    realtype      **jcb;
     sunindextype    p[MAXSPS];
     realtype        x_[MAXSPS];
 
@@ -237,9 +249,6 @@ int _React(double stepsize, const chemtbl_struct chemtbl[],
         }
     }
 
-    jcb = newDenseMat(rttbl->num_stc - rttbl->num_min,
-        rttbl->num_stc - rttbl->num_min);
-
     if (rttbl->tmp_coup == 0)
     {
         for (i = 0; i < rttbl->num_ssc; i++)
@@ -472,8 +481,6 @@ int _React(double stepsize, const chemtbl_struct chemtbl[],
         }
     }
 
-    destroyMat(jcb);
-
     for (i = 0; i < rttbl->num_ssc; i++)
     {
         tmpval = 0.0;
@@ -528,7 +535,7 @@ int _React(double stepsize, const chemtbl_struct chemtbl[],
 
 void ReactControl(const chemtbl_struct chemtbl[], const kintbl_struct kintbl[],
     const rttbl_struct *rttbl, double stepsize, double satn, double ftemp,
-    chmstate_struct *chms, double react_flux[])
+    realtype **jcb, chmstate_struct *chms, double react_flux[])
 {
     double          t_conc0[MAXSPS];
     double          substep;
@@ -545,7 +552,8 @@ void ReactControl(const chemtbl_struct chemtbl[], const kintbl_struct kintbl[],
 
     while (1.0 - step_counter / stepsize > 1.0E-10 && substep > 30.0)
     {
-        flag = _React(substep, chemtbl, kintbl, rttbl, satn, ftemp, chms);
+        flag = _React(substep, chemtbl, kintbl, rttbl, satn, ftemp, jcb,
+            chms);
 
         if (flag == 0)
         {
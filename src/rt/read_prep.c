@@ -17,6 +17,16 @@ void ReadPrep(const char fn[], const chemtbl_struct chemtbl[],
     char            cmdstr[MAXSTRING];
     char            tempstr[2][MAXSTRING];
 
+    if (MapForcing(fn, rttbl->num_spc, &forc->nprcpc, &forc->prcpc, forc))
+    {
+        for (i = 0; i < forc->nprcpc; i++)
+        {
+            forc->prcpc[i].value =
+                (double *)malloc(rttbl->num_spc * sizeof(double));
+        }
+        return;
+    }
+
     fp = pihm_fopen(fn, "r");
     pihm_printf(VL_VERBOSE, " Reading %s\n", fn);
 
@@ -98,10 +108,7 @@ void ReadPrep(const char fn[], const chemtbl_struct chemtbl[],
                 }
             }
 
-            forc->prcpc[i].ftime =
-                (int *)malloc((forc->prcpc[i].length) * sizeof(int));
-            forc->prcpc[i].data =
-                (double **)malloc((forc->prcpc[i].length) * sizeof(double *));
+            NewTs(forc->prcpc[i].length, rttbl->num_spc, &forc->prcpc[i]);
             forc->prcpc[i].value =
                 (double *)malloc(rttbl->num_spc * sizeof(double));
 
@@ -109,9 +116,6 @@ void ReadPrep(const char fn[], const chemtbl_struct chemtbl[],
             {
                 int             k, kk;
 
-                forc->prcpc[i].data[j] =
-                    (double *)malloc(rttbl->num_spc * sizeof(double));
-
                 NextLine(fp, cmdstr, &lno);
                 if (!ReadTs(cmdstr, nsps[i], &forc->prcpc[i].ftime[j],
                     temp_conc))
@@ -123,7 +127,7 @@ void ReadPrep(const char fn[], const chemtbl_struct chemtbl[],
                 {
                     /* Species not described in the forcing file will be filled
                      * with the concentrations in .chem file */
-                    forc->prcpc[i].data[j][k] = rttbl->prcp_conc[k];
+                    forc->prcpc[i].data[k][j] = rttbl->prcp_conc[k];
 
                     for (kk = 0; kk < nsps[i]; kk++)
                     {
@@ -132,14 +136,14 @@ void ReadPrep(const char fn[], const chemtbl_struct chemtbl[],
                             if (strcmp(chemtbl[k].name, "pH") == 0)
                             {
                                 /* Convert pH to H+ concentration */
-                                forc->prcpc[i].data[j][k] =
+                                forc->prcpc[i].data[k][j] =
                                     (temp_conc[kk] < 7.0) ?
                                     pow(10, -temp_conc[kk]) :
                                     -pow(10, -temp_conc[kk] - 14);
                             }
                             else
                             {
-                                forc->prcpc[i].data[j][k] = temp_conc[kk];
+                                forc->prcpc[i].data[k][j] = temp_conc[kk];
                             }
                             break;
                         }
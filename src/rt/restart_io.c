@@ -6,6 +6,7 @@ void WriteRtIc(const char *outputdir, const chemtbl_struct chemtbl[],
     int             i;
     FILE           *fp;
     char            fn[MAXSTRING];
+    rtic_struct     restart_output[NCHMVOL];
 
     sprintf(fn, "%s/restart/%s.rtic", outputdir, project);
 
@@ -16,9 +17,12 @@ void WriteRtIc(const char *outputdir, const chemtbl_struct chemtbl[],
     {
         int             j, k;
 
-        for (k = 0; k < MAXSPS; k++)
+        /* Records keep MAXSPS species. Unused species are zero */
+        memset(restart_output, 0, sizeof(restart_output));
+
+        for (k = 0; k < rttbl->num_stc; k++)
         {
-            if (k < rttbl->num_stc && chemtbl[k].itype == MINERAL)
+            if (chemtbl[k].itype == MINERAL)
             {
                 elem[i].chms.tot_conc[k] /= (rttbl->rel_min == 0) ?
                     1000.0 / chemtbl[k].molar_vol / elem[i].soil.smcmax :
@@ -31,8 +35,8 @@ void WriteRtIc(const char *outputdir, const chemtbl_struct chemtbl[],
                     chemtbl[k].molar_vol / elem[i].geol.smcmax;
 #endif
             }
-            else if (k < rttbl->num_stc && (chemtbl[k].itype == CATION_ECHG ||
-                chemtbl[k].itype == ADSORPTION))
+            else if (chemtbl[k].itype == CATION_ECHG ||
+                chemtbl[k].itype == ADSORPTION)
             {
                 elem[i].chms.tot_conc[k] /=
                     (1.0 - elem[i].soil.smcmax) * 2650.0;
@@ -42,29 +46,29 @@ void WriteRtIc(const char *outputdir, const chemtbl_struct chemtbl[],
 #endif
             }
 
-            elem[i].restart_output[SOIL_CHMVOL].tot_conc[k] =
-                elem[i].chms.tot_conc[k];
-            elem[i].restart_output[SOIL_CHMVOL].ssa[k] =
-                elem[i].chms.ssa[k];
+            restart_output[SOIL_CHMVOL].tot_conc[k] = elem[i].chms.tot_conc[k];
+            restart_output[SOIL_CHMVOL].ssa[k] = elem[i].chms.ssa[k];
 
 #if defined(_DGW_)
-            elem[i].restart_output[GEOL_CHMVOL].tot_conc[k] =
+            restart_output[GEOL_CHMVOL].tot_conc[k] =
                 elem[i].chms_geol.tot_conc[k];
-            elem[i].restart_output[GEOL_CHMVOL].ssa[k] =
-                elem[i].chms_geol.ssa[k];
+            restart_output[GEOL_CHMVOL].ssa[k] = elem[i].chms_geol.ssa[k];
 #endif
         }
 
+        /* Records are written in the order of element IDs */
+        fseek(fp, (long)(elem[i].id - 1) * NCHMVOL * (long)sizeof(rtic_struct),
+            SEEK_SET);
         for (j = 0; j < NCHMVOL; j++)
         {
-            fwrite(&(elem[i].restart_output[j]), sizeof(rtic_struct), 1, fp);
+            fwrite(&restart_output[j], sizeof(rtic_struct), 1, fp);
         }
     }
 
     fclose(fp);
 }
 
-void ReadRtIc(const char *fn, elem_struct elem[])
+void ReadRtIc(const char *fn, const elem_struct elem[], rtic_struct rtic[])
 {
     FILE           *fp;
     int             i;
@@ -76,9 +80,12 @@ void ReadRtIc(const char *fn, elem_struct elem[])
     {
         int             j;
 
+        /* Records are stored in the order of element IDs */
+        fseek(fp, (long)(elem[i].id - 1) * NCHMVOL * (long)sizeof(rtic_struct),
+            SEEK_SET);
         for (j = 0; j < NCHMVOL; j++)
         {
-            fread(&elem[i].restart_input[j], sizeof(rtic_struct), 1, fp);
+            fread(&rtic[NCHMVOL * i + j], sizeof(rtic_struct), 1, fp);
         }
     }
 
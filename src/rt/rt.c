@@ -8,7 +8,8 @@
 
 void InitChem(const char fn[], const calib_struct *calib,
     forc_struct *forc, chemtbl_struct chemtbl[], kintbl_struct kintbl[],
-    rttbl_struct *rttbl, chmictbl_struct *chmictbl, elem_struct elem[])
+    rttbl_struct *rttbl, chmictbl_struct *chmictbl, const elem_struct elem[],
+    rtic_struct rtic[])
 {
     int             i, j;
     int             chem_ind;
@@ -43,29 +44,140 @@ void InitChem(const char fn[], const calib_struct *calib,
     for (i = 0; i < nelem; i++)
     {
         int             k;
-        int            *ic_type;
+        const int      *ic_type;
 
         ic_type = elem[i].attrib.chem_ic;
 
         for (k = 0; k < rttbl->num_stc; k++)
         {
-            elem[i].restart_input[SOIL_CHMVOL].tot_conc[k] =
+            rtic[NCHMVOL * i + SOIL_CHMVOL].tot_conc[k] =
                 chmictbl->conc[ic_type[SOIL_CHMVOL] - 1][k];
-            elem[i].restart_input[SOIL_CHMVOL].ssa[k] =
+            rtic[NCHMVOL * i + SOIL_CHMVOL].ssa[k] =
                 chmictbl->ssa[ic_type[SOIL_CHMVOL] - 1][k];
 
 #if defined(_DGW_)
-            elem[i].restart_input[GEOL_CHMVOL].tot_conc[k] =
+            rtic[NCHMVOL * i + GEOL_CHMVOL].tot_conc[k] =
                 chmictbl->conc[ic_type[GEOL_CHMVOL] - 1][k];
-            elem[i].restart_input[GEOL_CHMVOL].ssa[k] =
+            rtic[NCHMVOL * i + GEOL_CHMVOL].ssa[k] =
                 chmictbl->ssa[ic_type[GEOL_CHMVOL] - 1][k];
 #endif
         }
     }
 }
 
+void InitChmPool(const rttbl_struct *rttbl, elem_struct elem[],
+    river_struct river[], chmpool_struct *chmpool)
+{
+    /*
+     * Species arrays of all elements and river segments are sized to the
+     * number of species of the simulation, and carved from one block of
+     * doubles so that they do not add an allocation each
+     */
+    int             i;
+    double         *ptr;
+
+    chmpool->conc = (double *)malloc(((size_t)nelem * ElemChmSize(rttbl) +
+        (size_t)nriver * ChmStateSize(rttbl)) * sizeof(double));
+    chmpool->solute = (solute_struct *)malloc(nelem * nsolute *
+        sizeof(solute_struct));
+    chmpool->river_solute = (river_solute_struct *)malloc(nriver * nsolute *
+        sizeof(river_solute_struct));
+
+    ptr = chmpool->conc;
+
+    for (i = 0; i < nelem; i++)
+    {
+        int             j;
+
+        elem[i].solute = &chmpool->solute[nsolute * i];
+
+        elem[i].prcpchm.tot_conc = ptr;
+        ptr += rttbl->num_spc;
+
+        ptr = CarveChmState(rttbl, ptr, &elem[i].chms);
+
+        elem[i].chmf.react = ptr;
+        ptr += rttbl->num_spc;
+
+        for (j = 0; j < NUM_EDGE; j++)
+        {
+            elem[i].bc.conc[j] = ptr;
+            ptr += rttbl->num_stc;
+        }
+
+#if defined(_DGW_)
+        ptr = CarveChmState(rttbl, ptr, &elem[i].chms_geol);
+
+        elem[i].chmf.react_geol = ptr;
+        ptr += rttbl->num_spc;
+
+        for (j = 0; j < NUM_EDGE; j++)
+        {
+            elem[i].bc_geol.conc[j] = ptr;
+            ptr += rttbl->num_stc;
+        }
+#endif
+    }
+
+    for (i = 0; i < nriver; i++)
+    {
+        river[i].solute = &chmpool->river_solute[nsolute * i];
+
+        ptr = CarveChmState(rttbl, ptr, &river[i].chms);
+    }
+}
+
+int ChmStateSize(const rttbl_struct *rttbl)
+{
+    /* Number of doubles of the arrays of a chemical state */
+    return 5 * rttbl->num_stc + rttbl->num_ssc;
+}
+
+int ElemChmSize(const rttbl_struct *rttbl)
+{
+    /* Number of doubles of the species arrays of an element */
+    int             size;
+
+    size = ChmStateSize(rttbl) + 2 * rttbl->num_spc +
+        NUM_EDGE * rttbl->num_stc;
+#if defined(_DGW_)
+    size += ChmStateSize(rttbl) + rttbl->num_spc + NUM_EDGE * rttbl->num_stc;
+#endif
+
+    return size;
+}
+
+double *CarveChmState(const rttbl_struct *rttbl, double *ptr,
+    chmstate_struct *chms)
+{
+    /* Point the arrays of chms into the block at ptr, and return the end of
+     * the arrays */
+    chms->tot_conc = ptr;
+    ptr += rttbl->num_stc;
+    chms->prim_conc = ptr;
+    ptr += rttbl->num_stc;
+    chms->prim_actv = ptr;
+    ptr += rttbl->num_stc;
+    chms->ssa = ptr;
+    ptr += rttbl->num_stc;
+    chms->tot_mol = ptr;
+    ptr += rttbl->num_stc;
+    chms->sec_conc = ptr;
+    ptr += rttbl->num_ssc;
+
+    return ptr;
+}
+
+void FreeChmPool(chmpool_struct *chmpool)
+{
+    free(chmpool->conc);
+    free(chmpool->solute);
+    free(chmpool->river_solute);
+}
+
 void InitRTVar(const chemtbl_struct chemtbl[], const rttbl_struct *rttbl,
-    elem_struct elem[], river_struct river[], N_Vector CV_Y)
+    const rtic_struct rtic[], scratch_struct scratch[], elem_struct elem[],
+    river_struct river[], N_Vector CV_Y)
 {
     int             i;
 
@@ -81,15 +193,17 @@ void InitRTVar(const chemtbl_struct chemtbl[], const rttbl_struct *rttbl,
         storage = (elem[i].ws.unsat + elem[i].ws.gw) * elem[i].soil.porosity +
             elem[i].soil.depth * elem[i].soil.smcmin;
 
-        InitChemS(chemtbl, rttbl, &elem[i].restart_input[SOIL_CHMVOL],
-            elem[i].soil.smcmax, storage, &elem[i].chms);
+        InitChemS(chemtbl, rttbl, &rtic[NCHMVOL * i + SOIL_CHMVOL],
+            elem[i].soil.smcmax, storage, ThreadScratch(scratch)->jcb,
+            &elem[i].chms);
 
 #if defined(_DGW_)
         storage = (elem[i].ws.unsat_geol + elem[i].ws.gw_geol) *
             elem[i].geol.porosity + elem[i].geol.depth * elem[i].geol.smcmin;
 
-        InitChemS(chemtbl, rttbl, &elem[i].restart_input[GEOL_CHMVOL],
-            elem[i].geol.smcmax, storage, &elem[i].chms_geol);
+        InitChemS(chemtbl, rttbl, &rtic[NCHMVOL * i + GEOL_CHMVOL],
+            elem[i].geol.smcmax, storage, ThreadScratch(scratch)->jcb,
+            &elem[i].chms_geol);
 #endif
     }
 
@@ -166,7 +280,7 @@ void InitRTVar(const chemtbl_struct chemtbl[], const rttbl_struct *rttbl,
 
 void InitChemS(const chemtbl_struct chemtbl[], const rttbl_struct *rttbl,
     const rtic_struct *restart_input, double smcmax, double vol,
-    chmstate_struct *chms)
+    realtype **jcb, chmstate_struct *chms)
 {
     int             k;
 
@@ -220,7 +334,7 @@ void InitChemS(const chemtbl_struct chemtbl[], const rttbl_struct *rttbl,
     /* Speciation */
     if (rttbl->transpt_flag == KIN_REACTION)
     {
-        _Speciation(chemtbl, rttbl, 1, chms);
+        _Speciation(chemtbl, rttbl, 1, jcb, chms);
     }
 
     /* Total moles should be calculated after speciation */
@@ -3,7 +3,7 @@
 #define TOL        1E-7
 
 void Speciation(const chemtbl_struct chemtbl[], const rttbl_struct *rttbl,
-    river_struct river[])
+    scratch_struct scratch[], river_struct river[])
 {
     int             i;
 
@@ -21,13 +21,14 @@ void Speciation(const chemtbl_struct chemtbl[], const rttbl_struct *rttbl,
 
         if (river[i].ws.stage > DEPTHR)
         {
-            _Speciation(chemtbl, rttbl, 0, &river[i].chms);
+            _Speciation(chemtbl, rttbl, 0, ThreadScratch(scratch)->jcb,
+                &river[i].chms);
         }
     }
 }
 
 int _Speciation(const chemtbl_struct chemtbl[], const rttbl_struct *rttbl,
-    int speciation_flg, chmstate_struct *chms)
+    int speciation_flg, realtype **jcb, chmstate_struct *chms)
 {
     /* if speciation flg = 1, pH is defined
      * if speciation flg = 0, all defined value is total concentration */
@@ -48,7 +49,6 @@ int _Speciation(const chemtbl_struct chemtbl[], const rttbl_struct *rttbl,
     double          adh;
     double          bdh;
     double          bdt;
-    realtype      **jcb;
 
     for (k = 0; k < MAXSPS; k++)
     {
@@ -102,7 +102,6 @@ int _Speciation(const chemtbl_struct chemtbl[], const rttbl_struct *rttbl,
         /* pH is defined, total concentration is calculated from the activity of
          * H. Dependency is the same but the total concentration for H need not
          * be solved */
-        jcb = newDenseMat(rttbl->num_stc - 1, rttbl->num_stc - 1);
         sunindextype    p[MAXSPS];
         realtype        x_[MAXSPS];
         double          maxerror = 1;
@@ -236,7 +235,6 @@ int _Speciation(const chemtbl_struct chemtbl[], const rttbl_struct *rttbl,
     }
     else
     {
-        jcb = newDenseMat(rttbl->num_stc, rttbl->num_stc);
         sunindextype    p[MAXSPS];
         realtype        x_[MAXSPS];
         double          maxerror = 1;
@@ -378,7 +376,6 @@ int _Speciation(const chemtbl_struct chemtbl[], const rttbl_struct *rttbl,
 #endif
         }
     }
-    destroyMat(jcb);
 
     return (0);
 }
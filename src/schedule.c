@@ -0,0 +1,88 @@
+#include "pihm.h"
+
+int NextStep(pihm_struct pihm)
+{
+    /*
+     * Index of the model step the time loop advances to. Without the event
+     * scheduler, every model step is visited. Otherwise the time loop advances
+     * straight to the next event: a land surface step, a boundary condition
+     * forcing time, a module step, an output or restart time, or the end of
+     * simulation. While any boundary condition changes, every model step is
+     * an event (see NextBreakpoint)
+     */
+    const ctrl_struct *ctrl;
+    int             t;
+    int             tevent;
+    int             step;
+    int             i;
+
+    ctrl = &pihm->ctrl;
+
+    if (!ctrl->schedule)
+    {
+        return ctrl->cstep + 1;
+    }
+
+    t = ctrl->tout[ctrl->cstep];
+
+    /* Forcing, land surface steps, and end of simulation */
+    tevent = NextBreakpoint(t, ctrl, &pihm->forc);
+
+    /* Output and restart times */
+    for (i = 0; i < pihm->print.nprint; i++)
+    {
+        tevent = NextPrintTime(t, tevent, pihm->print.varctrl[i].intvl,
+            ctrl->starttime);
+    }
+
+    if (ctrl->write_ic)
+    {
+        tevent = NextPrintTime(t, tevent, ctrl->prtvrbl[IC_CTRL],
+            ctrl->starttime);
+    }
+
+#if defined(_RT_)
+    /* Reaction and speciation steps */
+    if (pihm->rttbl.transpt_flag == KIN_REACTION)
+    {
+        tevent = NextPrintTime(t, tevent, ctrl->AvgScl, ctrl->starttime);
+        tevent = NextPrintTime(t, tevent, SPECIATION_STEP, ctrl->starttime);
+    }
+#endif
+
+#if defined(_CYCLES_)
+    /* Daily crop step */
+    tevent = NextPrintTime(t, tevent, DAYINSEC, ctrl->starttime);
+#endif
+
+    /* Events are applied at model steps */
+    step = (tevent - ctrl->starttime + ctrl->stepsize - 1) / ctrl->stepsize;
+
+    return MAX(MIN(step, ctrl->nstep), ctrl->cstep + 1);
+}
+
+int NextPrintTime(int t, int tevent, int intvl, int starttime)
+{
+    /*
+     * Earlier of tevent and the first time after t that matches an output
+     * interval. Monthly and yearly outputs are checked at every day
+     */
+    int             tnext;
+
+    switch (intvl)
+    {
+        case YEARLY_OUTPUT:
+        case MONTHLY_OUTPUT:
+        case DAILY_OUTPUT:
+            tnext = (t / DAYINSEC + 1) * DAYINSEC;
+            break;
+        case HOURLY_OUTPUT:
+            tnext = (t / 3600 + 1) * 3600;
+            break;
+        default:
+            tnext = (intvl > 0) ?
+                starttime + ((t - starttime) / intvl + 1) * intvl : tevent;
+    }
+
+    return MIN(tevent, tnext);
+}
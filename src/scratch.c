@@ -0,0 +1,90 @@
+#include "pihm.h"
+
+#if defined(_RT_)
+scratch_struct *NewScratch(const rttbl_struct *rttbl)
+#else
+scratch_struct *NewScratch(void)
+#endif
+{
+    /*
+     * Allocate one scratch arena for each OpenMP thread. Whole-domain
+     * temporaries are borrowed from the arena of the master thread, outside of
+     * parallel regions or by a single thread of a region, so only that arena
+     * holds a work array sized from the number of elements. Chemistry solvers
+     * borrow a dense Jacobian sized from the number of primary species from
+     * the arena of their own thread
+     */
+    scratch_struct *scratch;
+    int             tid;
+
+    scratch = (scratch_struct *)malloc(nthreads * sizeof(scratch_struct));
+
+    for (tid = 0; tid < nthreads; tid++)
+    {
+        /* LateralFlow borrows three arrays of nelem. DailyBgc borrows one
+         * array of nelem + 1 */
+        scratch[tid].size = (tid == 0) ? 3 * (size_t)(nelem + 1) : 0;
+        scratch[tid].buffer = (scratch[tid].size > 0) ?
+            (double *)malloc(scratch[tid].size * sizeof(double)) : NULL;
+        scratch[tid].top = 0;
+
+#if defined(_RT_)
+        scratch[tid].jcb = newDenseMat(rttbl->num_stc, rttbl->num_stc);
+#endif
+    }
+
+    return scratch;
+}
+
+void FreeScratch(scratch_struct scratch[])
+{
+    int             tid;
+
+    for (tid = 0; tid < nthreads; tid++)
+    {
+        free(scratch[tid].buffer);
+#if defined(_RT_)
+        destroyMat(scratch[tid].jcb);
+#endif
+    }
+
+    free(scratch);
+}
+
+scratch_struct *ThreadScratch(scratch_struct scratch[])
+{
+#if defined(_OPENMP)
+    return &scratch[omp_get_thread_num()];
+#else
+    return &scratch[0];
+#endif
+}
+
+double *ScratchAlloc(size_t n, scratch_struct *scratch)
+{
+    /*
+     * Borrow n doubles from the arena. Borrowed arrays are released in
+     * reverse order with ScratchRelease
+     */
+    double         *ptr;
+
+    if (scratch->top + n > scratch->size)
+    {
+        pihm_printf(VL_ERROR,
+            "Error: Scratch arena is too small (%lu of %lu doubles in use, "
+            "%lu requested).\n", (unsigned long)scratch->top,
+            (unsigned long)scratch->size, (unsigned long)n);
+        pihm_exit(EXIT_FAILURE);
+    }
+
+    ptr = scratch->buffer + scratch->top;
+    scratch->top += n;
+
+    return ptr;
+}
+
+void ScratchRelease(const double *ptr, scratch_struct *scratch)
+{
+    /* Release ptr and everything borrowed after it */
+    scratch->top = (size_t)(ptr - scratch->buffer);
+}
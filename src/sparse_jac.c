@@ -0,0 +1,413 @@
+#include "pihm.h"
+
+SUNMatrix SparseJacPattern(int type, const elem_struct elem[],
+    const river_struct river[], const rivnet_struct *rivnet)
+{
+    /*
+     * Build the CSR sparsity pattern of the hydrologic Jacobian from element
+     * and river adjacency. Each element is coupled to its vertical layers,
+     * its neighbors and its adjacent river segments. Each river segment is
+     * coupled to its upstream and downstream segments and its bank elements.
+     * Diagonal entries are always included. The colored finite difference
+     * Jacobian uses the wider dependency pattern of the RHS function
+     */
+    SUNMatrix       jac;
+    sunindextype    n;
+    sunindextype    nnz;
+    sunindextype    row;
+    sunindextype   *cols;
+    sunindextype   *ptr;
+    sunindextype   *ind;
+    int             ncol;
+    int             k;
+
+    n = NumStateVar();
+    cols = (sunindextype *)malloc(n * sizeof(sunindextype));
+
+    /* Count non-zeros */
+    nnz = 0;
+    for (row = 0; row < n; row++)
+    {
+        nnz += (type == COLOR_FD_JAC) ?
+            ColorRowPattern(row, elem, river, rivnet, cols) :
+            SparseRowPattern(row, elem, river, rivnet, cols);
+    }
+
+    jac = SUNSparseMatrix(n, n, nnz, CSR_MAT);
+
+    ptr = SUNSparseMatrix_IndexPointers(jac);
+    ind = SUNSparseMatrix_IndexValues(jac);
+
+    ptr[0] = 0;
+    for (row = 0; row < n; row++)
+    {
+        ncol = (type == COLOR_FD_JAC) ?
+            ColorRowPattern(row, elem, river, rivnet, cols) :
+            SparseRowPattern(row, elem, river, rivnet, cols);
+
+        for (k = 0; k < ncol; k++)
+        {
+            ind[ptr[row] + k] = cols[k];
+        }
+
+        ptr[row + 1] = ptr[row] + ncol;
+    }
+
+    for (k = 0; k < nnz; k++)
+    {
+        SUNSparseMatrix_Data(jac)[k] = 0.0;
+    }
+
+    free(cols);
+
+    pihm_printf(VL_VERBOSE, "Sparse Jacobian: %ld non-zeros.\n",
+        (long int)nnz);
+
+    return jac;
+}
+
+int SparseRowPattern(sunindextype row, const elem_struct elem[],
+    const river_struct river[], const rivnet_struct *rivnet,
+    sunindextype cols[])
+{
+    /*
+     * Column indices of the non-zeros in one row of the Jacobian, sorted and
+     * without duplicates. Returns the number of non-zeros
+     */
+    int             ncol = 0;
+    int             i;
+    int             j;
+    int             k;
+
+    if (row < 3 * nelem
+#if defined(_DGW_)
+        || row >= 3 * nelem + nriver
+#endif
+        )
+    {
+        int             layer;
+
+#if defined(_DGW_)
+        if (row >= 3 * nelem + nriver)
+        {
+            i = (row - 3 * nelem - nriver) % nelem;
+            layer = 3 + (row - 3 * nelem - nriver) / nelem;
+        }
+        else
+#endif
+        {
+            i = row % nelem;
+            layer = row / nelem;
+        }
+
+        /* Vertical coupling */
+        cols[ncol++] = SURF(i);
+        cols[ncol++] = UNSAT(i);
+        cols[ncol++] = GW(i);
+#if defined(_DGW_)
+        cols[ncol++] = UNSAT_GEOL(i);
+        cols[ncol++] = GW_GEOL(i);
+#endif
+
+        /* Lateral coupling */
+        for (j = 0; j < NUM_EDGE; j++)
+        {
+            if (layer == 0)
+            {
+                if (elem[i].nabr_river[j] > 0)
+                {
+                    cols[ncol++] = RIVER(elem[i].nabr_river[j] - 1);
+                }
+                else if (elem[i].nabr[j] > 0)
+                {
+                    cols[ncol++] = SURF(elem[i].nabr[j] - 1);
+                }
+            }
+            else if (layer == 2)
+            {
+                if (elem[i].nabr[j] > 0)
+                {
+                    cols[ncol++] = GW(elem[i].nabr[j] - 1);
+                }
+                if (elem[i].nabr_river[j] > 0)
+                {
+                    cols[ncol++] = RIVER(elem[i].nabr_river[j] - 1);
+                }
+            }
+#if defined(_DGW_)
+            else if (layer == 4)
+            {
+                if (elem[i].nabr[j] > 0)
+                {
+                    cols[ncol++] = GW_GEOL(elem[i].nabr[j] - 1);
+                }
+            }
+#endif
+        }
+    }
+    else
+    {
+        i = row - 3 * nelem;
+
+        cols[ncol++] = RIVER(i);
+
+        if (river[i].down > 0)
+        {
+            cols[ncol++] = RIVER(river[i].down - 1);
+        }
+
+        /* Upstream segments */
+        for (k = rivnet->up_ptr[i]; k < rivnet->up_ptr[i + 1]; k++)
+        {
+            cols[ncol++] = RIVER(rivnet->up[k]);
+        }
+
+        if (river[i].left > 0)
+        {
+            cols[ncol++] = SURF(river[i].left - 1);
+            cols[ncol++] = GW(river[i].left - 1);
+        }
+
+        if (river[i].right > 0)
+        {
+            cols[ncol++] = SURF(river[i].right - 1);
+            cols[ncol++] = GW(river[i].right - 1);
+        }
+    }
+
+    return SortIndex(ncol, cols);
+}
+
+int SortIndex(int n, sunindextype list[])
+{
+    /*
+     * Sort a short list of indices in place and remove duplicates. Returns the
+     * number of unique indices
+     */
+    int             j;
+    int             k;
+
+    for (j = 1; j < n; j++)
+    {
+        sunindextype    ind = list[j];
+
+        for (k = j; k > 0 && list[k - 1] > ind; k--)
+        {
+            list[k] = list[k - 1];
+        }
+        list[k] = ind;
+    }
+
+    for (j = 1, k = 0; j < n; j++)
+    {
+        if (list[j] != list[k])
+        {
+            list[++k] = list[j];
+        }
+    }
+
+    return (n > 0) ? k + 1 : 0;
+}
+
+int SparseJac(realtype t, N_Vector CV_Y, N_Vector fy, SUNMatrix jac,
+    void *pihm_data, N_Vector tmp1, N_Vector tmp2, N_Vector tmp3)
+{
+    /*
+     * Fill the sparse Jacobian with the flux derivatives of JacTimesSetup.
+     * Rows are built the same way as in Ode
+     */
+    int             i;
+    double         *y;
+    pihm_struct     pihm;
+    elem_struct    *elem;
+    river_struct   *river;
+    jtimes_struct  *jtimes;
+
+    y = NV_DATA(CV_Y);
+    pihm = (pihm_struct)pihm_data;
+
+    elem = &pihm->elem[0];
+    river = &pihm->river[0];
+    jtimes = &pihm->jtimes;
+
+    JacTimesSetup(t, CV_Y, fy, pihm_data);
+
+    /* CVODE zeroes the matrix before calling this function, which also clears
+     * the sparsity pattern. Restore the pattern with zero values */
+    SUNMatCopy(pihm->jac_pattern, jac);
+
+#if defined(_OPENMP)
+# pragma omp parallel for
+#endif
+    for (i = 0; i < nelem; i++)
+    {
+        int             j, k;
+        int             nabr, rnabr;
+        sunindextype    ys[NUM_ELEM_HYDROL];
+        double          area;
+        const jvelem_struct *jv;
+
+        jv = &jtimes->elem[i];
+        area = elem[i].topo.area;
+
+        ys[0] = SURF(i);
+        ys[1] = UNSAT(i);
+        ys[2] = GW(i);
+#if defined(_DGW_)
+        ys[3] = UNSAT_GEOL(i);
+        ys[4] = GW_GEOL(i);
+#endif
+
+        /* Vertical fluxes */
+        for (k = 0; k < NUM_ELEM_HYDROL; k++)
+        {
+            for (j = 0; j < NUM_ELEM_HYDROL; j++)
+            {
+                AddSparseEntry(ys[k], ys[j], jv->vert[j][k], jac);
+            }
+        }
+
+        /* Lateral fluxes */
+        for (j = 0; j < NUM_EDGE; j++)
+        {
+            nabr = elem[i].nabr[j] - 1;
+            rnabr = elem[i].nabr_river[j] - 1;
+
+            AddSparseEntry(SURF(i), SURF(i), -jv->ovl[j][0] / area, jac);
+            AddSparseEntry(GW(i), GW(i),
+                -jv->sub[j][0] / area / elem[i].soil.porosity, jac);
+
+            if (rnabr >= 0)
+            {
+                AddSparseEntry(SURF(i), RIVER(rnabr), -jv->ovl[j][1] / area,
+                    jac);
+                AddSparseEntry(GW(i), RIVER(rnabr),
+                    -jv->sub[j][2] / area / elem[i].soil.porosity, jac);
+            }
+            else if (nabr >= 0)
+            {
+                AddSparseEntry(SURF(i), SURF(nabr), -jv->ovl[j][1] / area,
+                    jac);
+            }
+
+            if (nabr >= 0)
+            {
+                AddSparseEntry(GW(i), GW(nabr),
+                    -jv->sub[j][1] / area / elem[i].soil.porosity, jac);
+            }
+
+#if defined(_DGW_)
+            AddSparseEntry(GW_GEOL(i), GW_GEOL(i),
+                -jv->dgw[j][0] / area / elem[i].geol.porosity, jac);
+
+            if (nabr >= 0)
+            {
+                AddSparseEntry(GW_GEOL(i), GW_GEOL(nabr),
+                    -jv->dgw[j][1] / area / elem[i].geol.porosity, jac);
+            }
+#endif
+        }
+    }
+
+#if defined(_OPENMP)
+# pragma omp parallel for
+#endif
+    for (i = 0; i < nriver; i++)
+    {
+        double          area;
+        const jvriver_struct *jv;
+
+        jv = &jtimes->river[i];
+        area = river[i].topo.area;
+
+        AddSparseEntry(RIVER(i), RIVER(i), -jv->self / area, jac);
+
+        if (river[i].down > 0)
+        {
+            AddSparseEntry(RIVER(i), RIVER(river[i].down - 1),
+                -jv->down[1] / area, jac);
+        }
+
+        if (river[i].left > 0)
+        {
+            AddSparseEntry(RIVER(i), SURF(river[i].left - 1),
+                -jv->surf[0] / area, jac);
+            AddSparseEntry(RIVER(i), GW(river[i].left - 1),
+                -jv->gw[0] / area, jac);
+        }
+
+        if (river[i].right > 0)
+        {
+            AddSparseEntry(RIVER(i), SURF(river[i].right - 1),
+                -jv->surf[1] / area, jac);
+            AddSparseEntry(RIVER(i), GW(river[i].right - 1),
+                -jv->gw[1] / area, jac);
+        }
+    }
+
+    /*
+     * Accumulate inflow derivatives for down segments
+     * NOTE: Summation must be calculated outside OMP to avoid different
+     * threads accessing the same variable at the same time
+     */
+    for (i = 0; i < nriver; i++)
+    {
+        int             down;
+
+        if (river[i].down > 0)
+        {
+            down = river[i].down - 1;
+
+            AddSparseEntry(RIVER(down), RIVER(i),
+                jtimes->river[i].down[0] / river[down].topo.area, jac);
+            AddSparseEntry(RIVER(down), RIVER(down),
+                jtimes->river[i].down[1] / river[down].topo.area, jac);
+        }
+    }
+
+    /* Ode sees negative storages as zero, so the RHS does not depend on them
+     */
+    MaskSparseCols(y, jac);
+
+    return 0;
+}
+
+void AddSparseEntry(sunindextype row, sunindextype col, double value,
+    SUNMatrix jac)
+{
+    sunindextype   *ptr;
+    sunindextype   *ind;
+    sunindextype    k;
+
+    ptr = SUNSparseMatrix_IndexPointers(jac);
+    ind = SUNSparseMatrix_IndexValues(jac);
+
+    for (k = ptr[row]; k < ptr[row + 1]; k++)
+    {
+        if (ind[k] == col)
+        {
+            SUNSparseMatrix_Data(jac)[k] += value;
+            return;
+        }
+    }
+
+    pihm_printf(VL_ERROR,
+        "Error: Jacobian entry (%ld, %ld) is not in the sparsity pattern.\n",
+        (long int)row, (long int)col);
+    pihm_exit(EXIT_FAILURE);
+}
+
+void MaskSparseCols(const double y[], SUNMatrix jac)
+{
+    sunindextype   *ind;
+    double         *data;
+    sunindextype    k;
+
+    ind = SUNSparseMatrix_IndexValues(jac);
+    data = SUNSparseMatrix_Data(jac);
+
+    for (k = 0; k < SUNSparseMatrix_NNZ(jac); k++)
+    {
+        data[k] = (y[ind[k]] < 0.0) ? 0.0 : data[k];
+    }
+}
@@ -0,0 +1,420 @@
+#include "pihm.h"
+
+/*
+ * Direct linear solver for the sparse (CSR) Jacobian system. The matrix is
+ * reordered by reverse Cuthill-McKee to reduce its envelope, and factored by
+ * an envelope LU decomposition without pivoting. The ordering and the
+ * envelope are determined at the first setup, as the sparsity pattern does not
+ * change during the simulation
+ */
+SUNLinearSolver NewSparseLu(sunindextype n)
+{
+    SUNLinearSolver sun_ls;
+    SUNLinearSolver_Ops ops;
+    sparselu_struct *lu;
+
+    sun_ls = (SUNLinearSolver)malloc(sizeof(*sun_ls));
+    ops = (SUNLinearSolver_Ops)malloc(
+        sizeof(struct _generic_SUNLinearSolver_Ops));
+    lu = (sparselu_struct *)malloc(sizeof(sparselu_struct));
+
+    ops->gettype = SparseLuGetType;
+    ops->initialize = SparseLuInitialize;
+    ops->setup = SparseLuSetup;
+    ops->solve = SparseLuSolve;
+    ops->lastflag = SparseLuLastFlag;
+    ops->space = SparseLuSpace;
+    ops->free = SparseLuFree;
+    ops->setatimes = NULL;
+    ops->setpreconditioner = NULL;
+    ops->setscalingvectors = NULL;
+    ops->numiters = NULL;
+    ops->resnorm = NULL;
+    ops->resid = NULL;
+
+    lu->n = n;
+    lu->perm = NULL;
+    lu->first = NULL;
+    lu->env_ptr = NULL;
+    lu->lower = NULL;
+    lu->upper = NULL;
+    lu->diag = NULL;
+    lu->work = NULL;
+    lu->last_flag = SUNLS_SUCCESS;
+
+    sun_ls->content = lu;
+    sun_ls->ops = ops;
+
+    return sun_ls;
+}
+
+SUNLinearSolver_Type SparseLuGetType(SUNLinearSolver sun_ls)
+{
+    return SUNLINEARSOLVER_DIRECT;
+}
+
+int SparseLuInitialize(SUNLinearSolver sun_ls)
+{
+    ((sparselu_struct *)sun_ls->content)->last_flag = SUNLS_SUCCESS;
+
+    return SUNLS_SUCCESS;
+}
+
+int SparseLuSetup(SUNLinearSolver sun_ls, SUNMatrix A)
+{
+    sparselu_struct *lu;
+    sunindextype   *ptr;
+    sunindextype   *ind;
+    double         *data;
+    sunindextype    i, j, k;
+    sunindextype    row, col;
+    sunindextype    kmin;
+    double          sum;
+
+    lu = (sparselu_struct *)sun_ls->content;
+
+    if (SUNMatGetID(A) != SUNMATRIX_SPARSE ||
+        SUNSparseMatrix_SparseType(A) != CSR_MAT ||
+        SUNSparseMatrix_Rows(A) != lu->n)
+    {
+        lu->last_flag = SUNLS_ILL_INPUT;
+        return lu->last_flag;
+    }
+
+    ptr = SUNSparseMatrix_IndexPointers(A);
+    ind = SUNSparseMatrix_IndexValues(A);
+    data = SUNSparseMatrix_Data(A);
+
+    if (lu->perm == NULL)
+    {
+        SparseLuAnalyze(lu, ptr, ind);
+    }
+
+    /* Load the permuted matrix into the envelope */
+    for (i = 0; i < lu->n; i++)
+    {
+        lu->diag[i] = 0.0;
+    }
+    for (k = 0; k < lu->env_ptr[lu->n]; k++)
+    {
+        lu->lower[k] = 0.0;
+        lu->upper[k] = 0.0;
+    }
+
+    for (i = 0; i < lu->n; i++)
+    {
+        row = lu->perm[i];
+
+        for (k = ptr[i]; k < ptr[i + 1]; k++)
+        {
+            col = lu->perm[ind[k]];
+
+            if (col == row)
+            {
+                lu->diag[row] += data[k];
+            }
+            else if (col < row)
+            {
+                lu->lower[lu->env_ptr[row] + col - lu->first[row]] += data[k];
+            }
+            else
+            {
+                lu->upper[lu->env_ptr[col] + row - lu->first[col]] += data[k];
+            }
+        }
+    }
+
+    /* Envelope LU factorization, row by row. li[k] = L(i, k) and
+     * ui[k] = U(k, i) for first[i] <= k < i */
+    for (i = 0; i < lu->n; i++)
+    {
+        double         *li;
+        double         *ui;
+
+        li = lu->lower + lu->env_ptr[i] - lu->first[i];
+        ui = lu->upper + lu->env_ptr[i] - lu->first[i];
+
+        for (j = lu->first[i]; j < i; j++)
+        {
+            const double   *lj;
+            const double   *uj;
+            double          suml;
+            double          sumu;
+
+            lj = lu->lower + lu->env_ptr[j] - lu->first[j];
+            uj = lu->upper + lu->env_ptr[j] - lu->first[j];
+            kmin = MAX(lu->first[i], lu->first[j]);
+
+            suml = li[j];
+            sumu = ui[j];
+            for (k = kmin; k < j; k++)
+            {
+                suml -= li[k] * uj[k];
+                sumu -= lj[k] * ui[k];
+            }
+
+            li[j] = suml / lu->diag[j];
+            ui[j] = sumu;
+        }
+
+        sum = lu->diag[i];
+        for (k = lu->first[i]; k < i; k++)
+        {
+            sum -= li[k] * ui[k];
+        }
+
+        if (sum == 0.0)
+        {
+            /* A positive flag asks CVODE to retry with a smaller step */
+            lu->last_flag = SUNLS_LUFACT_FAIL;
+            return lu->last_flag;
+        }
+
+        lu->diag[i] = sum;
+    }
+
+    lu->last_flag = SUNLS_SUCCESS;
+
+    return lu->last_flag;
+}
+
+int SparseLuSolve(SUNLinearSolver sun_ls, SUNMatrix A, N_Vector x, N_Vector b,
+    realtype tol)
+{
+    sparselu_struct *lu;
+    double         *xv;
+    double         *bv;
+    double         *w;
+    sunindextype    i, k;
+
+    lu = (sparselu_struct *)sun_ls->content;
+    xv = NV_DATA(x);
+    bv = NV_DATA(b);
+    w = lu->work;
+
+    for (i = 0; i < lu->n; i++)
+    {
+        w[lu->perm[i]] = bv[i];
+    }
+
+    /* Forward substitution with the unit lower factor */
+    for (i = 0; i < lu->n; i++)
+    {
+        const double   *li;
+        double          sum;
+
+        li = lu->lower + lu->env_ptr[i] - lu->first[i];
+
+        sum = w[i];
+        for (k = lu->first[i]; k < i; k++)
+        {
+            sum -= li[k] * w[k];
+        }
+        w[i] = sum;
+    }
+
+    /* Backward substitution with the upper factor, stored by columns */
+    for (i = lu->n - 1; i >= 0; i--)
+    {
+        const double   *ui;
+        double          wi;
+
+        ui = lu->upper + lu->env_ptr[i] - lu->first[i];
+
+        wi = w[i] / lu->diag[i];
+        w[i] = wi;
+
+        for (k = lu->first[i]; k < i; k++)
+        {
+            w[k] -= ui[k] * wi;
+        }
+    }
+
+    for (i = 0; i < lu->n; i++)
+    {
+        xv[i] = w[lu->perm[i]];
+    }
+
+    lu->last_flag = SUNLS_SUCCESS;
+
+    return lu->last_flag;
+}
+
+long int SparseLuLastFlag(SUNLinearSolver sun_ls)
+{
+    return ((sparselu_struct *)sun_ls->content)->last_flag;
+}
+
+int SparseLuSpace(SUNLinearSolver sun_ls, long int *lenrw, long int *leniw)
+{
+    sparselu_struct *lu;
+
+    lu = (sparselu_struct *)sun_ls->content;
+
+    if (lu->perm == NULL)
+    {
+        *lenrw = 0;
+        *leniw = 2;
+    }
+    else
+    {
+        *lenrw = 2 * lu->env_ptr[lu->n] + 2 * lu->n;
+        *leniw = 3 * lu->n + 3;
+    }
+
+    return SUNLS_SUCCESS;
+}
+
+int SparseLuFree(SUNLinearSolver sun_ls)
+{
+    sparselu_struct *lu;
+
+    if (sun_ls == NULL)
+    {
+        return SUNLS_SUCCESS;
+    }
+
+    lu = (sparselu_struct *)sun_ls->content;
+
+    if (lu != NULL)
+    {
+        free(lu->perm);
+        free(lu->first);
+        free(lu->env_ptr);
+        free(lu->lower);
+        free(lu->upper);
+        free(lu->diag);
+        free(lu->work);
+        free(lu);
+    }
+
+    free(sun_ls->ops);
+    free(sun_ls);
+
+    return SUNLS_SUCCESS;
+}
+
+void SparseLuAnalyze(sparselu_struct *lu, const sunindextype ptr[],
+    const sunindextype ind[])
+{
+    /*
+     * Determine the reverse Cuthill-McKee ordering and the envelope of the
+     * permuted matrix from the sparsity pattern
+     */
+    sunindextype    i, k;
+    sunindextype    row, col;
+
+    lu->perm = (sunindextype *)malloc(lu->n * sizeof(sunindextype));
+    lu->first = (sunindextype *)malloc(lu->n * sizeof(sunindextype));
+    lu->env_ptr = (sunindextype *)malloc((lu->n + 1) * sizeof(sunindextype));
+    lu->diag = (double *)malloc(lu->n * sizeof(double));
+    lu->work = (double *)malloc(lu->n * sizeof(double));
+
+    RcmOrder(lu->n, ptr, ind, lu->perm);
+
+    for (i = 0; i < lu->n; i++)
+    {
+        lu->first[i] = i;
+    }
+
+    for (i = 0; i < lu->n; i++)
+    {
+        for (k = ptr[i]; k < ptr[i + 1]; k++)
+        {
+            row = MAX(lu->perm[i], lu->perm[ind[k]]);
+            col = MIN(lu->perm[i], lu->perm[ind[k]]);
+
+            lu->first[row] = MIN(lu->first[row], col);
+        }
+    }
+
+    lu->env_ptr[0] = 0;
+    for (i = 0; i < lu->n; i++)
+    {
+        lu->env_ptr[i + 1] = lu->env_ptr[i] + i - lu->first[i];
+    }
+
+    lu->lower = (double *)malloc(MAX(lu->env_ptr[lu->n], 1) * sizeof(double));
+    lu->upper = (double *)malloc(MAX(lu->env_ptr[lu->n], 1) * sizeof(double));
+
+    pihm_printf(VL_VERBOSE, "Sparse direct solver: %ld unknowns, envelope "
+        "size %ld.\n", (long int)lu->n, (long int)lu->env_ptr[lu->n]);
+}
+
+void RcmOrder(sunindextype n, const sunindextype ptr[],
+    const sunindextype ind[], sunindextype perm[])
+{
+    /*
+     * Reverse Cuthill-McKee ordering of the graph of a structurally symmetric
+     * CSR pattern. perm[i] is the new index of node i. Each connected component
+     * is started from a node of minimum degree
+     */
+    sunindextype   *order;
+    sunindextype   *degree;
+    int            *visited;
+    sunindextype    head, tail;
+    sunindextype    start;
+    sunindextype    i, j, k;
+    sunindextype    node, nabr;
+
+    order = (sunindextype *)malloc(n * sizeof(sunindextype));
+    degree = (sunindextype *)malloc(n * sizeof(sunindextype));
+    visited = (int *)calloc(n, sizeof(int));
+
+    for (i = 0; i < n; i++)
+    {
+        degree[i] = ptr[i + 1] - ptr[i];
+    }
+
+    tail = 0;
+    while (tail < n)
+    {
+        /* Start a new component from the unvisited node of minimum degree */
+        start = -1;
+        for (i = 0; i < n; i++)
+        {
+            if (!visited[i] && (start < 0 || degree[i] < degree[start]))
+            {
+                start = i;
+            }
+        }
+
+        head = tail;
+        order[tail++] = start;
+        visited[start] = 1;
+
+        while (head < tail)
+        {
+            node = order[head++];
+
+            /* Append unvisited neighbors by increasing degree */
+            j = tail;
+            for (k = ptr[node]; k < ptr[node + 1]; k++)
+            {
+                nabr = ind[k];
+
+                if (!visited[nabr])
+                {
+                    visited[nabr] = 1;
+
+                    for (i = tail; i > j && degree[order[i - 1]] > degree[nabr];
+                        i--)
+                    {
+                        order[i] = order[i - 1];
+                    }
+                    order[i] = nabr;
+                    tail++;
+                }
+            }
+        }
+    }
+
+    for (i = 0; i < n; i++)
+    {
+        perm[order[i]] = n - 1 - i;
+    }
+
+    free(order);
+    free(degree);
+    free(visited);
+}
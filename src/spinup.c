@@ -21,8 +21,11 @@ void Spinup(pihm_struct pihm, N_Vector CV_Y, void *cvode_mem,
         ResetSpinupStat(pihm->elem);
 #endif
 
-        for (ctrl->cstep = 0; ctrl->cstep < ctrl->nstep; ctrl->cstep++)
+        for (ctrl->cstep = 0; ctrl->cstep < ctrl->nstep;
+            ctrl->cstep = ctrl->nextstep)
         {
+            ctrl->nextstep = NextStep(pihm);
+
             PIHM(0.0, pihm, cvode_mem, CV_Y);
         }
 
@@ -0,0 +1,368 @@
+#include "pihm.h"
+
+/*
+ * Tasks of a PIHM step are issued in program order. Each task declares the
+ * data it reads and writes. Before a task runs, it waits for the asynchronous
+ * tasks still in flight that write what it reads or writes, or read what it
+ * writes. Asynchronous tasks (boundary conditions, water balance and model
+ * variable output) run on a helper thread, and the main thread moves on to
+ * the next task, e.g., land surface processes while boundary conditions are
+ * interpolated, or the next hydrology ODE while outputs are written. All other
+ * tasks run on the main thread with all OpenMP threads
+ */
+const char     *task_name[NUM_TASK] = { "bc", "forc", "lsm", "react",
+    "cycles", "ode", "hydrol", "daily", "watbal", "output" };
+const int       task_in[NUM_TASK] = {
+    0,                                                  /* bc */
+    0,                                                  /* forc */
+    MET_DATA,                                           /* lsm */
+    LSM_DATA | HYDROL_DATA,                             /* react */
+    MET_DATA | LSM_DATA | HYDROL_DATA,                  /* cycles */
+    BC_DATA | MET_DATA | LSM_DATA | SOLUTE_DATA,        /* ode */
+    LSM_DATA | SOLUTE_DATA | HYDROL_DATA,               /* hydrol */
+    MET_DATA | LSM_DATA | SOLUTE_DATA | HYDROL_DATA,    /* daily */
+    MET_DATA | LSM_DATA | HYDROL_DATA,                  /* watbal */
+    PRINT_DATA                                          /* output */
+};
+const int       task_out[NUM_TASK] = {
+    BC_DATA,                                            /* bc */
+    MET_DATA,                                           /* forc */
+    LSM_DATA | PRINT_DATA,                              /* lsm */
+    SOLUTE_DATA,                                        /* react */
+    LSM_DATA | SOLUTE_DATA | DAILY_DATA | PRINT_DATA,   /* cycles */
+    LSM_DATA | SOLUTE_DATA | HYDROL_DATA,               /* ode */
+    LSM_DATA | SOLUTE_DATA | PRINT_DATA,                /* hydrol */
+    LSM_DATA | SOLUTE_DATA | DAILY_DATA | PRINT_DATA,   /* daily */
+    WATBAL_DATA,                                        /* watbal */
+    PRINT_DATA                                          /* output */
+};
+
+void InitTaskGraph(const char outputdir[], pihm_struct pihm,
+    taskgraph_struct *graph)
+{
+    char            trace_fn[MAXSTRING];
+    int             k;
+
+    graph->pihm = pihm;
+    graph->pending = 0;
+    graph->head = 0;
+    graph->nqueue = 0;
+    graph->quit = 0;
+    graph->wait = 0.0;
+    graph->clock0 = WallClock();
+
+    for (k = 0; k < NUM_TASK; k++)
+    {
+        graph->t[k] = 0;
+        graph->dt[k] = 0;
+        graph->ncall[k] = 0;
+        graph->start[k] = 0.0;
+        graph->busy[k] = 0.0;
+    }
+
+    if (trace_mode)
+    {
+        sprintf(trace_fn, "%s%s.trace.log", outputdir, project);
+        graph->trace_file = pihm_fopen(trace_fn, "w");
+        fprintf(graph->trace_file, "%-12s%-8s%-8s%-16s%s\n", "time", "task",
+            "thread", "start", "end");
+    }
+    else
+    {
+        graph->trace_file = NULL;
+    }
+
+    /* The helper thread takes a core from the OpenMP threads while it is busy,
+     * so it is only used when there is more than one */
+#if defined(_OPENMP)
+    graph->helper = (nthreads > 1) ? 1 : 0;
+
+    if (graph->helper)
+    {
+        pthread_mutex_init(&graph->mutex, NULL);
+        pthread_cond_init(&graph->cond, NULL);
+
+        if (pthread_create(&graph->thread, NULL, TaskHelper, graph) != 0)
+        {
+            pihm_printf(VL_ERROR, "Error creating the helper thread.\n");
+            pihm_exit(EXIT_FAILURE);
+        }
+    }
+#else
+    graph->helper = 0;
+#endif
+}
+
+void FreeTaskGraph(taskgraph_struct *graph)
+{
+    int             k;
+
+    WaitTasks(graph);
+
+#if defined(_OPENMP)
+    if (graph->helper)
+    {
+        pthread_mutex_lock(&graph->mutex);
+        graph->quit = 1;
+        pthread_cond_broadcast(&graph->cond);
+        pthread_mutex_unlock(&graph->mutex);
+
+        pthread_join(graph->thread, NULL);
+        pthread_mutex_destroy(&graph->mutex);
+        pthread_cond_destroy(&graph->cond);
+    }
+#endif
+
+    if (trace_mode)
+    {
+        double          async = 0.0;
+
+        pihm_printf(VL_NORMAL, "\nTask       Runs      Time (s)    Thread\n");
+        for (k = 0; k < NUM_TASK; k++)
+        {
+            if (graph->ncall[k] > 0)
+            {
+                pihm_printf(VL_NORMAL, "%-11s%-10d%-12.3f%s\n", task_name[k],
+                    graph->ncall[k], graph->busy[k],
+                    (IsAsyncTask(k) && graph->helper) ? "helper" : "main");
+            }
+            async += (IsAsyncTask(k) && graph->helper) ? graph->busy[k] : 0.0;
+        }
+        pihm_printf(VL_NORMAL,
+            "Main thread waited %.3f s for asynchronous tasks. %.3f s of "
+            "asynchronous tasks overlapped the main thread.\n",
+            graph->wait, MAX(async - graph->wait, 0.0));
+
+        fclose(graph->trace_file);
+    }
+}
+
+int IsAsyncTask(int k)
+{
+    return (k == BC_TASK || k == WATBAL_TASK || k == OUTPUT_TASK) ? 1 : 0;
+}
+
+int TaskConflicts(int k)
+{
+    /*
+     * Bit mask of the tasks that must not run at the same time as task k,
+     * i.e., tasks that write the data task k reads or writes, or read the data
+     * task k writes
+     */
+    int             j;
+    int             conflicts = 0;
+
+    for (j = 0; j < NUM_TASK; j++)
+    {
+        if ((task_out[j] & (task_in[k] | task_out[k])) ||
+            (task_out[k] & task_in[j]) || j == k)
+        {
+            conflicts |= 1 << j;
+        }
+    }
+
+    return conflicts;
+}
+
+void WaitConflicts(int conflicts, taskgraph_struct *graph)
+{
+    /* Wait until no asynchronous task in conflicts is in flight. Must be
+     * called with the lock held */
+#if defined(_OPENMP)
+    if (graph->pending & conflicts)
+    {
+        double          start;
+
+        start = WallClock();
+
+        while (graph->pending & conflicts)
+        {
+            pthread_cond_wait(&graph->cond, &graph->mutex);
+        }
+
+        graph->wait += WallClock() - start;
+    }
+#endif
+}
+
+void BeginTask(int k, int t, taskgraph_struct *graph)
+{
+    /* Start task k on the main thread */
+#if defined(_OPENMP)
+    if (graph->helper)
+    {
+        pthread_mutex_lock(&graph->mutex);
+        WaitConflicts(TaskConflicts(k), graph);
+        pthread_mutex_unlock(&graph->mutex);
+    }
+#endif
+
+    graph->t[k] = t;
+    graph->start[k] = WallClock();
+}
+
+void EndTask(int k, taskgraph_struct *graph)
+{
+    double          end;
+
+    end = WallClock();
+
+#if defined(_OPENMP)
+    if (graph->helper)
+    {
+        pthread_mutex_lock(&graph->mutex);
+    }
+#endif
+
+    TraceTask(k, "main", end, graph);
+
+#if defined(_OPENMP)
+    if (graph->helper)
+    {
+        pthread_mutex_unlock(&graph->mutex);
+    }
+#endif
+}
+
+void IssueTask(int k, int t, int dt, taskgraph_struct *graph)
+{
+    /* Issue asynchronous task k. Without the helper thread, it runs right
+     * away */
+#if defined(_OPENMP)
+    if (graph->helper)
+    {
+        pthread_mutex_lock(&graph->mutex);
+
+        WaitConflicts(TaskConflicts(k), graph);
+
+        graph->t[k] = t;
+        graph->dt[k] = dt;
+        graph->queue[(graph->head + graph->nqueue) % NUM_TASK] = k;
+        graph->nqueue++;
+        graph->pending |= 1 << k;
+
+        pthread_cond_broadcast(&graph->cond);
+        pthread_mutex_unlock(&graph->mutex);
+
+        return;
+    }
+#endif
+
+    graph->t[k] = t;
+    graph->dt[k] = dt;
+    graph->start[k] = WallClock();
+    RunTask(k, graph);
+    TraceTask(k, "main", WallClock(), graph);
+}
+
+void WaitTasks(taskgraph_struct *graph)
+{
+    /* Wait for all asynchronous tasks in flight */
+#if defined(_OPENMP)
+    if (graph->helper)
+    {
+        pthread_mutex_lock(&graph->mutex);
+        WaitConflicts(~0, graph);
+        pthread_mutex_unlock(&graph->mutex);
+    }
+#endif
+}
+
+void RunTask(int k, taskgraph_struct *graph)
+{
+    /* Body of asynchronous task k */
+    pihm_struct     pihm = graph->pihm;
+    int             t = graph->t[k];
+
+    switch (k)
+    {
+        case BC_TASK:
+            if (pihm->ctrl.dense)
+            {
+                pihm->ctrl.tstop =
+                    NextBreakpoint(t, &pihm->ctrl, &pihm->forc);
+            }
+#if defined(_RT_)
+            ApplyBc(t, &pihm->rttbl, &pihm->forc, pihm->elem, pihm->river);
+#else
+            ApplyBc(t, &pihm->forc, pihm->elem, pihm->river);
+#endif
+            break;
+        case WATBAL_TASK:
+            PrintWaterBalance(t, pihm->ctrl.starttime, graph->dt[k],
+                pihm->elem, pihm->river, pihm->print.watbal_file);
+            break;
+        case OUTPUT_TASK:
+            PrintData(t, t - pihm->ctrl.starttime, pihm->ctrl.ascii,
+                FlushNow(t, &pihm->ctrl), &pihm->print);
+            break;
+        default:
+            pihm_printf(VL_ERROR, "Error: Task %s is not asynchronous.\n",
+                task_name[k]);
+            pihm_exit(EXIT_FAILURE);
+    }
+}
+
+void TraceTask(int k, const char thread[], double end,
+    taskgraph_struct *graph)
+{
+    /* Account for a finished run of task k. With the helper thread, must be
+     * called with the lock held */
+    graph->ncall[k]++;
+    graph->busy[k] += end - graph->start[k];
+
+    if (graph->trace_file != NULL)
+    {
+        fprintf(graph->trace_file, "%-12d%-8s%-8s%-16.6f%.6f\n", graph->t[k],
+            task_name[k], thread, graph->start[k] - graph->clock0,
+            end - graph->clock0);
+    }
+}
+
+#if defined(_OPENMP)
+void *TaskHelper(void *arg)
+{
+    /* Main function of the helper thread, which runs queued asynchronous
+     * tasks in order of issue */
+    taskgraph_struct *graph = (taskgraph_struct *)arg;
+
+    /* Parallel loops in asynchronous tasks run on the helper thread alone */
+    omp_set_num_threads(1);
+
+    pthread_mutex_lock(&graph->mutex);
+
+    while (1)
+    {
+        int             k;
+
+        while (graph->nqueue == 0 && !graph->quit)
+        {
+            pthread_cond_wait(&graph->cond, &graph->mutex);
+        }
+
+        if (graph->nqueue == 0)
+        {
+            break;
+        }
+
+        k = graph->queue[graph->head];
+        graph->start[k] = WallClock();
+
+        pthread_mutex_unlock(&graph->mutex);
+        RunTask(k, graph);
+        pthread_mutex_lock(&graph->mutex);
+
+        TraceTask(k, "helper", WallClock(), graph);
+
+        graph->head = (graph->head + 1) % NUM_TASK;
+        graph->nqueue--;
+        graph->pending &= ~(1 << k);
+
+        pthread_cond_broadcast(&graph->cond);
+    }
+
+    pthread_mutex_unlock(&graph->mutex);
+
+    return NULL;
+}
+#endif
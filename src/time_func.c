@@ -3,11 +3,17 @@
 pihm_t_struct PIHMTime(int t)
 {
     pihm_t_struct   pihm_time;
-    struct tm      *timestamp;
+    struct tm       tm;
+    struct tm      *timestamp = &tm;
     time_t          rawtime;
 
+    /* Reentrant, because asynchronous tasks run on the helper thread */
     rawtime = (time_t)t;
-    timestamp = gmtime(&rawtime);
+#if defined(_WIN32) || defined(_WIN64)
+    gmtime_s(timestamp, &rawtime);
+#else
+    gmtime_r(&rawtime, timestamp);
+#endif
 
     pihm_time.t      = t;
     pihm_time.year   = timestamp->tm_year + 1900;
@@ -104,3 +110,13 @@ void RunTime (clock_t start, double *cputime, double *cputime_dt)
     ptime = ct;
 }
 #endif
+
+double WallClock(void)
+{
+    /* Elapsed time in seconds, used to time solver setups */
+#if defined(_OPENMP)
+    return omp_get_wtime();
+#else
+    return (double)clock() / CLOCKS_PER_SEC;
+#endif
+}
@@ -1,12 +1,13 @@
 #include "pihm.h"
 
 void SoluteTranspt(double diff_coef, double disp_coef, double cementation,
-    elem_struct elem[], river_struct river[])
+    const hydro_struct *hydro, const rivnet_struct *rivnet, elem_struct elem[],
+    river_struct river[])
 {
     int             i;
 
 #if defined(_OPENMP)
-# pragma omp parallel for
+# pragma omp for schedule(static) nowait
 #endif
     for (i = 0; i < nelem; i++)
     {
@@ -41,7 +42,7 @@ void SoluteTranspt(double diff_coef, double disp_coef, double cementation,
     }
 
 #if defined(_OPENMP)
-# pragma omp parallel for
+# pragma omp for schedule(static) nowait
 #endif
     for (i = 0; i < nriver; i++)
     {
@@ -61,7 +62,7 @@ void SoluteTranspt(double diff_coef, double disp_coef, double cementation,
      * Calculate chemical fluxes
      */
 #if defined(_OPENMP)
-# pragma omp parallel for
+# pragma omp for schedule(static)
 #endif
     for (i = 0; i < nelem; i++)
     {
@@ -108,9 +109,9 @@ void SoluteTranspt(double diff_coef, double disp_coef, double cementation,
                     elem[i].solute[k].subflux[j] =
                         AdvDiffDisp(diff_coef, disp_coef, cementation,
                         elem[i].solute[k].conc, nabr->solute[k].conc,
-                        0.5 * (elem[i].soil.smcmax + nabr->soil.smcmax),
-                        elem[i].topo.dist_nabr[j],
-                        0.5 * (elem[i].soil.depth + nabr->soil.depth), wflux);
+                        hydro->avg_smcmax[NUM_EDGE * i + j],
+                        hydro->dist_nabr[NUM_EDGE * i + j],
+                        hydro->avg_depth[NUM_EDGE * i + j], wflux);
                 }
             }   /* End of element to element */
 
@@ -149,9 +150,9 @@ void SoluteTranspt(double diff_coef, double disp_coef, double cementation,
                     elem[i].solute[k].dgwflux[j] =
                         AdvDiffDisp(diff_coef, disp_coef, cementation,
                         elem[i].solute[k].conc_geol, nabr->solute[k].conc_geol,
-                        0.5 * (elem[i].geol.smcmax + nabr->geol.smcmax),
-                        elem[i].topo.dist_nabr[j],
-                        0.5 * (elem[i].geol.depth + nabr->geol.depth),
+                        hydro->avg_smcmax_geol[NUM_EDGE * i + j],
+                        hydro->dist_nabr[NUM_EDGE * i + j],
+                        hydro->avg_depth_geol[NUM_EDGE * i + j],
                         elem[i].wf.dgw[j]);
                 }
             }   /* End of element to element */
@@ -160,7 +161,7 @@ void SoluteTranspt(double diff_coef, double disp_coef, double cementation,
     }
 
 #if defined(_OPENMP)
-# pragma omp parallel for
+# pragma omp for schedule(static)
 #endif
     for (i = 0; i < nriver; i++)
     {
@@ -213,18 +214,22 @@ void SoluteTranspt(double diff_coef, double disp_coef, double cementation,
     }
 
     /*
-     * Accumulate to get in-flow for down segments
+     * Accumulate to get in-flow for down segments. Each segment gathers the
+     * fluxes of its upstream segments
      */
+#if defined(_OPENMP)
+# pragma omp for schedule(static)
+#endif
     for (i = 0; i < nriver; i++)
     {
-        int             k;
+        int             j, k;
 
         for (k = 0; k < nsolute; k++)
         {
-            if (river[i].down > 0)
+            for (j = rivnet->up_ptr[i]; j < rivnet->up_ptr[i + 1]; j++)
             {
-                river[river[i].down - 1].solute[k].flux[UPSTREAM] -=
-                    river[i].solute[k].flux[DOWNSTREAM];
+                river[i].solute[k].flux[UPSTREAM] -=
+                    river[rivnet->up[j]].solute[k].flux[DOWNSTREAM];
             }
         }
     }
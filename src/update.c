@@ -62,7 +62,6 @@ void UpdateVar(double stepsize, elem_struct elem[], river_struct river[],
         UpdateNProfile(stepsize, &elem[i].soil, &elem[i].ws, &elem[i].ns,
             elem[i].solute, elem[i].ns.no3, elem[i].ns.nh4, &elem[i].ps);
 
-        elem[i].ns0 = elem[i].ns;
         elem[i].ps.no3_prev = elem[i].ps.no3;
         elem[i].ps.nh4_prev = elem[i].ps.nh4;
 #endif
@@ -8,11 +8,16 @@ void ParseCmdLineParam(int argc, char *argv[], char outputdir[])
     struct optparse_long longopts[] = {
         {"append",     'a', OPTPARSE_NONE},
         {"brief",      'b', OPTPARSE_NONE},
+        {"convert",    'C', OPTPARSE_NONE},
         {"correction", 'c', OPTPARSE_NONE},
         {"debug",      'd', OPTPARSE_NONE},
         {"fixed",      'f', OPTPARSE_NONE},
+        {"kernels",    'k', OPTPARSE_NONE},
+        {"mem-report", 'm', OPTPARSE_NONE},
         {"output",     'o', OPTPARSE_REQUIRED},
+        {"rhs",        'r', OPTPARSE_REQUIRED},
         {"silent",     's', OPTPARSE_NONE},
+        {"trace",      't', OPTPARSE_NONE},
         {"version",    'V', OPTPARSE_NONE},
         {"verbose",    'v', OPTPARSE_NONE},
         {0, 0, 0}
@@ -28,6 +33,20 @@ void ParseCmdLineParam(int argc, char *argv[], char outputdir[])
                 /* Specify output directory */
                 sprintf(outputdir, "output/%s/", options.optarg);
                 break;
+            case 'r':
+                /* Number of timed RHS evaluations of the benchmark mode */
+                bench_rhs = atoi(options.optarg);
+                if (bench_rhs <= 0)
+                {
+                    pihm_printf(VL_ERROR,
+                        "Error: Number of RHS evaluations must be positive.\n");
+                    pihm_exit(EXIT_FAILURE);
+                }
+                break;
+            case 'C':
+                /* Convert forcing files to binary */
+                convert_mode = 1;
+                break;
             case 'c':
                 /* Surface elevation correction mode */
                 corr_mode = 1;
@@ -40,6 +59,14 @@ void ParseCmdLineParam(int argc, char *argv[], char outputdir[])
                 /* Fixed length spin-up */
                 fixed_length = 1;
                 break;
+            case 'k':
+                /* Check flux kernels against scalar flux laws */
+                check_mode = 1;
+                break;
+            case 'm':
+                /* Print memory per element by module */
+                mem_report = 1;
+                break;
             case 'v':
                 /* Verbose mode */
                 verbose_mode = VL_VERBOSE;
@@ -52,6 +79,10 @@ void ParseCmdLineParam(int argc, char *argv[], char outputdir[])
                 /* Silent mode */
                 verbose_mode = VL_SILENT;
                 break;
+            case 't':
+                /* Trace tasks of PIHM steps */
+                trace_mode = 1;
+                break;
             case 'a':
                 /* Append mode */
                 append_mode = 1;
@@ -89,8 +120,12 @@ void ParseCmdLineParam(int argc, char *argv[], char outputdir[])
             " <project name>\n"
             "    -o Specify output directory\n"
             "    -b Brief mode\n"
+            "    -C Convert forcing files to binary and quit\n"
             "    -c Correct surface elevation\n"
             "    -d Debug mode\n"
+            "    -k Check flux kernels against scalar flux laws and quit\n"
+            "    -m Print memory per element by module\n"
+            "    -r Time the given number of RHS evaluations and quit\n"
             "    -V Version number\n"
             "    -v Verbose mode\n");
         pihm_exit(EXIT_FAILURE);
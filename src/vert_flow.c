@@ -5,7 +5,7 @@ void VerticalFlow(double dt, elem_struct elem[])
     int             i;
 
 #if defined(_OPENMP)
-# pragma omp parallel for
+# pragma omp for schedule(static)
 #endif
     for (i = 0; i < nelem; i++)
     {
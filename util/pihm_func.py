@@ -69,7 +69,80 @@ def read_river(simulation):
     return (num_rivers, np.array(from_node), np.array(to_node))
 
 
-def read_output(simulation, outputdir, ext):
+def read_container_index(fname):
+
+    # Read header of an output container
+    with open(fname, 'rb') as binfile:
+        magic, version, num_vars, num_elem, num_rivers = \
+            struct.unpack('8s4i', binfile.read(24))
+
+        if magic.rstrip(b'\0') != b'PIHMOUT' or version != 1:
+            raise ValueError(fname + ' is not an MM-PIHM output container')
+
+        # Read index of variables (name, output interval, number of values)
+        index = {}
+        for ivar in range(num_vars):
+            name, intvl, dim = struct.unpack('64s2i', binfile.read(72))
+            index[name.rstrip(b'\0').decode()] = (ivar, intvl, dim)
+
+    return (num_elem, num_rivers, index)
+
+
+def read_container(fname, ext, start=None, end=None):
+
+    # Read the records of one variable from an output container. Only chunks
+    # that overlap the time range [start, end] (model time in seconds) are read
+    _, _, index = read_container_index(fname)
+
+    if ext not in index:
+        raise KeyError(ext + ' is not in ' + fname)
+
+    ivar, _, dim = index[ext]
+
+    # Record size of each variable
+    record_size = [0] * len(index)
+    for (i, _, d) in index.values():
+        record_size[i] = 8 * (d + 1)
+
+    records = []
+    with open(fname, 'rb') as binfile:
+        # Skip header and index
+        binfile.seek(24 + 72 * len(index))
+
+        # Walk through chunk headers, skipping chunks of other variables and
+        # times
+        while True:
+            chunk_str = binfile.read(16)
+            if len(chunk_str) < 16:
+                break
+
+            chunk_var, nrec, first, last = struct.unpack('4i', chunk_str)
+            chunk_size = nrec * record_size[chunk_var]
+
+            if (chunk_var == ivar and (start is None or last >= start) and
+                    (end is None or first <= end)):
+                data_str = binfile.read(chunk_size)
+                if len(data_str) < chunk_size:
+                    # Chunk of an unfinished simulation
+                    break
+                records.append(np.frombuffer(data_str, dtype='<f8')
+                               .reshape(nrec, dim + 1))
+            else:
+                binfile.seek(chunk_size, os.SEEK_CUR)
+
+    data_array = (np.concatenate(records) if records
+                  else np.empty((0, dim + 1)))
+
+    # Select records in time range
+    if start is not None:
+        data_array = data_array[data_array[:, 0] >= start]
+    if end is not None:
+        data_array = data_array[data_array[:, 0] <= end]
+
+    return data_array
+
+
+def read_output(simulation, outputdir, ext, start=None, end=None):
 
     # Read number of river segments and elements from input files
     num_rivers, _, _ = read_river(simulation)
@@ -295,25 +368,37 @@ def read_output(simulation, outputdir, ext):
         varname = 'River ' + ext[12:] + ' flux'
         unit = 'kmol s$^{-1}$'
 
-    # Full file name (binary file)
+    # Full file name (binary file). Without a .dat file, the variable is read
+    # from the output container of the simulation
     fname = 'output/' + outputdir + '/' + simulation + '.' + ext + '.dat'
 
-    # Check size of output file
-    fsize = int(os.path.getsize(fname) / 8)
+    if os.path.exists(fname):
+        # Check size of output file
+        fsize = int(os.path.getsize(fname) / 8)
 
-    with open(fname, 'rb') as binfile:
-        # Read binary output file
-        data_str = binfile.read()
-        data_tuple = struct.unpack('%dd' %(fsize), data_str)
+        with open(fname, 'rb') as binfile:
+            # Read binary output file
+            data_str = binfile.read()
+            data_tuple = struct.unpack('%dd' %(fsize), data_str)
+
+            # Rearrange read values to numpy array
+            data_array = np.resize(data_tuple,
+                                   (int(fsize / (dim + 1)), dim + 1))
 
-        # Rearrange read values to numpy array
-        data_array = np.resize(data_tuple, (int(fsize / (dim + 1)), dim + 1))
+        # Select records in time range
+        if start is not None:
+            data_array = data_array[data_array[:, 0] >= start]
+        if end is not None:
+            data_array = data_array[data_array[:, 0] <= end]
+    else:
+        fname = 'output/' + outputdir + '/' + simulation + '.pihmout'
+        data_array = read_container(fname, ext, start, end)
 
-        # Output values
-        sim_val = data_array[:, 1:]
+    # Output values
+    sim_val = data_array[:, 1:]
 
-        # Convert simulation time
-        sim_time = [datetime.utcfromtimestamp(data_array[i, 0])
-                    for i in range(int(fsize / (dim + 1)))]
+    # Convert simulation time
+    sim_time = [datetime.utcfromtimestamp(data_array[i, 0])
+                for i in range(data_array.shape[0])]
 
     return (sim_time, sim_val, varname, unit)